@@ -4,6 +4,7 @@ OS_SRC_DIR = $(SRC)/OS
 
 OS_SOURCES := \
 	$(OS_SRC_DIR)/Clock.cpp \
+	$(OS_SRC_DIR)/CPU.cpp \
 	$(OS_SRC_DIR)/SocketAddress.cpp \
 	$(OS_SRC_DIR)/SocketDescriptor.cpp \
 	$(OS_SRC_DIR)/FileDescriptor.cpp \
@@ -174,6 +174,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
 	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/HorizonWidget.cpp \
 	$(SRC)/Renderer/HorizonRenderer.cpp \
@@ -189,6 +190,7 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Airspace/NearestAirspace.cpp \
@@ -219,6 +221,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/FlarmId.cpp \
 	$(SRC)/FLARM/Error.cpp \
 	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/TrafficColumns.cpp \
 	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
@@ -234,6 +237,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Computer/ThermalBandComputer.cpp \
 	$(SRC)/Computer/Wind/Computer.cpp \
 	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/ContestSolverPool.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
 	$(SRC)/Computer/ThermalLocator.cpp \
@@ -264,6 +268,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Logger/AsyncTextWriter.cpp \
 	$(SRC)/Logger/NMEALogger.cpp \
 	$(SRC)/Logger/ExternalLogger.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
@@ -422,6 +427,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspacePolygonCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceListRenderer.cpp \
 	$(SRC)/Renderer/AirspacePreviewRenderer.cpp \
@@ -497,9 +503,12 @@ XCSOAR_SOURCES := \
 	$(SRC)/MergeThread.cpp \
 	$(SRC)/CalculationThread.cpp \
 	$(SRC)/DisplayMode.cpp \
+	$(SRC)/Profiler/Profiler.cpp \
 	\
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyUpdater.cpp \
+	$(SRC)/Topography/TopographyCache.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
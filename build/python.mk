@@ -109,6 +109,7 @@ PYTHON_SOURCES = \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceIntersectSort.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceNearestSort.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspacePolygon.cpp \
+	$(ENGINE_SRC_DIR)/Airspace/AirspaceRTree.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/Airspaces.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceSoonestSort.cpp \
 	$(ENGINE_SRC_DIR)/Airspace/AirspaceSorter.cpp \
@@ -53,6 +53,7 @@ endif
 ifeq ($(FREETYPE),y)
 SCREEN_SOURCES += \
 	$(SCREEN_SRC_DIR)/FreeType/Font.cpp \
+	$(SCREEN_SRC_DIR)/FreeType/GlyphCache.cpp \
 	$(SCREEN_SRC_DIR)/FreeType/Init.cpp
 endif
 
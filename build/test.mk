@@ -66,6 +66,7 @@ $(1)_SOURCES = \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
 	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(SRC)/NMEA/FlyingState.cpp \
@@ -88,6 +89,7 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestProfiler \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestMathTables \
 	TestAngle TestUnits TestEarth TestSunEphemeris \
@@ -97,7 +99,15 @@ TEST_NAMES = \
 	TestLogger TestGRecord TestDriver TestClimbAvCalc \
 	TestWaypointReader TestThermalBase \
 	TestFlarmNet \
+	TestTrafficColumns \
+	TestTraceSnapshot \
+	TestContestBound \
+	TestDijkstra \
+	TestTaskDijkstra \
+	TestAbortTask \
+	TestHeightMatrix \
 	TestColorRamp TestGeoPoint TestDiffFilter \
+	TestSlopeShading \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint \
@@ -135,6 +145,13 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_PROFILER_SOURCES = \
+	$(SRC)/Profiler/Profiler.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestProfiler.cpp
+TEST_PROFILER_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestProfiler,TEST_PROFILER))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -164,6 +181,7 @@ $(eval $(call link-program,TestMETARParser,TEST_METAR_PARSER))
 
 TEST_AIRSPACE_PARSER_SOURCES = \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
 	$(SRC)/Operation/Operation.cpp \
@@ -273,7 +291,7 @@ TEST_TROUTE_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_troute.cpp
-TEST_TROUTE_DEPENDS = TERRAIN IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+TEST_TROUTE_DEPENDS = TERRAIN IO ZZIP OS THREAD ROUTE GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_troute,TEST_TROUTE))
 
 TEST_REACH_SOURCES = \
@@ -282,7 +300,7 @@ TEST_REACH_SOURCES = \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_reach.cpp
-TEST_REACH_DEPENDS = TERRAIN IO ZZIP OS ROUTE GLIDE GEO MATH UTIL
+TEST_REACH_DEPENDS = TERRAIN IO ZZIP OS THREAD ROUTE GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_reach,TEST_REACH))
 
 TEST_ROUTE_SOURCES = \
@@ -298,7 +316,7 @@ TEST_ROUTE_SOURCES = \
 	$(TEST_SRC_DIR)/harness_airspace.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/test_route.cpp
-TEST_ROUTE_DEPENDS = TERRAIN IO ZZIP OS ROUTE AIRSPACE GLIDE GEO MATH UTIL
+TEST_ROUTE_DEPENDS = TERRAIN IO ZZIP OS THREAD ROUTE AIRSPACE GLIDE GEO MATH UTIL
 $(eval $(call link-program,test_route,TEST_ROUTE))
 
 TEST_REPLAY_TASK_SOURCES = \
@@ -370,6 +388,57 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_TRAFFIC_COLUMNS_SOURCES = \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/TrafficColumns.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTrafficColumns.cpp
+TEST_TRAFFIC_COLUMNS_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestTrafficColumns,TEST_TRAFFIC_COLUMNS))
+
+TEST_TRACE_SNAPSHOT_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTraceSnapshot.cpp
+TEST_TRACE_SNAPSHOT_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTraceSnapshot,TEST_TRACE_SNAPSHOT))
+
+TEST_CONTEST_BOUND_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestContestBound.cpp
+TEST_CONTEST_BOUND_DEPENDS = CONTEST GEO MATH TIME UTIL
+$(eval $(call link-program,TestContestBound,TEST_CONTEST_BOUND))
+
+TEST_DIJKSTRA_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestDijkstra.cpp
+TEST_DIJKSTRA_DEPENDS = MATH UTIL
+$(eval $(call link-program,TestDijkstra,TEST_DIJKSTRA))
+
+TEST_TASK_DIJKSTRA_SOURCES = \
+	$(SRC)/Engine/Task/PathSolvers/TaskDijkstra.cpp \
+	$(SRC)/Engine/Task/PathSolvers/TaskDijkstraMin.cpp \
+	$(SRC)/Engine/Task/PathSolvers/TaskDijkstraMax.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskDijkstra.cpp
+TEST_TASK_DIJKSTRA_DEPENDS = GEO MATH UTIL
+$(eval $(call link-program,TestTaskDijkstra,TEST_TASK_DIJKSTRA))
+
+TEST_ABORT_TASK_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAbortTask.cpp
+TEST_ABORT_TASK_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+$(eval $(call link-program,TestAbortTask,TEST_ABORT_TASK))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -569,6 +638,13 @@ TEST_ALLOCATED_GRID_SOURCES = \
 TEST_ALLOCATED_GRID_DEPENDS = UTIL
 $(eval $(call link-program,TestAllocatedGrid,TEST_ALLOCATED_GRID))
 
+TEST_SLOPE_SHADING_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSlopeShading.cpp
+TEST_SLOPE_SHADING_DEPENDS = MATH
+$(eval $(call link-program,TestSlopeShading,TEST_SLOPE_SHADING))
+
 TEST_RADIX_TREE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestRadixTree.cpp
@@ -586,11 +662,12 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Logger/AsyncTextWriter.cpp \
 	$(SRC)/Version.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
 TEST_GRECORD_SOURCES = \
@@ -696,7 +773,11 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkTerrainRenderer \
+	BenchmarkAirspaces \
+	BenchmarkGlideComputer \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
+	AnalyseTiming \
 	DumpHexColor \
 	RunXMLParser \
 	ReadMO \
@@ -705,7 +786,7 @@ DEBUG_PROGRAM_NAMES = \
 	ReadGRecord VerifyGRecord AppendGRecord FixGRecord \
 	AddChecksum \
 	KeyCodeDumper \
-	LoadTopography LoadTerrain \
+	LoadTopography ConvertTopography LoadTerrain ConvertTerrain \
 	RunHeightMatrix \
 	RunInputParser \
 	RunWaypointParser RunAirspaceParser \
@@ -754,7 +835,7 @@ DEBUG_PROGRAM_NAMES = \
 
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
-	AnalyseFlight \
+	AnalyseFlight AnalyseFlights \
 	FeedFlyNetData
 endif
 
@@ -853,11 +934,128 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_TERRAIN_RENDERER_SOURCES = \
+	$(SRC)/Terrain/SlopeShading.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTerrainRenderer.cpp
+BENCHMARK_TERRAIN_RENDERER_DEPENDS = OS MATH UTIL
+$(eval $(call link-program,BenchmarkTerrainRenderer,BENCHMARK_TERRAIN_RENDERER))
+
+BENCHMARK_AIRSPACES_SOURCES = \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAirspaces.cpp
+BENCHMARK_AIRSPACES_DEPENDS = AIRSPACE GEO MATH UTIL
+$(eval $(call link-program,BenchmarkAirspaces,BENCHMARK_AIRSPACES))
+
+BENCHMARK_GLIDE_COMPUTER_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Task/Serialiser.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointWriter.cpp \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalBase.cpp \
+	$(SRC)/Computer/ThermalBandComputer.cpp \
+	$(SRC)/Computer/GlideRatioCalculator.cpp \
+	$(SRC)/Computer/AutoQNH.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/Wind/Settings.cpp \
+	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/ContestSolverPool.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/AverageVarioComputer.cpp \
+	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/TaskComputer.cpp \
+	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/GlideComputerAirData.cpp \
+	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/GlideComputerInterface.cpp \
+	$(SRC)/Computer/LogComputer.cpp \
+	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Computer/Settings.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/Audio/VegaVoiceSettings.cpp \
+	$(SRC)/Audio/VegaVoice.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Tracking/TrackingSettings.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
+	$(SRC)/Airspace/AirspaceGlue.cpp \
+	$(SRC)/Airspace/AirspaceVisibility.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/Profile/Profile.cpp \
+	$(SRC)/Profile/ProfileKeys.cpp \
+	$(SRC)/Profiler/Profiler.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/IO/ConfiguredFile.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
+	$(SRC)/Operation/NoCancelOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/FakeAsset.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkGlideComputer.cpp
+BENCHMARK_GLIDE_COMPUTER_DEPENDS = TERRAIN DRIVER PROFILE IO OS THREAD CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE JASPER ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkGlideComputer,BENCHMARK_GLIDE_COMPUTER))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
 $(eval $(call link-program,DumpTextFile,DUMP_TEXT_FILE))
 
+ANALYSE_TIMING_SOURCES = \
+	$(TEST_SRC_DIR)/AnalyseTiming.cpp
+ANALYSE_TIMING_DEPENDS = IO OS UTIL
+$(eval $(call link-program,AnalyseTiming,ANALYSE_TIMING))
+
 RUN_KALMAN_FILTER_1D_SOURCES = \
 	$(TEST_SRC_DIR)/RunKalmanFilter1d.cpp
 RUN_KALMAN_FILTER_1D_DEPENDS = IO OS MATH UTIL
@@ -1052,6 +1250,7 @@ $(eval $(call link-program,KeyCodeDumper,KEY_CODE_DUMPER))
 LOAD_TOPOGRAPHY_SOURCES = \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/TopographyCache.cpp \
 	$(SRC)/Topography/XShape.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
@@ -1061,26 +1260,60 @@ ifeq ($(OPENGL),y)
 LOAD_TOPOGRAPHY_SOURCES += \
 	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp
 endif
-LOAD_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH IO UTIL SHAPELIB ZZIP
+LOAD_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH IO OS THREAD UTIL SHAPELIB ZZIP
 LOAD_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
 $(eval $(call link-program,LoadTopography,LOAD_TOPOGRAPHY))
 
+CONVERT_TOPOGRAPHY_SOURCES = \
+	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyFile.cpp \
+	$(SRC)/Topography/TopographyCache.cpp \
+	$(SRC)/Topography/XShape.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/ConvertTopography.cpp
+ifeq ($(OPENGL),y)
+CONVERT_TOPOGRAPHY_SOURCES += \
+	$(SCREEN_SRC_DIR)/OpenGL/Triangulate.cpp
+endif
+CONVERT_TOPOGRAPHY_DEPENDS = RESOURCE GEO MATH IO OS THREAD UTIL SHAPELIB ZZIP
+CONVERT_TOPOGRAPHY_CPPFLAGS = $(SCREEN_CPPFLAGS)
+$(eval $(call link-program,ConvertTopography,CONVERT_TOPOGRAPHY))
+
 LOAD_TERRAIN_SOURCES = \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/LoadTerrain.cpp
 LOAD_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
-LOAD_TERRAIN_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+LOAD_TERRAIN_DEPENDS = TERRAIN GEO MATH IO OS THREAD ZZIP UTIL
 $(eval $(call link-program,LoadTerrain,LOAD_TERRAIN))
 
+CONVERT_TERRAIN_SOURCES = \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/ConvertTerrain.cpp
+CONVERT_TERRAIN_CPPFLAGS = $(SCREEN_CPPFLAGS)
+CONVERT_TERRAIN_DEPENDS = TERRAIN GEO MATH IO OS THREAD ZZIP UTIL
+$(eval $(call link-program,ConvertTerrain,CONVERT_TERRAIN))
+
 RUN_HEIGHT_MATRIX_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/RunHeightMatrix.cpp
 RUN_HEIGHT_MATRIX_CPPFLAGS = $(SCREEN_CPPFLAGS)
-RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN GEO MATH IO OS ZZIP UTIL
+RUN_HEIGHT_MATRIX_DEPENDS = TERRAIN GEO MATH IO OS THREAD ZZIP UTIL
 $(eval $(call link-program,RunHeightMatrix,RUN_HEIGHT_MATRIX))
 
+TEST_HEIGHT_MATRIX_SOURCES = \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestHeightMatrix.cpp
+TEST_HEIGHT_MATRIX_CPPFLAGS = $(SCREEN_CPPFLAGS)
+TEST_HEIGHT_MATRIX_DEPENDS = TERRAIN GEO MATH IO OS THREAD ZZIP UTIL
+$(eval $(call link-program,TestHeightMatrix,TEST_HEIGHT_MATRIX))
+
 RUN_INPUT_PARSER_SOURCES = \
 	$(SRC)/Input/InputKeys.cpp \
 	$(SRC)/Input/InputConfig.cpp \
@@ -1494,6 +1727,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Logger/AsyncTextWriter.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(TEST_SRC_DIR)/RunIGCWriter.cpp
 RUN_IGC_WRITER_LDADD = $(DEBUG_REPLAY_LDADD)
@@ -1620,11 +1854,19 @@ ANALYSE_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/ContestPrinting.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseJSON.cpp \
 	$(TEST_SRC_DIR)/FlightPhaseDetector.cpp \
+	$(TEST_SRC_DIR)/FlightAnalyser.cpp \
 	$(TEST_SRC_DIR)/AnalyseFlight.cpp
 ANALYSE_FLIGHT_LDADD = $(DEBUG_REPLAY_LDADD)
 ANALYSE_FLIGHT_DEPENDS = CONTEST UTIL GEO MATH TIME
 $(eval $(call link-program,AnalyseFlight,ANALYSE_FLIGHT))
 
+ANALYSE_FLIGHTS_SOURCES = \
+	$(filter-out $(TEST_SRC_DIR)/AnalyseFlight.cpp,$(ANALYSE_FLIGHT_SOURCES)) \
+	$(TEST_SRC_DIR)/AnalyseFlights.cpp
+ANALYSE_FLIGHTS_LDADD = $(DEBUG_REPLAY_LDADD)
+ANALYSE_FLIGHTS_DEPENDS = $(ANALYSE_FLIGHT_DEPENDS)
+$(eval $(call link-program,AnalyseFlights,ANALYSE_FLIGHTS))
+
 FLIGHT_PATH_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -1674,6 +1916,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
 	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
 	$(SRC)/Engine/Navigation/Aircraft.cpp \
 	$(IO_SRC_DIR)/DataFile.cpp \
 	$(IO_SRC_DIR)/ConfiguredFile.cpp \
@@ -1716,6 +1959,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowGlideRange.cpp \
 	$(SRC)/Projection/MapWindowProjection.cpp \
 	$(SRC)/MapWindow/MapWindowRender.cpp \
+	$(SRC)/Profiler/Profiler.cpp \
 	$(SRC)/MapWindow/MapWindowSymbols.cpp \
 	$(SRC)/MapWindow/MapWindowContest.cpp \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
@@ -1732,6 +1976,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspacePolygonCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/BestCruiseArrowRenderer.cpp \
 	$(SRC)/Renderer/CompassRenderer.cpp \
@@ -1785,6 +2030,8 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
+	$(SRC)/Topography/TopographyUpdater.cpp \
+	$(SRC)/Topography/TopographyCache.cpp \
 	$(SRC)/Topography/TopographyFileRenderer.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
 	$(SRC)/Topography/TopographyGlue.cpp \
@@ -2140,6 +2387,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
 	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Trace/Snapshot.cpp \
 	$(SRC)/NMEA/Aircraft.cpp \
 	$(SRC)/UIUtil/GestureManager.cpp \
 	$(SRC)/Task/Serialiser.cpp \
@@ -2248,6 +2496,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/Wind/Computer.cpp \
 	$(SRC)/Computer/Wind/Settings.cpp \
 	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/ContestSolverPool.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
 	$(SRC)/Computer/LiftDatabaseComputer.cpp \
@@ -2284,6 +2533,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Airspace/ActivePredicate.cpp \
 	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceCache.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
 	$(SRC)/Airspace/AirspaceVisibility.cpp \
 	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
@@ -0,0 +1,268 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+
+#include <memory>
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * The header of the file written by SaveAirspaceCache().  The sizes
+ * of the platform dependent types are part of it, so a cache written
+ * by a different build is rejected.
+ */
+struct AirspaceCacheHeader {
+  static constexpr uint32_t MAGIC = 0x58435341;
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t magic, version;
+
+  uint8_t tchar_size, fixed_size, geo_point_size, altitude_size;
+
+  uint32_t n_airspaces;
+};
+
+/**
+ * The fixed-size part of each airspace.  It is followed by the name
+ * and the radio frequency (uint32_t length and the characters), and
+ * then by the center and the radius (circle) or the number of
+ * vertices and the vertices (polygon).
+ */
+struct AirspaceCacheRecord {
+  AbstractAirspace::Shape shape;
+  uint8_t type;
+  AirspaceActivity days;
+  AirspaceAltitude base, top;
+};
+
+template<typename T>
+static bool
+Write(FILE *file, const T &value)
+{
+  return fwrite(&value, sizeof(value), 1, file) == 1;
+}
+
+static bool
+WriteString(FILE *file, const tstring &value)
+{
+  const uint32_t length = value.length();
+  return Write(file, length) &&
+    fwrite(value.data(), sizeof(TCHAR), length, file) == length;
+}
+
+static bool
+WriteAirspace(FILE *file, const AbstractAirspace &airspace,
+              std::vector<GeoPoint> &points)
+{
+  AirspaceCacheRecord record;
+  memset(&record, 0, sizeof(record));
+  record.shape = airspace.GetShape();
+  record.type = (uint8_t)airspace.GetType();
+  record.days = airspace.GetDays();
+  record.base = airspace.GetBase();
+  record.top = airspace.GetTop();
+
+  if (!Write(file, record) ||
+      !WriteString(file, tstring(airspace.GetName())) ||
+      !WriteString(file, airspace.GetRadioText()))
+    return false;
+
+  switch (airspace.GetShape()) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    const AirspaceCircle &circle = (const AirspaceCircle &)airspace;
+    return Write(file, circle.GetCenter()) &&
+      Write(file, circle.GetRadius());
+  }
+
+  case AbstractAirspace::Shape::POLYGON:
+    points.clear();
+    for (const auto &i : airspace.GetPoints())
+      points.push_back(i.GetLocation());
+
+    const uint32_t n_points = points.size();
+    return Write(file, n_points) &&
+      fwrite(points.data(), sizeof(points.front()), n_points,
+             file) == n_points;
+  }
+
+  return false;
+}
+
+bool
+SaveAirspaceCache(FILE *file,
+                  const std::vector<const AbstractAirspace *> &airspaces)
+{
+  AirspaceCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = AirspaceCacheHeader::MAGIC;
+  header.version = AirspaceCacheHeader::VERSION;
+  header.tchar_size = sizeof(TCHAR);
+  header.fixed_size = sizeof(fixed);
+  header.geo_point_size = sizeof(GeoPoint);
+  header.altitude_size = sizeof(AirspaceAltitude);
+  header.n_airspaces = airspaces.size();
+
+  if (!Write(file, header))
+    return false;
+
+  std::vector<GeoPoint> points;
+  for (const AbstractAirspace *airspace : airspaces)
+    if (!WriteAirspace(file, *airspace, points))
+      return false;
+
+  return true;
+}
+
+/**
+ * Reads values from the buffer.  The buffer is not necessarily
+ * aligned, therefore all values are copied.
+ */
+class AirspaceCacheReader {
+  const uint8_t *p;
+  const uint8_t *const end;
+
+public:
+  AirspaceCacheReader(const void *data, size_t size)
+    :p((const uint8_t *)data), end(p + size) {}
+
+  bool IsEnd() const {
+    return p == end;
+  }
+
+  bool Read(void *dest, size_t size) {
+    if (size > size_t(end - p))
+      return false;
+
+    memcpy(dest, p, size);
+    p += size;
+    return true;
+  }
+
+  template<typename T>
+  bool Read(T &value) {
+    return Read(&value, sizeof(value));
+  }
+
+  bool ReadString(tstring &value) {
+    uint32_t length;
+    if (!Read(length) || length > size_t(end - p) / sizeof(TCHAR))
+      return false;
+
+    value.resize(length);
+    return Read(&value[0], length * sizeof(TCHAR));
+  }
+
+  bool ReadPoints(std::vector<GeoPoint> &points) {
+    uint32_t n;
+    if (!Read(n) || n > size_t(end - p) / sizeof(GeoPoint))
+      return false;
+
+    points.resize(n);
+    return Read(points.data(), n * sizeof(GeoPoint));
+  }
+};
+
+static AbstractAirspace *
+ReadAirspace(AirspaceCacheReader &reader, std::vector<GeoPoint> &points)
+{
+  AirspaceCacheRecord record;
+  tstring name, radio;
+  if (!reader.Read(record) || record.type >= AIRSPACECLASSCOUNT ||
+      !reader.ReadString(name) || !reader.ReadString(radio))
+    return nullptr;
+
+  AbstractAirspace *airspace;
+  switch (record.shape) {
+  case AbstractAirspace::Shape::CIRCLE: {
+    GeoPoint center;
+    fixed radius;
+    if (!reader.Read(center) || !reader.Read(radius))
+      return nullptr;
+
+    airspace = new AirspaceCircle(center, radius);
+    break;
+  }
+
+  case AbstractAirspace::Shape::POLYGON:
+    if (!reader.ReadPoints(points) || points.size() < 3)
+      return nullptr;
+
+    airspace = new AirspacePolygon(points);
+    break;
+
+  default:
+    return nullptr;
+  }
+
+  airspace->SetProperties(std::move(name), (AirspaceClass)record.type,
+                          record.base, record.top);
+  airspace->SetRadio(radio);
+  airspace->SetDays(record.days);
+  return airspace;
+}
+
+bool
+LoadAirspaceCache(Airspaces &airspaces, const void *data, size_t size)
+{
+  AirspaceCacheReader reader(data, size);
+
+  AirspaceCacheHeader header;
+  if (!reader.Read(header) ||
+      header.magic != AirspaceCacheHeader::MAGIC ||
+      header.version != AirspaceCacheHeader::VERSION ||
+      header.tchar_size != sizeof(TCHAR) ||
+      header.fixed_size != sizeof(fixed) ||
+      header.geo_point_size != sizeof(GeoPoint) ||
+      header.altitude_size != sizeof(AirspaceAltitude) ||
+      /* each airspace needs at least one record */
+      header.n_airspaces > size / sizeof(AirspaceCacheRecord))
+    return false;
+
+  /* parse everything before adding anything, so a truncated file
+     does not leave half of its airspaces behind */
+  std::vector<std::unique_ptr<AbstractAirspace>> result;
+  result.reserve(header.n_airspaces);
+
+  std::vector<GeoPoint> points;
+  for (unsigned i = 0; i < header.n_airspaces; ++i) {
+    AbstractAirspace *airspace = ReadAirspace(reader, points);
+    if (airspace == nullptr)
+      return false;
+
+    result.emplace_back(airspace);
+  }
+
+  if (!reader.IsEnd())
+    return false;
+
+  for (auto &i : result)
+    airspaces.Add(i.release());
+
+  return true;
+}
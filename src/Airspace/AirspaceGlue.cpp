@@ -23,32 +23,102 @@ Copyright_License {
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Profile/ProfileKeys.hpp"
 #include "Operation/Operation.hpp"
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
 #include "IO/TextFile.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileMapping.hpp"
 #include "Profile/Profile.hpp"
 
 #include <windef.h> /* for MAX_PATH */
 #include <memory>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Generate the #FileCache name for the specified airspace file.  It
+ * contains a hash of the path, because the #FileCache only checks
+ * the modification time and the size of the original file.
+ */
+static void
+MakeCacheName(TCHAR *buffer, const TCHAR *path)
+{
+  /* FNV-1a */
+  uint32_t hash = 2166136261u;
+  for (; *path != _T('\0'); ++path)
+    hash = (hash ^ (uint32_t)*path) * 16777619u;
+
+  _stprintf(buffer, _T("airspace-%08x"), (unsigned)hash);
+}
 
 static bool
-ParseAirspaceFile(AirspaceParser &parser, const TCHAR *path,
-                  OperationEnvironment &operation)
+LoadAirspaceCache(Airspaces &airspaces, FileCache &cache,
+                  const TCHAR *cache_name, const TCHAR *path)
 {
+  std::unique_ptr<FileMapping> mapping(cache.Map(cache_name, path));
+  return mapping &&
+    LoadAirspaceCache(airspaces, mapping->at(FileCache::DATA_OFFSET),
+                      mapping->size() - FileCache::DATA_OFFSET);
+}
+
+/**
+ * Save the airspaces which were added to #airspaces since the
+ * specified position (in the list returned by
+ * Airspaces::GetPending()).
+ */
+static void
+SaveAirspaceCache(const Airspaces &airspaces, unsigned first,
+                  FileCache &cache,
+                  const TCHAR *cache_name, const TCHAR *path)
+{
+  const auto &pending = airspaces.GetPending();
+  const std::vector<const AbstractAirspace *>
+    list(pending.begin() + first, pending.end());
+
+  FILE *file = cache.Save(cache_name, path);
+  if (file == nullptr)
+    return;
+
+  if (SaveAirspaceCache(file, list))
+    cache.Commit(cache_name, file);
+  else
+    cache.Cancel(cache_name, file);
+}
+
+static bool
+ParseAirspaceFile(Airspaces &airspaces, const TCHAR *path,
+                  FileCache *cache, OperationEnvironment &operation)
+{
+  TCHAR cache_name[32];
+  MakeCacheName(cache_name, path);
+
+  if (cache != nullptr &&
+      LoadAirspaceCache(airspaces, *cache, cache_name, path))
+    return true;
+
   std::unique_ptr<TLineReader> reader(OpenTextFile(path, ConvertLineReader::AUTO));
   if (!reader) {
     LogFormat(_T("Failed to open airspace file: %s"), path);
     return false;
   }
 
+  const unsigned first = airspaces.GetPending().size();
+
+  AirspaceParser parser(airspaces);
   if (!parser.Parse(*reader, operation)) {
     LogFormat(_T("Failed to parse airspace file: %s"), path);
     return false;
   }
 
+  if (cache != nullptr)
+    SaveAirspaceCache(airspaces, first, *cache, cache_name, path);
+
   return true;
 }
 
@@ -56,6 +126,7 @@ void
 ReadAirspace(Airspaces &airspaces,
              RasterTerrain *terrain,
              const AtmosphericPressure &press,
+             FileCache *cache,
              OperationEnvironment &operation)
 {
   LogFormat("ReadAirspace");
@@ -63,19 +134,17 @@ ReadAirspace(Airspaces &airspaces,
 
   bool airspace_ok = false;
 
-  AirspaceParser parser(airspaces);
-
   // Read the airspace filenames from the registry
   TCHAR path[MAX_PATH];
   if (Profile::GetPath(ProfileKeys::AirspaceFile, path))
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ParseAirspaceFile(airspaces, path, cache, operation);
 
   if (Profile::GetPath(ProfileKeys::AdditionalAirspaceFile, path))
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ParseAirspaceFile(airspaces, path, cache, operation);
 
   if (Profile::GetPath(ProfileKeys::MapFile, path)) {
     _tcscat(path, _T("/airspace.txt"));
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ParseAirspaceFile(airspaces, path, cache, operation);
   }
 
   if (airspace_ok) {
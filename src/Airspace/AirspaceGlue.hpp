@@ -28,14 +28,20 @@ class RasterTerrain;
 class AtmosphericPressure;
 class Airspaces;
 class OperationEnvironment;
+class FileCache;
 
 /**
  * Reads the airspace files into the memory
+ *
+ * @param cache an optional #FileCache; each parsed airspace file is
+ * stored there in a binary format, which is loaded instead of the
+ * original file on the next call
  */
 void
 ReadAirspace(Airspaces &airspaces,
              RasterTerrain *terrain,
              const AtmosphericPressure &press,
+             FileCache *cache,
              OperationEnvironment &operation);
 
 #endif
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Hardware/CPU.hpp"
+#include "Profiler/Profiler.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -62,6 +63,10 @@ CalculationThread::Tick()
   const ScopeLockCPU cpu;
 #endif
 
+  const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION);
+  Profiler::StageTimer stage_timer;
+  stage_timer.Mark(Profiler::Stage::CALCULATION_READ);
+
   const Validity previous_warning =
     glide_computer.Calculated().airspace_warnings.latest;
 
@@ -92,6 +97,8 @@ CalculationThread::Tick()
 
   glide_computer.Expire();
 
+  stage_timer.Mark(Profiler::Stage::CALCULATION_GPS);
+
   bool do_idle = false;
 
   if (gps_updated || force)
@@ -101,6 +108,7 @@ CalculationThread::Tick()
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
+  stage_timer.Mark(Profiler::Stage::CALCULATION_WRITE);
   {
     ScopeLock protect(device_blackboard->mutex);
     device_blackboard->ReadBlackboard(glide_computer.Calculated());
@@ -113,6 +121,7 @@ CalculationThread::Tick()
 
   if (do_idle) {
     // do slow calculations last, to minimise latency
+    stage_timer.Mark(Profiler::Stage::CALCULATION_IDLE);
     glide_computer.ProcessIdle();
 
     if (glide_computer.Calculated().airspace_warnings.latest != previous_warning) {
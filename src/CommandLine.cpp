@@ -31,6 +31,7 @@ Copyright_License {
 #include "Util/CharUtil.hpp"
 #include "Util/NumberParser.hpp"
 #include "Asset.hpp"
+#include "Profiler/Profiler.hpp"
 
 #ifdef WIN32
 #include <windows.h> /* for AllocConsole() */
@@ -74,6 +75,9 @@ CommandLine::Parse(Args &args)
       PathName convert(s);
       SetPrimaryDataPath(convert);
     }
+    else if (strcmp(s, "-timing") == 0) {
+      Profiler::Enable();
+    }
 #ifdef SIMULATOR_AVAILABLE
     else if (strcmp(s, "-simulator") == 0) {
       global_simulator_flag = true;
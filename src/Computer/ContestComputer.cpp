@@ -24,14 +24,77 @@ Copyright_License {
 #include "ContestComputer.hpp"
 #include "Engine/Contest/Settings.hpp"
 
+/**
+ * How long each solver may run per Solve() call.
+ */
+static constexpr unsigned SOLVER_BUDGET_MS = 200;
+
+ContestComputer::TraceMirror::TraceMirror(const Trace &_master)
+  :master(_master),
+   /* no time window and no thinning: the master has already done
+      that, and Update() copies all points again when it does */
+   trace(0, Trace::null_time, _master.GetMaxSize()),
+   append_serial(master.GetAppendSerial()),
+   modify_serial(master.GetModifySerial()) {}
+
+void
+ContestComputer::TraceMirror::Update()
+{
+  if (master.GetModifySerial() != modify_serial) {
+    trace.clear();
+    for (const TracePoint &i : master)
+      trace.push_back(i);
+  } else if (master.GetAppendSerial() != append_serial) {
+    /* walk backwards from the end to find the points which were
+       appended since the last call, and copy only those */
+    const Trace::const_iterator begin = master.begin(), end = master.end();
+    Trace::const_iterator i = end;
+    if (trace.empty())
+      i = begin;
+    else {
+      const unsigned last_time = trace.back().GetTime();
+      while (i != begin) {
+        Trace::const_iterator previous = i;
+        --previous;
+        if (previous->GetTime() <= last_time)
+          break;
+
+        i = previous;
+      }
+    }
+
+    for (; i != end; ++i)
+      trace.push_back(*i);
+  } else
+    return;
+
+  append_serial = master.GetAppendSerial();
+  modify_serial = master.GetModifySerial();
+}
+
 ContestComputer::ContestComputer(const Trace &trace_full,
                                  const Trace &trace_triangle,
                                  const Trace &trace_sprint)
-  :contest_manager(Contest::OLC_SPRINT, trace_full, trace_triangle, trace_sprint, true)
+  :full(trace_full), triangle(trace_triangle), sprint(trace_sprint),
+   contest_manager(Contest::OLC_SPRINT, full.Get(), triangle.Get(),
+                   sprint.Get(), true),
+   predicted(TracePoint::Invalid())
 {
   contest_manager.SetIncremental(true);
 }
 
+void
+ContestComputer::Prepare(const ContestSettings &settings)
+{
+  contest_manager.SetHandicap(settings.handicap);
+  contest_manager.SetContest(settings.contest);
+  contest_manager.SetPredicted(predicted);
+
+  full.Update();
+  triangle.Update();
+  sprint.Update();
+}
+
 void
 ContestComputer::Solve(const ContestSettings &settings,
                        ContestStatistics &contest_stats)
@@ -39,12 +102,19 @@ ContestComputer::Solve(const ContestSettings &settings,
   if (!settings.enable)
     return;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
-
-  contest_manager.UpdateIdle();
+  if (pool.IsBusy())
+    /* try again next time; meanwhile, the previous results remain
+       visible */
+    return;
 
+  contest_manager.UpdateDependent(pool.Collect(), false);
   contest_stats = contest_manager.GetStats();
+
+  Prepare(settings);
+
+  ContestManager::SolverJob jobs[ContestManager::MAX_INDEPENDENT_SOLVERS];
+  const unsigned n = contest_manager.GetIndependentSolvers(jobs);
+  pool.Start(jobs, n, SOLVER_BUDGET_MS);
 }
 
 bool
@@ -54,8 +124,10 @@ ContestComputer::SolveExhaustive(const ContestSettings &settings,
   if (!settings.enable)
     return false;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
+  pool.Wait();
+  contest_manager.UpdateDependent(pool.Collect(), false);
+
+  Prepare(settings);
 
   bool result = contest_manager.SolveExhaustive();
 
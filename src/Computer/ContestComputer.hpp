@@ -24,40 +24,104 @@ Copyright_License {
 #ifndef XCSOAR_CONTEST_COMPUTER_HPP
 #define XCSOAR_CONTEST_COMPUTER_HPP
 
+#include "ContestSolverPool.hpp"
 #include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Point.hpp"
+#include "Util/Serial.hpp"
 
 struct ContestSettings;
 struct ContestStatistics;
-class Trace;
 
+/**
+ * Runs the contest solvers.  Solve() does not block: the solvers run
+ * in a #ContestSolverPool on private copies of the traces, and their
+ * results are published by the next Solve() call after they have
+ * finished.
+ */
 class ContestComputer {
+  /**
+   * A private #Trace which mirrors one owned by the #TraceComputer.
+   * It is updated only while the solvers are idle, so they can read
+   * it without locking while the #CalculationThread keeps appending
+   * to the original.
+   *
+   * This is not a #TraceSnapshot: the solvers need a real #Trace,
+   * because they use its serials to resume incrementally and its
+   * iterators to walk the points.
+   */
+  class TraceMirror {
+    const Trace &master;
+    Trace trace;
+
+    Serial append_serial, modify_serial;
+
+  public:
+    explicit TraceMirror(const Trace &_master);
+
+    const Trace &Get() const {
+      return trace;
+    }
+
+    /**
+     * Copy new points from the master.  If the master was modified
+     * (thinned, cleared), the whole trace is copied again.
+     */
+    void Update();
+  };
+
+  TraceMirror full, triangle, sprint;
+
   ContestManager contest_manager;
 
+  ContestSolverPool pool;
+
+  /**
+   * The value passed to SetPredicted(); it is applied to the
+   * #ContestManager by the next Solve() call.
+   */
+  TracePoint predicted;
+
 public:
   ContestComputer(const Trace &trace_full,
                   const Trace &trace_triangle,
                   const Trace &trace_sprint);
 
   void SetIncremental(bool incremental) {
+    pool.Wait();
     contest_manager.SetIncremental(incremental);
   }
 
   void Reset() {
+    pool.Wait();
+    pool.Collect();
     contest_manager.Reset();
   }
 
   /**
    * @see ContestDijkstra::SetPredicted()
    */
-  void SetPredicted(const TracePoint &predicted) {
-    contest_manager.SetPredicted(predicted);
+  void SetPredicted(const TracePoint &_predicted) {
+    predicted = _predicted;
   }
 
+  /**
+   * Publish the results of the previous run (if it has finished) and
+   * start the solvers again with the latest trace points.  Returns
+   * immediately.
+   */
   void Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
   bool SolveExhaustive(const ContestSettings &settings_computer,
                        ContestStatistics &contest_stats);
+
+private:
+  /**
+   * Apply the settings and copy the new trace points.  The solvers
+   * must be idle.
+   */
+  void Prepare(const ContestSettings &settings);
 };
 
 #endif
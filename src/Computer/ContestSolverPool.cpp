@@ -0,0 +1,127 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ContestSolverPool.hpp"
+#include "Time/PeriodClock.hpp"
+
+ContestSolverPool::Worker::Worker()
+  :StandbyThread("Contest"),
+   job{nullptr, nullptr, nullptr}, budget_ms(0), changed(false) {}
+
+void
+ContestSolverPool::Worker::Start(const ContestManager::SolverJob &_job,
+                                 unsigned _budget_ms)
+{
+  assert(_job.solver != nullptr);
+
+  ScopeLock protect(mutex);
+  assert(!StandbyThread::IsBusy());
+
+  job = _job;
+  budget_ms = _budget_ms;
+  Trigger();
+}
+
+bool
+ContestSolverPool::Worker::Collect()
+{
+  ScopeLock protect(mutex);
+  assert(!StandbyThread::IsBusy());
+
+  bool result = changed;
+  changed = false;
+  return result;
+}
+
+void
+ContestSolverPool::Worker::Tick()
+{
+  const ContestManager::SolverJob _job = job;
+  const unsigned _budget_ms = budget_ms;
+
+  mutex.Unlock();
+
+  PeriodClock clock;
+  clock.Update();
+
+  bool _changed = false;
+  do {
+    /* only FAILED means there is nothing left to do until new trace
+       points arrive */
+    const SolverResult result = _job.Run(false);
+    if (result == SolverResult::VALID)
+      _changed = true;
+    else if (result == SolverResult::FAILED)
+      break;
+  } while (!clock.Check(_budget_ms));
+
+  mutex.Lock();
+
+  if (_changed)
+    changed = true;
+}
+
+void
+ContestSolverPool::Start(const ContestManager::SolverJob *jobs, unsigned n,
+                         unsigned budget_ms)
+{
+  assert(n <= ContestManager::MAX_INDEPENDENT_SOLVERS);
+
+  for (unsigned i = 0; i < n; ++i)
+    workers[i].Start(jobs[i], budget_ms);
+}
+
+bool
+ContestSolverPool::IsBusy()
+{
+  for (auto &worker : workers)
+    if (worker.IsBusy())
+      return true;
+
+  return false;
+}
+
+void
+ContestSolverPool::Wait()
+{
+  for (auto &worker : workers)
+    worker.Wait();
+}
+
+bool
+ContestSolverPool::Collect()
+{
+  bool result = false;
+  for (auto &worker : workers)
+    if (worker.Collect())
+      result = true;
+
+  return result;
+}
+
+void
+ContestSolverPool::Stop()
+{
+  for (auto &worker : workers)
+    worker.Stop();
+}
@@ -0,0 +1,120 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CONTEST_SOLVER_POOL_HPP
+#define XCSOAR_CONTEST_SOLVER_POOL_HPP
+
+#include "Engine/Contest/ContestManager.hpp"
+#include "Thread/StandbyThread.hpp"
+
+/**
+ * Runs the independent solvers of a #ContestManager (see
+ * ContestManager::GetIndependentSolvers()) concurrently, one worker
+ * thread per solver.  The caller must not touch the #ContestManager
+ * or the traces it reads while IsBusy() returns true.
+ */
+class ContestSolverPool {
+  class Worker final : private StandbyThread {
+    /**
+     * The solver to be run.  Protected by StandbyThread::mutex.
+     */
+    ContestManager::SolverJob job;
+
+    /**
+     * How long Tick() may keep calling the solver.  Protected by
+     * StandbyThread::mutex.
+     */
+    unsigned budget_ms;
+
+    /**
+     * Has the solver found an improved solution since the last
+     * Collect() call?  Protected by StandbyThread::mutex.
+     */
+    bool changed;
+
+  public:
+    Worker();
+
+    void Start(const ContestManager::SolverJob &job, unsigned budget_ms);
+
+    bool IsBusy() {
+      ScopeLock protect(mutex);
+      return StandbyThread::IsBusy();
+    }
+
+    void Wait() {
+      LockWaitDone();
+    }
+
+    bool Collect();
+
+    void Stop() {
+      LockStop();
+    }
+
+  private:
+    /* virtual methods from class StandbyThread */
+    void Tick() override;
+  };
+
+  Worker workers[ContestManager::MAX_INDEPENDENT_SOLVERS];
+
+public:
+  ~ContestSolverPool() {
+    Stop();
+  }
+
+  /**
+   * Start the specified solvers.  Each one is called repeatedly in
+   * non-exhaustive mode until it completes or until the time budget
+   * is used up; the next Start() call continues where it stopped.
+   *
+   * Must not be called while IsBusy() returns true.
+   */
+  void Start(const ContestManager::SolverJob *jobs, unsigned n,
+             unsigned budget_ms);
+
+  /**
+   * Is one of the solvers still running?
+   */
+  gcc_pure
+  bool IsBusy();
+
+  /**
+   * Wait until all solvers have finished.
+   */
+  void Wait();
+
+  /**
+   * Check if one of the solvers has found an improved solution since
+   * the last call.  Must not be called while IsBusy() returns true.
+   */
+  bool Collect();
+
+  /**
+   * Stop all worker threads and wait for them to exit.
+   */
+  void Stop();
+};
+
+#endif
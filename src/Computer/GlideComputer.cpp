@@ -27,6 +27,7 @@ Copyright_License {
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "GlideComputerInterface.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "Profiler/Profiler.hpp"
 
 static PeriodClock last_team_code_update;
 
@@ -108,8 +109,11 @@ GlideComputer::ProcessGPS(bool force)
   calculated.Expire(basic.clock);
 
   // Process basic information
-  air_data_computer.ProcessBasic(Basic(), SetCalculated(),
-                                 GetComputerSettings());
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_AIR_DATA);
+    air_data_computer.ProcessBasic(Basic(), SetCalculated(),
+                                   GetComputerSettings());
+  }
 
   // Process basic task information
   task_computer.ProcessBasicTask(basic,
@@ -127,9 +131,12 @@ GlideComputer::ProcessGPS(bool force)
   task_computer.ProcessAutoTask(basic, calculated);
 
   // Process extended information
-  air_data_computer.ProcessVertical(Basic(),
-                                    SetCalculated(),
-                                    GetComputerSettings());
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_AIR_DATA);
+    air_data_computer.ProcessVertical(Basic(),
+                                      SetCalculated(),
+                                      GetComputerSettings());
+  }
 
   stats_computer.ProcessClimbEvents(calculated);
 
@@ -169,14 +176,20 @@ GlideComputer::ProcessIdle(bool exhaustive)
 
   // Log GPS fixes for internal usage
   // (snail trail, stats, olc, ...)
-  stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_LOG);
+    stats_computer.DoLogging(basic, calculated);
+    log_computer.Run(basic, calculated, GetComputerSettings().logger);
+  }
 
   task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
                             exhaustive);
 
-  warning_computer.Update(GetComputerSettings(), basic,
-                          calculated, calculated.airspace_warnings);
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_WARNING);
+    warning_computer.Update(GetComputerSettings(), basic,
+                            calculated, calculated.airspace_warnings);
+  }
 
   // Calculate summary of flight
   if (basic.location_available)
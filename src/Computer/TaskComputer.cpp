@@ -29,6 +29,7 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 #include "Settings.hpp"
+#include "Profiler/Profiler.hpp"
 
 #include <algorithm>
 
@@ -67,8 +68,12 @@ TaskComputer::ProcessBasicTask(const MoreData &basic,
                                const ComputerSettings &settings_computer,
                                bool force)
 {
-  trace.Update(settings_computer, basic, calculated);
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_TRACE);
+    trace.Update(settings_computer, basic, calculated);
+  }
 
+  const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_TASK);
   ProtectedTaskManager::ExclusiveLease _task(task);
 
   _task->SetTaskBehaviour(settings_computer.task);
@@ -108,10 +113,13 @@ TaskComputer::ProcessMoreTask(const MoreData &basic,
   const GlidePolar &glide_polar = settings_computer.polar.glide_polar_task;
   const GlidePolar &safety_polar = calculated.glide_polar_safety;
 
-  route.ProcessRoute(basic, calculated,
-                     settings_computer.task.glide,
-                     settings_computer.task.route_planner,
-                     glide_polar, safety_polar);
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_ROUTE);
+    route.ProcessRoute(basic, calculated,
+                       settings_computer.task.glide,
+                       settings_computer.task.route_planner,
+                       glide_polar, safety_polar);
+  }
 
   if (settings_computer.features.block_stf_enabled)
     calculated.V_stf = calculated.common_stats.V_block;
@@ -149,17 +157,21 @@ TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
                           const ComputerSettings &settings_computer,
                           bool exhaustive)
 {
-  contest.SetPredicted(Predicted(settings_computer.contest, basic,
-                                 calculated.task_stats.current_leg));
-
-  if (exhaustive)
-    contest.SolveExhaustive(settings_computer.contest,
-                            calculated.contest_stats);
-  else
-    contest.Solve(settings_computer.contest, calculated.contest_stats);
+  {
+    const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_CONTEST);
+    contest.SetPredicted(Predicted(settings_computer.contest, basic,
+                                   calculated.task_stats.current_leg));
+
+    if (exhaustive)
+      contest.SolveExhaustive(settings_computer.contest,
+                              calculated.contest_stats);
+    else
+      contest.Solve(settings_computer.contest, calculated.contest_stats);
+  }
 
   const AircraftState as = ToAircraftState(basic, calculated);
 
+  const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_TASK);
   ProtectedTaskManager::ExclusiveLease _task(task);
   _task->UpdateIdle(as);
 }
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "TraceComputer.hpp"
+#include "Engine/Trace/Vector.hpp"
 #include "Settings.hpp"
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
@@ -49,30 +50,47 @@ TraceComputer::TraceComputer()
 void
 TraceComputer::Reset()
 {
-  mutex.Lock();
   full.clear();
-  mutex.Unlock();
+  Publish();
 
   contest.clear();
   sprint.clear();
 }
 
 void
-TraceComputer::LockedCopyTo(TracePointVector &v) const
+TraceComputer::Publish()
 {
+  builder.Sync(full);
+
+  const TraceSnapshot new_snapshot = builder.Get();
+
   mutex.Lock();
-  full.GetPoints(v);
+  snapshot = new_snapshot;
   mutex.Unlock();
 }
 
+TraceSnapshot
+TraceComputer::GetSnapshot() const
+{
+  mutex.Lock();
+  TraceSnapshot result = snapshot;
+  mutex.Unlock();
+  return result;
+}
+
+void
+TraceComputer::LockedCopyTo(TracePointVector &v) const
+{
+  v.clear();
+  GetSnapshot().CopyTo(v);
+}
+
 void
 TraceComputer::LockedCopyTo(TracePointVector &v, unsigned min_time,
                             const GeoPoint &location,
                             fixed resolution) const
 {
-  mutex.Lock();
-  full.GetPoints(v, min_time, location, resolution);
-  mutex.Unlock();
+  GetSnapshot().CopyTo(v, min_time, location, resolution);
 }
 
 void
@@ -91,9 +109,10 @@ TraceComputer::Update(const ComputerSettings &settings_computer,
       settings_computer.task.enable_trace) {
     const TracePoint point(basic);
 
-    mutex.Lock();
+    const Serial old_serial = full.GetAppendSerial();
     full.push_back(point);
-    mutex.Unlock();
+    if (full.GetAppendSerial() != old_serial)
+      Publish();
 
     // only olc requires trace_sprint
     if (settings_computer.contest.enable) {
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "Thread/Mutex.hpp"
 #include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Snapshot.hpp"
 
 struct ComputerSettings;
 struct MoreData;
@@ -36,28 +37,32 @@ struct DerivedInfo;
  */
 class TraceComputer {
   /**
-   * This mutex protects trace_full: it must be locked while editing
-   * the trace, and while reading it from a thread other than the
-   * #CalculationThread.
+   * This mutex protects #snapshot.  The traces themselves are only
+   * accessed by the #CalculationThread.
    */
   mutable Mutex mutex;
 
   Trace full, contest, sprint;
 
-public:
-  TraceComputer();
+  /**
+   * Maintains a snapshot of the full trace; used by the
+   * #CalculationThread only.
+   */
+  TraceSnapshotBuilder builder;
 
-  void Lock() const {
-    mutex.Lock();
-  }
+  /**
+   * The most recent snapshot of the full trace, to be read by other
+   * threads.  Protected by #mutex.
+   */
+  TraceSnapshot snapshot;
 
-  void Unlock() const {
-    mutex.Unlock();
-  }
+public:
+  TraceComputer();
 
   /**
-   * Returns a reference to the full trace.  When using this reference
-   * outside of the #CalculationThread, the mutex must be locked.
+   * Returns a reference to the full trace.  This object may be used
+   * only inside the #CalculationThread; other threads shall use
+   * GetSnapshot().
    */
   const Trace &GetFull() const {
     return full;
@@ -82,13 +87,22 @@ public:
   void Reset();
 
   /**
-   * Extract all trace points.  The trace is locked, and the method
+   * Obtain a snapshot of the full trace.  The mutex is locked only
+   * while the reference is copied, therefore this method may be
+   * called from any thread without blocking the #CalculationThread
+   * for a noticeable amount of time.
+   */
+  gcc_pure
+  TraceSnapshot GetSnapshot() const;
+
+  /**
+   * Extract all trace points from the current snapshot.  The method
    * may be called from any thread.
    */
   void LockedCopyTo(TracePointVector &v) const;
 
   /**
-   * Extract some trace points.  The trace is locked, and the method
+   * Extract some trace points from the current snapshot.  The method
    * may be called from any thread.
    */
   void LockedCopyTo(TracePointVector &v, unsigned min_time,
@@ -96,6 +110,12 @@ public:
 
   void Update(const ComputerSettings &settings_computer,
               const MoreData &basic, const DerivedInfo &calculated);
+
+private:
+  /**
+   * Update the snapshot after the full trace has been modified.
+   */
+  void Publish();
 };
 
 #endif
@@ -98,6 +98,13 @@ AllDevicesPutQNH(const AtmosphericPressure &pres,
     i->PutQNH(pres, env);
 }
 
+void
+AllDevicesCollectData()
+{
+  for (DeviceDescriptor *i : device_list)
+    i->CollectData();
+}
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic)
 {
@@ -66,6 +66,13 @@ AllDevicesPutStandbyFrequency(RadioFrequency frequency,
 void
 AllDevicesPutQNH(const AtmosphericPressure &pres, OperationEnvironment &env);
 
+/**
+ * Copy new data from all devices into the #DeviceBlackboard.  The
+ * caller must hold the #DeviceBlackboard mutex.
+ */
+void
+AllDevicesCollectData();
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic);
 
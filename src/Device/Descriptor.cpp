@@ -109,10 +109,13 @@ DeviceDescriptor::DeviceDescriptor(unsigned _index)
    nunchuck(nullptr),
    voltage(nullptr),
 #endif
+   data_modified(false),
    n_failures(0u),
    ticker(false), borrowed(false)
 {
   config.Clear();
+  device_data.Reset();
+  data_snapshot.Reset();
 
 #ifdef ANDROID
   for (unsigned i=0; i<sizeof i2cbaro/sizeof i2cbaro[0]; i++)
@@ -226,12 +229,13 @@ DeviceDescriptor::OpenOnPort(DumpPort *_port, OperationEnvironment &env)
 
   reopen_clock.Update();
 
-  device_blackboard->mutex.Lock();
-  device_blackboard->SetRealState(index).Reset();
-  device_blackboard->ScheduleMerge();
-  device_blackboard->mutex.Unlock();
+  ResetData();
+
+  {
+    ScopeLock protect(data_mutex);
+    settings_sent.Clear();
+  }
 
-  settings_sent.Clear();
   settings_received.Clear();
   was_alive = false;
 
@@ -507,12 +511,13 @@ DeviceDescriptor::Close()
 
   ticker = false;
 
-  device_blackboard->mutex.Lock();
-  device_blackboard->SetRealState(index).Reset();
-  device_blackboard->ScheduleMerge();
-  device_blackboard->mutex.Unlock();
+  ResetData();
+
+  {
+    ScopeLock protect(data_mutex);
+    settings_sent.Clear();
+  }
 
-  settings_sent.Clear();
   settings_received.Clear();
 }
 
@@ -686,6 +691,8 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
        sent to the device */
     const ExternalSettings old_received = settings_received;
     settings_received = info.settings;
+
+    ScopeLock protect(data_mutex);
     info.settings.EliminateRedundant(settings_sent, old_received);
 
     return true;
@@ -760,10 +767,9 @@ DeviceDescriptor::PutMacCready(fixed value, OperationEnvironment &env)
   if (!device->PutMacCready(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(data_mutex);
   settings_sent.mac_cready = value;
-  settings_sent.mac_cready_available.Update(basic.clock);
+  settings_sent.mac_cready_available.Update(data_snapshot.clock);
 
   return true;
 }
@@ -785,10 +791,9 @@ DeviceDescriptor::PutBugs(fixed value, OperationEnvironment &env)
   if (!device->PutBugs(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(data_mutex);
   settings_sent.bugs = value;
-  settings_sent.bugs_available.Update(basic.clock);
+  settings_sent.bugs_available.Update(data_snapshot.clock);
 
   return true;
 }
@@ -812,12 +817,11 @@ DeviceDescriptor::PutBallast(fixed fraction, fixed overload,
   if (!device->PutBallast(fraction, overload, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(data_mutex);
   settings_sent.ballast_fraction = fraction;
-  settings_sent.ballast_fraction_available.Update(basic.clock);
+  settings_sent.ballast_fraction_available.Update(data_snapshot.clock);
   settings_sent.ballast_overload = overload;
-  settings_sent.ballast_overload_available.Update(basic.clock);
+  settings_sent.ballast_overload_available.Update(data_snapshot.clock);
 
   return true;
 }
@@ -892,10 +896,9 @@ DeviceDescriptor::PutQNH(const AtmosphericPressure &value,
   if (!device->PutQNH(value, env))
     return false;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  ScopeLock protect(data_mutex);
   settings_sent.qnh = value;
-  settings_sent.qnh_available.Update(basic.clock);
+  settings_sent.qnh_available.Update(data_snapshot.clock);
 
   return true;
 }
@@ -1049,12 +1052,49 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
     device->OnCalculatedUpdate(basic, calculated);
 }
 
+void
+DeviceDescriptor::ResetData()
+{
+  device_data.Reset();
+
+  ScopeLock protect(device_blackboard->mutex);
+
+  data_mutex.Lock();
+  data_snapshot.Reset();
+  data_modified = false;
+  data_mutex.Unlock();
+
+  device_blackboard->SetRealState(index).Reset();
+  device_blackboard->ScheduleMerge();
+}
+
+void
+DeviceDescriptor::PublishData()
+{
+  data_mutex.Lock();
+  data_snapshot = device_data;
+  data_modified = true;
+  data_mutex.Unlock();
+
+  device_blackboard->ScheduleMerge();
+}
+
+void
+DeviceDescriptor::CollectData()
+{
+  ScopeLock protect(data_mutex);
+  if (data_modified) {
+    device_blackboard->SetRealState(index) = data_snapshot;
+    data_modified = false;
+  }
+}
+
 bool
 DeviceDescriptor::ParseLine(const char *line)
 {
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  NMEAInfo &basic = device_data;
   basic.UpdateClock();
+  basic.Expire();
   return ParseNMEA(line, basic);
 }
 
@@ -1080,9 +1120,9 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
 
   // Pass data directly to drivers that use binary data protocols
   if (driver != NULL && device != NULL && driver->UsesRawData()) {
-    ScopeLock protect(device_blackboard->mutex);
-    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    NMEAInfo &basic = device_data;
     basic.UpdateClock();
+    basic.Expire();
 
     const ExternalSettings old_settings = basic.settings;
 
@@ -1090,7 +1130,7 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
       if (!config.sync_from_device)
         basic.settings = old_settings;
 
-      device_blackboard->ScheduleMerge();
+      PublishData();
     }
 
     return;
@@ -1109,5 +1149,5 @@ DeviceDescriptor::LineReceived(const char *line)
     dispatcher->LineReceived(line);
 
   if (ParseLine(line))
-    device_blackboard->ScheduleMerge();
+    PublishData();
 }
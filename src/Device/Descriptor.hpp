@@ -31,6 +31,7 @@ Copyright_License {
 #include "Device/Parser.hpp"
 #include "RadioFrequency.hpp"
 #include "NMEA/ExternalSettings.hpp"
+#include "NMEA/Info.hpp"
 #include "Time/PeriodClock.hpp"
 #include "Job/Async.hpp"
 #include "Event/Notify.hpp"
@@ -41,7 +42,6 @@ Copyright_License {
 #include <tchar.h>
 #include <stdio.h>
 
-struct NMEAInfo;
 struct MoreData;
 struct DerivedInfo;
 struct Declaration;
@@ -164,6 +164,33 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
    */
   ExternalSettings settings_sent;
 
+  /**
+   * This mutex protects the attributes #data_snapshot,
+   * #data_modified and #settings_sent.  It is only held for short
+   * copies, never while parsing, so the port thread does not need to
+   * wait for the merge thread (or vice versa).
+   */
+  Mutex data_mutex;
+
+  /**
+   * The sensor data received from this device.  This object is owned
+   * by the port thread; it may only be accessed by others while the
+   * port is closed.  Updates are published to #data_snapshot.
+   */
+  NMEAInfo device_data;
+
+  /**
+   * A copy of #device_data which is picked up by CollectData().
+   * Protected by #data_mutex.
+   */
+  NMEAInfo data_snapshot;
+
+  /**
+   * Has #data_snapshot been updated since the last CollectData()
+   * call?  Protected by #data_mutex.
+   */
+  bool data_modified;
+
   /**
    * The settings that were received from the device.  This temporary
    * buffer mirrors NMEA_INFO::settings; NMEA_INFO::settings may get
@@ -421,9 +448,30 @@ public:
   gcc_pure
   bool IsAlive() const;
 
+  /**
+   * Copy the data received since the last call into this device's
+   * slot in the #DeviceBlackboard.  This is called by the merge
+   * thread, and the caller must hold the #DeviceBlackboard mutex.
+   */
+  void CollectData();
+
 private:
   bool ParseNMEA(const char *line, struct NMEAInfo &info);
 
+  /**
+   * Reset #device_data, #data_snapshot and this device's slot in the
+   * #DeviceBlackboard.  May only be called while the port thread is
+   * not running.
+   */
+  void ResetData();
+
+  /**
+   * Publish #device_data to #data_snapshot and wake up the merge
+   * thread.  Called by the port thread after #device_data has been
+   * updated.
+   */
+  void PublishData();
+
 public:
   void SetMonitor(DataHandler  *_monitor) {
     monitor = _monitor;
@@ -223,6 +223,13 @@ public:
     days_of_operation = mask;
   }
 
+  /**
+   * Get the days of operation, see SetDays().
+   */
+  AirspaceActivity GetDays() const {
+    return days_of_operation;
+  }
+
   /** 
    * Get type of airspace
    * 
@@ -0,0 +1,124 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "AirspaceRTree.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+
+static int
+GetCenterX(const FlatBoundingBox &box)
+{
+  return box.GetLowerLeft().longitude + box.GetUpperRight().longitude;
+}
+
+static int
+GetCenterY(const FlatBoundingBox &box)
+{
+  return box.GetLowerLeft().latitude + box.GetUpperRight().latitude;
+}
+
+bool
+AirspaceRTree::erase(const Airspace &airspace)
+{
+  auto i = std::find(items.begin(), items.end(), airspace);
+  if (i == items.end())
+    return false;
+
+  items.erase(i);
+
+  /* the tree refers to envelopes by position, which has just
+     changed */
+  nodes.clear();
+  n_indexed = 0;
+  return true;
+}
+
+void
+AirspaceRTree::Optimise()
+{
+  if (IsOptimised())
+    return;
+
+  nodes.clear();
+  n_indexed = 0;
+
+  const unsigned n = items.size();
+  if (n == 0)
+    return;
+
+  /* sort-tile-recursive: sort by longitude, cut into vertical slices
+     of (roughly) sqrt(n_leaves) leaves, sort each slice by
+     latitude */
+
+  std::sort(items.begin(), items.end(),
+            [](const Airspace &a, const Airspace &b) {
+              return GetCenterX(a) < GetCenterX(b);
+            });
+
+  const unsigned n_leaves = (n + NODE_SIZE - 1) / NODE_SIZE;
+  const unsigned n_slices = (unsigned)ceil(sqrt((double)n_leaves));
+  const unsigned slice_size = n_slices * NODE_SIZE;
+
+  for (unsigned i = 0; i < n; i += slice_size)
+    std::sort(items.begin() + i, items.begin() + std::min(i + slice_size, n),
+              [](const Airspace &a, const Airspace &b) {
+                return GetCenterY(a) < GetCenterY(b);
+              });
+
+  for (unsigned i = 0; i < n; i += NODE_SIZE) {
+    Node node;
+    node.first = i;
+    node.count = std::min(unsigned(NODE_SIZE), n - i);
+    node.leaf = true;
+    node.bounds = items[i];
+    for (unsigned j = 1; j < node.count; ++j)
+      node.bounds.Merge(items[i + j]);
+
+    nodes.push_back(node);
+  }
+
+  /* the upper levels combine consecutive nodes, which are already
+     close to each other because of the sort order */
+
+  unsigned level_start = 0, level_end = nodes.size();
+  while (level_end - level_start > 1) {
+    for (unsigned i = level_start; i < level_end; i += NODE_SIZE) {
+      Node node;
+      node.first = i;
+      node.count = std::min(unsigned(NODE_SIZE), level_end - i);
+      node.leaf = false;
+      node.bounds = nodes[i].bounds;
+      for (unsigned j = 1; j < node.count; ++j)
+        node.bounds.Merge(nodes[i + j].bounds);
+
+      nodes.push_back(node);
+    }
+
+    level_start = level_end;
+    level_end = nodes.size();
+  }
+
+  n_indexed = n;
+}
@@ -0,0 +1,267 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+
+#ifndef XCSOAR_AIRSPACE_RTREE_HPP
+#define XCSOAR_AIRSPACE_RTREE_HPP
+
+#include "Airspace.hpp"
+#include "Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdint.h>
+
+/**
+ * A static R-tree of #Airspace envelopes.  It is bulk-loaded with
+ * the "Sort-Tile-Recursive" algorithm by Optimise(): the envelopes
+ * are sorted into vertical slices, each slice is sorted by latitude,
+ * and cut into leaves of #NODE_SIZE envelopes.  The nodes and the
+ * envelopes are stored in contiguous arrays, without any pointers.
+ *
+ * Envelopes which are added after Optimise() are kept in an overflow
+ * list which is searched linearly until the next Optimise() call.
+ */
+class AirspaceRTree {
+  static constexpr unsigned NODE_SIZE = 16;
+
+  struct Node {
+    FlatBoundingBox bounds;
+
+    /**
+     * The index of the first envelope (if this is a leaf) or the
+     * first child node.
+     */
+    unsigned first;
+
+    uint16_t count;
+
+    bool leaf;
+  };
+
+  /**
+   * All envelopes.  The first #n_indexed ones are sorted in tree
+   * order; the rest is the overflow list.
+   */
+  std::vector<Airspace> items;
+
+  /**
+   * The nodes, bottom-up.  The last one is the root.
+   */
+  std::vector<Node> nodes;
+
+  unsigned n_indexed;
+
+public:
+  typedef std::vector<Airspace>::const_iterator const_iterator;
+
+  AirspaceRTree():n_indexed(0) {}
+
+  const_iterator begin() const {
+    return items.begin();
+  }
+
+  const_iterator end() const {
+    return items.end();
+  }
+
+  size_t size() const {
+    return items.size();
+  }
+
+  bool empty() const {
+    return items.empty();
+  }
+
+  void clear() {
+    items.clear();
+    nodes.clear();
+    n_indexed = 0;
+  }
+
+  /**
+   * Add an envelope to the overflow list.
+   */
+  void insert(const Airspace &airspace) {
+    items.push_back(airspace);
+  }
+
+  /**
+   * Remove the envelopes of the specified airspace.  This moves all
+   * envelopes to the overflow list until the next Optimise() call.
+   *
+   * @return true if an envelope was found
+   */
+  bool erase(const Airspace &airspace);
+
+  /**
+   * Are all envelopes indexed, i.e. is the overflow list empty?
+   */
+  bool IsOptimised() const {
+    return n_indexed == items.size();
+  }
+
+  /**
+   * Rebuild the tree, including the overflow list.
+   */
+  void Optimise();
+
+  /**
+   * Call the visitor for each envelope which overlaps with the
+   * specified box (including the border).
+   */
+  template<typename V>
+  void VisitOverlapping(const FlatBoundingBox &box, V &&visitor) const {
+    if (n_indexed > 0)
+      VisitNode(nodes.back(), box, visitor);
+
+    for (auto i = items.begin() + n_indexed, end = items.end();
+         i != end; ++i)
+      if (i->Overlaps(box))
+        visitor(*i);
+  }
+
+  /**
+   * Call the visitor for each envelope which overlaps with the
+   * specified box, after it has been enlarged by the specified
+   * distance on each side.
+   */
+  template<typename V>
+  void VisitWithinRange(const FlatBoundingBox &box, unsigned range,
+                        V &&visitor) const {
+    FlatBoundingBox query(box);
+    query.Grow(range);
+    VisitOverlapping(query, visitor);
+  }
+
+  /**
+   * Find the nearest envelope (by distance between the boxes) which
+   * matches the predicate.
+   *
+   * @param range the maximum distance
+   * @return nullptr if there is no matching envelope within range
+   */
+  template<typename P>
+  gcc_pure
+  const Airspace *FindNearest(const FlatBoundingBox &box, unsigned range,
+                              P &&predicate) const {
+    const Airspace *nearest = nullptr;
+    uint64_t nearest_distance = (uint64_t)range * range;
+
+    if (n_indexed > 0)
+      FindNearest(nodes.back(), box, predicate, nearest, nearest_distance);
+
+    for (auto i = items.begin() + n_indexed, end = items.end();
+         i != end; ++i)
+      Check(*i, box, predicate, nearest, nearest_distance);
+
+    return nearest;
+  }
+
+private:
+  /**
+   * Calculate the squared distance between two boxes, 0 if they
+   * overlap.
+   */
+  gcc_pure
+  static uint64_t SquareDistance(const FlatBoundingBox &a,
+                                 const FlatBoundingBox &b) {
+    const int64_t dx =
+      std::max(0, std::max(b.GetLowerLeft().longitude -
+                           a.GetUpperRight().longitude,
+                           a.GetLowerLeft().longitude -
+                           b.GetUpperRight().longitude));
+    const int64_t dy =
+      std::max(0, std::max(b.GetLowerLeft().latitude -
+                           a.GetUpperRight().latitude,
+                           a.GetLowerLeft().latitude -
+                           b.GetUpperRight().latitude));
+    return dx * dx + dy * dy;
+  }
+
+  template<typename V>
+  void VisitNode(const Node &node, const FlatBoundingBox &box,
+                 V &visitor) const {
+    if (node.leaf) {
+      for (auto i = items.begin() + node.first,
+             end = i + node.count; i != end; ++i)
+        if (i->Overlaps(box))
+          visitor(*i);
+    } else {
+      for (auto i = nodes.begin() + node.first,
+             end = i + node.count; i != end; ++i)
+        if (i->bounds.Overlaps(box))
+          VisitNode(*i, box, visitor);
+    }
+  }
+
+  template<typename P>
+  static void Check(const Airspace &item, const FlatBoundingBox &box,
+                    P &predicate, const Airspace *&nearest,
+                    uint64_t &nearest_distance) {
+    const uint64_t distance = SquareDistance(item, box);
+    if ((nearest == nullptr ? distance <= nearest_distance
+         : distance < nearest_distance) &&
+        predicate(item)) {
+      nearest = &item;
+      nearest_distance = distance;
+    }
+  }
+
+  template<typename P>
+  void FindNearest(const Node &node, const FlatBoundingBox &box,
+                   P &predicate, const Airspace *&nearest,
+                   uint64_t &nearest_distance) const {
+    if (node.leaf) {
+      for (auto i = items.begin() + node.first,
+             end = i + node.count; i != end; ++i)
+        Check(*i, box, predicate, nearest, nearest_distance);
+      return;
+    }
+
+    /* descend into the closest child first, to shrink the search
+       radius as early as possible */
+    uint64_t distances[NODE_SIZE];
+    for (unsigned i = 0; i < node.count; ++i)
+      distances[i] = SquareDistance(nodes[node.first + i].bounds, box);
+
+    while (true) {
+      unsigned best = NODE_SIZE;
+      for (unsigned i = 0; i < node.count; ++i)
+        if (distances[i] != UINT64_MAX &&
+            (best == NODE_SIZE || distances[i] < distances[best]))
+          best = i;
+
+      if (best == NODE_SIZE ||
+          (nearest == nullptr ? distances[best] > nearest_distance
+           : distances[best] >= nearest_distance))
+        break;
+
+      distances[best] = UINT64_MAX;
+      FindNearest(nodes[node.first + best], box, predicate,
+                  nearest, nearest_distance);
+    }
+  }
+};
+
+#endif
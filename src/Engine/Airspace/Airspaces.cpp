@@ -64,7 +64,7 @@ Airspaces::VisitWithinRange(const GeoPoint &location, fixed range,
   Airspace bb_target(location, task_projection);
   int projected_range = task_projection.ProjectRangeInteger(location, range);
   AirspacePredicateVisitorAdapter adapter(predicate, visitor);
-  airspace_tree.visit_within_range(bb_target, -projected_range, adapter);
+  airspace_tree.VisitWithinRange(bb_target, projected_range, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -105,7 +105,7 @@ Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
   Airspace bb_target(c, task_projection);
   int projected_range = task_projection.ProjectRangeInteger(c, loc.Distance(end) / 2);
   IntersectingAirspaceVisitorAdapter adapter(loc, end, task_projection, visitor);
-  airspace_tree.visit_within_range(bb_target, -projected_range, adapter);
+  airspace_tree.VisitWithinRange(bb_target, projected_range, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -136,11 +136,7 @@ Airspaces::FindNearest(const GeoPoint &location,
   const int projected_range =
     task_projection.ProjectRangeInteger(location, fixed(30000));
   const AirspacePredicateAdapter predicate(condition);
-  std::pair<AirspaceTree::const_iterator, AirspaceTree::distance_type> found =
-    airspace_tree.find_nearest_if(bb_target, BBDist(0, projected_range),
-                                  predicate);
-
-  return found.first != airspace_tree.end() ? &*found.first : nullptr;
+  return airspace_tree.FindNearest(bb_target, projected_range, predicate);
 }
 
 const Airspaces::AirspaceVector
@@ -168,7 +164,7 @@ Airspaces::ScanRange(const GeoPoint &location, fixed range,
       res.push_back(v);
   };
 
-  airspace_tree.visit_within_range(bb_target, -projected_range, visitor);
+  airspace_tree.VisitWithinRange(bb_target, projected_range, visitor);
 
   return res;
 }
@@ -197,7 +193,7 @@ Airspaces::FindInside(const AircraftState &state,
       vectors.push_back(v);
   };
 
-  airspace_tree.visit_within_range(bb_target, 0, visitor);
+  airspace_tree.VisitOverlapping(bb_target, visitor);
 
   return vectors;
 }
@@ -223,7 +219,7 @@ Airspaces::Optimise()
       airspace_tree.insert(as);
       tmp_as.pop_front();
     }
-    airspace_tree.optimise();
+    airspace_tree.Optimise();
   }
 
   ++serial;
@@ -363,17 +359,8 @@ Airspaces::SynchroniseInRange(const Airspaces &master,
   // so delete them --- including the clearances!
   for (auto v = contents_self.begin(); v != contents_self.end();) {
     gcc_unused bool found = false;
-    for (auto t = airspace_tree.begin(); t != airspace_tree.end(); ) {
-      if (&t->GetAirspace() == &v->GetAirspace()) {
-        AirspaceTree::const_iterator new_t = t;
-        ++new_t;
-        airspace_tree.erase_exact(*t);
-        t = new_t;
-        found = true;
-      } else {
-        ++t;
-      }
-    }
+    while (airspace_tree.erase(*v))
+      found = true;
     assert(found);
     v->ClearClearance();
     v = contents_self.erase(v);
@@ -399,5 +386,5 @@ Airspaces::VisitInside(const GeoPoint &loc, AirspaceVisitor &visitor) const
       visitor.Visit(v);
   };
 
-  airspace_tree.visit_within_range(bb_target, 0, visitor2);
+  airspace_tree.VisitOverlapping(bb_target, visitor2);
 }
@@ -38,21 +38,21 @@ class AirspaceVisitor;
 class AirspaceIntersectionVisitor;
 
 /**
- * Container for airspaces using kd-tree representation internally for
- * fast geospatial lookups.
+ * Container for airspaces using a static R-tree (see #AirspaceRTree)
+ * internally for fast geospatial lookups.
  *
- * Complexity analysis (with kdtree):
+ * Complexity analysis (with R-tree):
  *
  *    Find within range (k points found):
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typical
  *
  *    Find intersecting:
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typical
  *
  *    Find nearest:
- *     O(log(n))
+ *     O(log(n)) typical
  *
- *  Without kd-tree:
+ *  Without R-tree:
  *
  *    Find within range:
  *     O(n)
@@ -115,6 +115,14 @@ public:
    */
   void Add(AbstractAirspace *asp);
 
+  /**
+   * Returns the airspaces which have been added since the last
+   * Optimise() call, in the order they were added.
+   */
+  const std::deque<AbstractAirspace *> &GetPending() const {
+    return tmp_as;
+  }
+
   /**
    * Re-organise the internal airspace tree after inserting/deleting.
    * Should be called after inserting/deleting airspaces prior to performing
@@ -94,71 +94,107 @@ ContestManager::SetHandicap(unsigned handicap)
   net_coupe.SetHandicap(handicap);
 }
 
-static bool
-RunContest(AbstractContest &_contest,
-           ContestResult &result, ContestTraceVector &solution,
-           bool exhaustive)
+SolverResult
+ContestManager::SolverJob::Run(bool exhaustive) const
 {
   // run solver, return immediately if further processing is required
   // by subsequent calls
-  SolverResult r = _contest.Solve(exhaustive);
-  if (r != SolverResult::VALID)
-    return false;
+  SolverResult r = solver->Solve(exhaustive);
+  if (r != SolverResult::VALID) {
+    /* the bound narrows while the search proceeds, even if no better
+       solution was found */
+    result->distance_bound = solver->GetBestResult().distance_bound;
+    return r;
+  }
 
   // if no improved solution was found, must have finished processing
   // with invalid data
-  result = _contest.GetBestResult();
+  *result = solver->GetBestResult();
 
   // solver finished and improved solution was found.  save solution
   // and retrieve new trace.
 
-  solution = _contest.GetBestSolution();
+  *solution = solver->GetBestSolution();
 
-  return true;
+  return r;
 }
 
-bool
-ContestManager::UpdateIdle(bool exhaustive)
+static bool
+RunContest(AbstractContest &_contest,
+           ContestResult &result, ContestTraceVector &solution,
+           bool exhaustive)
 {
-  bool retval = false;
+  const ContestManager::SolverJob job{&_contest, &result, &solution};
+  return job.Run(exhaustive) == SolverResult::VALID;
+}
 
+unsigned
+ContestManager::GetIndependentSolvers(SolverJob *jobs)
+{
   switch (contest) {
   case Contest::NONE:
     break;
 
   case Contest::OLC_SPRINT:
-    retval = RunContest(olc_sprint, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
+    jobs[0] = { &olc_sprint, &stats.result[0], &stats.solution[0] };
+    return 1;
 
   case Contest::OLC_FAI:
-    retval = RunContest(olc_fai, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
+    jobs[0] = { &olc_fai, &stats.result[0], &stats.solution[0] };
+    return 1;
 
   case Contest::OLC_CLASSIC:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
+    jobs[0] = { &olc_classic, &stats.result[0], &stats.solution[0] };
+    return 1;
 
   case Contest::OLC_LEAGUE:
-    retval = RunContest(olc_classic, stats.result[1],
-                        stats.solution[1], exhaustive);
+    jobs[0] = { &olc_classic, &stats.result[1], &stats.solution[1] };
+    return 1;
+
+  case Contest::OLC_PLUS:
+    jobs[0] = { &olc_classic, &stats.result[0], &stats.solution[0] };
+    jobs[1] = { &olc_fai, &stats.result[1], &stats.solution[1] };
+    return 2;
+
+  case Contest::DMST:
+    jobs[0] = { &dmst_quad, &stats.result[0], &stats.solution[0] };
+    return 1;
+
+  case Contest::XCONTEST:
+    jobs[0] = { &xcontest_free, &stats.result[0], &stats.solution[0] };
+    jobs[1] = { &xcontest_triangle, &stats.result[1], &stats.solution[1] };
+    return 2;
+
+  case Contest::DHV_XC:
+    jobs[0] = { &dhv_xc_free, &stats.result[0], &stats.solution[0] };
+    jobs[1] = { &dhv_xc_triangle, &stats.result[1], &stats.solution[1] };
+    return 2;
+
+  case Contest::SIS_AT:
+    jobs[0] = { &sis_at, &stats.result[0], &stats.solution[0] };
+    return 1;
+
+  case Contest::NET_COUPE:
+    jobs[0] = { &net_coupe, &stats.result[0], &stats.solution[0] };
+    return 1;
+  };
+
+  return 0;
+}
 
+bool
+ContestManager::UpdateDependent(bool changed, bool exhaustive)
+{
+  switch (contest) {
+  case Contest::OLC_LEAGUE:
     olc_league.Feed(stats.solution[1]);
 
-    retval |= RunContest(olc_league, stats.result[0],
-                         stats.solution[0], exhaustive);
+    changed |= RunContest(olc_league, stats.result[0],
+                          stats.solution[0], exhaustive);
     break;
 
   case Contest::OLC_PLUS:
-    retval = RunContest(olc_classic, stats.result[0],
-                        stats.solution[0], exhaustive);
-
-    retval |= RunContest(olc_fai, stats.result[1],
-                         stats.solution[1], exhaustive);
-
-    if (retval) {
+    if (changed) {
       olc_plus.Feed(stats.result[0], stats.solution[0],
                     stats.result[1], stats.solution[1]);
 
@@ -168,38 +204,25 @@ ContestManager::UpdateIdle(bool exhaustive)
 
     break;
 
-  case Contest::DMST:
-    retval = RunContest(dmst_quad, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
-
-  case Contest::XCONTEST:
-    retval = RunContest(xcontest_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(xcontest_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
-    break;
-
-  case Contest::DHV_XC:
-    retval = RunContest(dhv_xc_free, stats.result[0],
-                        stats.solution[0], exhaustive);
-    retval |= RunContest(dhv_xc_triangle, stats.result[1],
-                         stats.solution[1], exhaustive);
+  default:
     break;
+  }
 
-  case Contest::SIS_AT:
-    retval = RunContest(sis_at, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
+  return changed;
+}
 
-  case Contest::NET_COUPE:
-    retval = RunContest(net_coupe, stats.result[0],
-                        stats.solution[0], exhaustive);
-    break;
+bool
+ContestManager::UpdateIdle(bool exhaustive)
+{
+  SolverJob jobs[MAX_INDEPENDENT_SOLVERS];
+  const unsigned n = GetIndependentSolvers(jobs);
 
-  };
+  bool retval = false;
+  for (unsigned i = 0; i < n; ++i)
+    if (jobs[i].Run(exhaustive) == SolverResult::VALID)
+      retval = true;
 
-  return retval;
+  return UpdateDependent(retval, exhaustive);
 }
 
 void
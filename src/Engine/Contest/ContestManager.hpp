@@ -63,6 +63,29 @@ class ContestManager
   NetCoupe net_coupe;
 
 public:
+  /**
+   * One solver of the selected contest which does not depend on the
+   * results of the other solvers.  Different jobs use different
+   * solver objects and result slots, and may therefore run
+   * concurrently.
+   */
+  struct SolverJob {
+    AbstractContest *solver;
+    ContestResult *result;
+    ContestTraceVector *solution;
+
+    /**
+     * Run the solver once, and copy an improved solution to the
+     * result slot.
+     */
+    SolverResult Run(bool exhaustive) const;
+  };
+
+  /**
+   * The maximum number of jobs returned by GetIndependentSolvers().
+   */
+  static constexpr unsigned MAX_INDEPENDENT_SOLVERS = 2;
+
   /**
    * Base constructor.
    *
@@ -106,6 +129,27 @@ public:
    */
   bool UpdateIdle(bool exhaustive = false);
 
+  /**
+   * Obtain the solvers of the selected contest which may be run
+   * independently (first stage of UpdateIdle()).  While they run,
+   * no other method of this object may be called.
+   *
+   * @param jobs an array of at least #MAX_INDEPENDENT_SOLVERS
+   * elements
+   * @return the number of jobs
+   */
+  unsigned GetIndependentSolvers(SolverJob *jobs);
+
+  /**
+   * Run the solvers which are fed with the results of the
+   * independent solvers (second stage of UpdateIdle()).
+   *
+   * @param changed true if one of the independent solvers has found
+   * an improved solution
+   * @return True if internal state changed
+   */
+  bool UpdateDependent(bool changed, bool exhaustive);
+
   bool SolveExhaustive() {
     return UpdateIdle(true);
   }
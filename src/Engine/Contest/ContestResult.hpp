@@ -36,10 +36,20 @@ struct ContestResult
   /** Time (s) of optimised OLC path */
   fixed time;
 
+  /**
+   * Approximate upper bound (m) for the distance the solver may
+   * still find in the current trace.  It is larger than #distance
+   * while an incremental search is suspended, equals #distance after
+   * the search has finished, and is zero if the solver does not
+   * provide a bound.
+   */
+  fixed distance_bound;
+
   void Reset() {
     score = fixed(0);
     distance = fixed(0);
     time = fixed(0);
+    distance_bound = fixed(0);
   }
 
   bool IsDefined() const {
@@ -52,6 +52,7 @@ AbstractContest::SaveSolution()
     return false;
 
   best_result = result;
+  best_result.distance_bound = fixed(0);
   CopySolution(best_solution);
   return true;
 }
@@ -133,6 +133,14 @@ protected:
    */
   bool SaveSolution();
 
+  /**
+   * Publish an upper bound for the distance which may still be
+   * found, see ContestResult::distance_bound.
+   */
+  void SetDistanceBound(fixed bound) {
+    best_result.distance_bound = bound;
+  }
+
   /**
    * Apply handicap.
    *
@@ -65,6 +65,7 @@ OLCTriangle::OLCTriangle(const Trace &_trace,
    is_fai(_is_fai), predict(_predict),
    is_closed(false),
    is_complete(false),
+   running(false), n_searched(0),
    max_iterations(1e6),
    max_tree_size(5e5)
 {
@@ -92,9 +93,32 @@ void
 OLCTriangle::ResetBranchAndBound()
 {
   running = false;
+  n_searched = 0;
   branch_and_bound.clear();
 }
 
+void
+OLCTriangle::ExtendBranchAndBound(unsigned old_size)
+{
+  assert(old_size > 0);
+  assert(old_size < n_points);
+
+  const unsigned large_triangle_check =
+    trace_master.ProjectRange(GetPoint(0).GetLocation(), fixed(500000)) * 0.99;
+
+  /* the existing search tree covers all triangles within
+     [0, old_size); this candidate set covers those with the third
+     turn point in the new range */
+  CandidateSet candidates(TurnPointRange(this, 0, n_points),
+                          TurnPointRange(this, 0, n_points),
+                          TurnPointRange(this, old_size, n_points));
+  if (candidates.isFeasible(is_fai, large_triangle_check) &&
+      candidates.df_max >= best_d) {
+    branch_and_bound.insert(std::pair<unsigned, CandidateSet>(candidates.df_max, candidates));
+    running = true;
+  }
+}
+
 gcc_pure
 static fixed
 CalcLegDistance(const ContestTraceVector &solution, const unsigned index)
@@ -114,7 +138,18 @@ OLCTriangle::UpdateTrace(bool force)
 {
   if (IsMasterAppended()) return; /* unmodified */
 
-  if (force || IsMasterUpdated(false)) {
+  if (IsResumable() && !force && n_points > 0 && !CheckMasterSerial()) {
+    /* points were appended; SolveTriangle() will add them to the
+       search tree */
+    const unsigned old_size = n_points;
+    if (UpdateTraceTail()) {
+      is_complete = false;
+      is_closed = FindClosingPairs(old_size);
+    }
+  } else if (force || IsMasterUpdated(false)) {
+    /* the indices in the search tree refer to the old trace */
+    ResetBranchAndBound();
+
     UpdateTraceFull();
 
     is_complete = false;
@@ -152,8 +187,14 @@ OLCTriangle::Solve(bool exhaustive)
     return SolverResult::FAILED;
   }
 
-  if (!running) {
-    // branch and bound is currently in finished state, update trace
+  if (running && CheckMasterSerial())
+    /* the trace was thinned or cleared; the search tree refers to
+       points which do not exist anymore */
+    ResetBranchAndBound();
+
+  if (!running || IsResumable()) {
+    // branch and bound is currently in finished state (or can be
+    // extended with new points), update trace
     UpdateTrace(exhaustive);
   }
 
@@ -166,8 +207,13 @@ OLCTriangle::Solve(bool exhaustive)
     if (is_closed)
       SolveTriangle(exhaustive);
 
-    if (!SaveSolution())
-      return SolverResult::FAILED;
+    const bool improved = SaveSolution();
+    SetDistanceBound(CalculateDistanceBound());
+
+    if (!improved)
+      return running
+        ? SolverResult::INCOMPLETE
+        : SolverResult::FAILED;
 
     return SolverResult::VALID;
   } else {
@@ -183,6 +229,7 @@ OLCTriangle::SolveTriangle(bool exhaustive)
            tp3 = 0,
            start = 0,
            finish = 0;
+  bool found = false;
 
   if (exhaustive || !predict) {
     ClosingPairs relaxed_pairs;
@@ -236,6 +283,7 @@ OLCTriangle::SolveTriangle(bool exhaustive)
           finish = unrelaxed.second;
 
           best_d = std::get<3>(triangle);
+          found = true;
         } else {
           // otherwise we should solve the triangle again for every unrelaxed pair
           // contained inside the current relaxed pair. *damn!*
@@ -265,6 +313,7 @@ OLCTriangle::SolveTriangle(bool exhaustive)
         finish = close_look_pair.second;
 
         best_d = std::get<3>(triangle);
+        found = true;
       }
     }
 
@@ -274,24 +323,37 @@ OLCTriangle::SolveTriangle(bool exhaustive)
      * one closing pair only (0 -> n_points-1) which allows us to suspend the
      * solver...
      */
-    std::tuple<unsigned, unsigned, unsigned, unsigned> triangle;
+    if (n_searched > 0 && n_searched < n_points)
+      /* points were appended since the search was started: extend
+         the search tree instead of starting from scratch */
+      ExtendBranchAndBound(n_searched);
 
-    triangle = RunBranchAndBound(0, n_points - 1, best_d, false);
+    /* if the whole trace has already been searched and there are no
+       new points, there is nothing to do */
+    const bool run = n_searched == 0 || running;
+    n_searched = n_points;
 
-    if (std::get<3>(triangle) > best_d) {
-      // solution is better than best_d
+    if (run) {
+      std::tuple<unsigned, unsigned, unsigned, unsigned> triangle;
 
-      start = 0;
-      tp1 = std::get<0>(triangle);
-      tp2 = std::get<1>(triangle);
-      tp3 = std::get<2>(triangle);
-      finish = n_points - 1;
+      triangle = RunBranchAndBound(0, n_points - 1, best_d, false);
 
-      best_d = std::get<3>(triangle);
+      if (std::get<3>(triangle) > best_d) {
+        // solution is better than best_d
+
+        start = 0;
+        tp1 = std::get<0>(triangle);
+        tp2 = std::get<1>(triangle);
+        tp3 = std::get<2>(triangle);
+        finish = n_points - 1;
+
+        best_d = std::get<3>(triangle);
+        found = true;
+      }
     }
   }
 
-  if (best_d > 0) {
+  if (found) {
     solution.resize(5);
 
     solution[0] = TraceManager::GetPoint(start);
@@ -300,6 +362,16 @@ OLCTriangle::SolveTriangle(bool exhaustive)
     solution[3] = TraceManager::GetPoint(tp3);
     solution[4] = TraceManager::GetPoint(finish);
 
+    is_complete = true;
+  } else if (best_d > 0 && !is_complete) {
+    /* no better triangle was found; the previous solution remains
+       valid */
+    assert(solution.size() == 5);
+
+    if (predict && !exhaustive)
+      /* the predicted finish is the end of the trace */
+      solution[4] = TraceManager::GetPoint(n_points - 1);
+
     is_complete = true;
   }
 }
@@ -321,7 +393,7 @@ OLCTriangle::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d, boo
   const unsigned fastskiprange_flat =
     trace_master.ProjectRange(GetPoint(from).GetLocation(), fixed(fastskiprange));
 
-  if (fastskiprange_flat < worst_d)
+  if (!running && fastskiprange_flat < worst_d)
     return std::tuple<unsigned, unsigned, unsigned, unsigned>(0, 0, 0, 0);
 
   bool integral_feasible = false;
@@ -482,6 +554,25 @@ OLCTriangle::RunBranchAndBound(unsigned from, unsigned to, unsigned worst_d, boo
   }
 }
 
+fixed
+OLCTriangle::CalculateDistanceBound() const
+{
+  const fixed distance = GetBestResult().distance;
+
+  if (running && predict && !branch_and_bound.empty()) {
+    /* the search is suspended; no triangle left in the tree can be
+       larger than the largest node's bound */
+    const unsigned bound = std::max(best_d,
+                                    branch_and_bound.rbegin()->first);
+    return std::max(distance,
+                    bound * trace_master.GetProjection().GetApproximateScale());
+  }
+
+  return running
+    ? fixed(0)
+    : distance;
+}
+
 ContestResult
 OLCTriangle::CalculateResult() const
 {
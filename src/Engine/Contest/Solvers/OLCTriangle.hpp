@@ -79,6 +79,15 @@ private:
    */
   bool running;
 
+  /**
+   * The number of trace points covered by the branch and bound
+   * search in predictive, non-exhaustive mode.  Points appended to
+   * the trace after that are added to the running search (see
+   * ExtendBranchAndBound()) instead of restarting it.  Zero if no
+   * search was started since the last reset.
+   */
+  unsigned n_searched;
+
   /**
    * Number of iterations per tick (only for non-exhaustive,
    * predictive runs)
@@ -386,9 +395,32 @@ protected:
   std::tuple<unsigned, unsigned, unsigned, unsigned>
   RunBranchAndBound(unsigned from, unsigned to, unsigned best_d, bool exhaustive);
 
+  /**
+   * Add the triangles which have at least one turn point in the
+   * range [old_size, n_points) to the search tree.
+   */
+  void ExtendBranchAndBound(unsigned old_size);
+
   void UpdateTrace(bool force);
   void ResetBranchAndBound();
 
+  /**
+   * Calculate the bound for ContestResult::distance_bound: the
+   * largest node bound in the suspended search tree (converted from
+   * the flat projection, i.e. approximate), or the distance of the
+   * best triangle after the search has finished.
+   */
+  gcc_pure
+  fixed CalculateDistanceBound() const;
+
+  /**
+   * Is this solver in predictive, incremental mode, where the search
+   * is resumed across calls and across trace updates?
+   */
+  bool IsResumable() const {
+    return predict && incremental;
+  }
+
 public:
   /* virtual methods from AbstractContest */
   virtual void Reset() override;
@@ -61,7 +61,7 @@ SolverResult
 XContestTriangle::Solve(bool exhaustive)
 {
   SolverResult result = OLCTriangle::Solve(exhaustive);
-  if (result != SolverResult::FAILED)
+  if (result == SolverResult::VALID)
     best_d = 0; // reset heuristic
 
   return result;
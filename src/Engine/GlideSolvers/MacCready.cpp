@@ -69,6 +69,7 @@ MacCready::SolveVertical(const GlideState &task) const
     result.height_climb = fixed(0);
     result.height_glide = fixed(0);
     result.time_elapsed = fixed(0);
+    result.time_virtual = fixed(0);
     result.validity = GlideResult::Validity::OK;
     return result;
   }
@@ -293,6 +294,96 @@ MacCready::SolveStraight(const GlideState &task) const
   return SolveGlide(task, glide_polar.GetVBestLD());
 }
 
+void
+MacCready::SolveStraight(const unsigned n, const GeoVector *vectors,
+                         const fixed *min_arrival_altitudes,
+                         const fixed altitude, const SpeedVector wind,
+                         GlideResult *results) const
+{
+  if (!glide_polar.IsValid() || !positive(glide_polar.GetMC())) {
+    /* nothing to share: OptimiseGlide() searches the best speed for
+       each destination */
+    for (unsigned i = 0; i < n; ++i)
+      results[i] = SolveStraight(GlideState(vectors[i],
+                                            min_arrival_altitudes[i],
+                                            altitude, wind));
+    return;
+  }
+
+  /* the terms shared by all destinations (see SolveGlide() and
+     GlideState::CalcAverageSpeed()) */
+  const fixed v = glide_polar.GetVBestLD();
+  const fixed sink_rate = glide_polar.SinkRate(v);
+  const fixed v_eff = v * cruise_efficiency;
+  const fixed inv_mc = glide_polar.GetInvMC();
+  const bool has_wind = wind.IsNonZero();
+  const fixed c4 = Quadruple(sqr(wind.norm) - sqr(v_eff));
+
+  static constexpr unsigned CHUNK_SIZE = 64;
+  fixed speeds[CHUNK_SIZE], times[CHUNK_SIZE], heights[CHUNK_SIZE];
+
+  for (unsigned offset = 0; offset < n; offset += CHUNK_SIZE) {
+    const unsigned chunk_size = std::min(n - offset, CHUNK_SIZE);
+    const GeoVector *const chunk_vectors = vectors + offset;
+    GlideResult *const chunk_results = results + offset;
+
+    /* initialise the results; this calculates the head wind
+       component, which needs a cosine per destination */
+    for (unsigned i = 0; i < chunk_size; ++i) {
+      const GlideState task(chunk_vectors[i],
+                            min_arrival_altitudes[offset + i],
+                            altitude, wind);
+      chunk_results[i] = GlideResult(task, v);
+    }
+
+    /* the ground speed; see AverageSpeedSolver */
+    if (has_wind) {
+      for (unsigned i = 0; i < chunk_size; ++i) {
+        const fixed b = Double(chunk_results[i].head_wind);
+        const fixed denom = sqr(b) - c4;
+        const fixed root = sqrt(std::max(denom, fixed(0)));
+        speeds[i] = negative(denom) ? fixed(-1) : (-b + root) / fixed(2);
+      }
+    } else
+      std::fill_n(speeds, chunk_size, v_eff);
+
+    for (unsigned i = 0; i < chunk_size; ++i) {
+      times[i] = chunk_vectors[i].distance / speeds[i];
+      heights[i] = times[i] * sink_rate;
+    }
+
+    for (unsigned i = 0; i < chunk_size; ++i) {
+      GlideResult &result = chunk_results[i];
+
+      if (!positive(chunk_vectors[i].distance)) {
+        /* rare; fall back to the single solver */
+        result = SolveVertical(GlideState(chunk_vectors[i],
+                                          min_arrival_altitudes[offset + i],
+                                          altitude, wind));
+        continue;
+      }
+
+      if (!positive(speeds[i])) {
+        result.validity = GlideResult::Validity::WIND_EXCESSIVE;
+        result.vector.distance = fixed(0);
+        continue;
+      }
+
+      const fixed height_glide = heights[i];
+      result.validity = GlideResult::Validity::OK;
+      result.time_elapsed = times[i];
+      result.height_climb = fixed(0);
+      result.height_glide = height_glide;
+      result.pure_glide_height = height_glide;
+      result.altitude_difference -= height_glide;
+      result.pure_glide_altitude_difference -= height_glide;
+      result.time_virtual = positive(inv_mc)
+        ? height_glide * inv_mc
+        : fixed(0);
+    }
+  }
+}
+
 GlideResult
 MacCready::Solve(const GlideState &task) const
 {
@@ -28,6 +28,8 @@
 struct GlideSettings;
 struct GlideState;
 struct GlideResult;
+struct GeoVector;
+struct SpeedVector;
 class GlidePolar;
 
 /**
@@ -88,6 +90,27 @@ public:
   gcc_pure
   GlideResult SolveStraight(const GlideState &task) const;
 
+  /**
+   * Like SolveStraight(), but solve the glides to many destinations
+   * at once, which share the aircraft altitude and the wind.  The
+   * results are the same, but the terms which depend only on the
+   * polar, the MacCready setting and the wind are calculated only
+   * once, and the per-destination arithmetic runs in loops over
+   * plain arrays which the compiler can vectorise.
+   *
+   * @param n the number of destinations
+   * @param vectors the vectors from the aircraft to the destinations
+   * @param min_arrival_altitudes the minimum arrival altitude of each
+   * destination
+   * @param altitude the aircraft altitude
+   * @param wind the wind
+   * @param results an array of n elements receiving the results
+   */
+  void SolveStraight(unsigned n, const GeoVector *vectors,
+                     const fixed *min_arrival_altitudes,
+                     fixed altitude, const SpeedVector wind,
+                     GlideResult *results) const;
+
   /** 
    * Calculates the glide solution for a classical MacCready theory task.
    * Internally different calculations are used depending on the nature of the
@@ -52,14 +52,20 @@ public:
   typedef typename EdgeMap::const_iterator edge_const_iterator;
 
 private:
+  typedef typename EdgeMap::value_type EdgeItem;
+
   struct Value
   {
     unsigned edge_value;
 
-    edge_iterator iterator;
+    /**
+     * Points to the element of #edges.  Unlike an iterator, this
+     * pointer remains valid when a hash map gets rehashed.
+     */
+    EdgeItem *item;
 
-    Value(unsigned _edge_value, edge_iterator _iterator)
-      :edge_value(_edge_value), iterator(_iterator) {}
+    Value(unsigned _edge_value, EdgeItem &_item)
+      :edge_value(_edge_value), item(&_item) {}
   };
 
   struct Rank : public std::binary_function<Value, Value, bool> {
@@ -150,14 +156,14 @@ public:
    * @return Node for processing
    */
   Node Pop() {
-    edge_const_iterator cur(q.top().iterator);
-    current_value = cur->second.value;
+    const EdgeItem &cur = *q.top().item;
+    current_value = cur.second.value;
 
     do {
       q.pop();
-    } while (!q.empty() && q.top().iterator->second.value < q.top().edge_value);
+    } while (!q.empty() && q.top().item->second.value < q.top().edge_value);
 
-    return cur->first;
+    return cur.first;
   }
 
   /**
@@ -208,7 +214,7 @@ public:
     // Clear the search queue
     q.clear();
 
-    for (const auto &i : edges)
+    for (auto &i : edges)
       q.push(Value(i.second.value, i));
   }
 
@@ -238,7 +244,7 @@ private:
       // -> Don't use this new leg
       return false;
 
-    q.push(Value(edge_value, it));
+    q.push(Value(edge_value, *it));
     return true;
   }
 };
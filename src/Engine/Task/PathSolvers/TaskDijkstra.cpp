@@ -26,65 +26,121 @@
 #include <algorithm>
 
 TaskDijkstra::TaskDijkstra(bool _is_min)
-  :NavDijkstra(0),
-   is_min(_is_min)
+  :is_min(_is_min), num_stages(0), n_valid(0)
 {
 }
 
-inline unsigned
-TaskDijkstra::GetStageSize(const unsigned stage) const
+bool
+TaskDijkstra::Stage::IsModified(const SearchPointVector &boundary) const
 {
-  assert(stage < num_stages);
-
-  return boundaries[stage]->size();
+  return locations.size() != boundary.size() ||
+    !std::equal(locations.begin(), locations.end(), boundary.begin(),
+                [](const GeoPoint &a, const SearchPoint &b) {
+                  return a == b.GetLocation();
+                });
 }
 
 const SearchPoint &
-TaskDijkstra::GetPoint(const ScanTaskPoint sp) const
-{
-  return (*boundaries[sp.GetStageNumber()])[sp.GetPointIndex()];
-}
-
-void
-TaskDijkstra::AddEdges(const ScanTaskPoint curNode)
+TaskDijkstra::GetPoint(unsigned stage, unsigned index) const
 {
-  ScanTaskPoint destination(curNode.GetStageNumber() + 1, 0);
-  const unsigned dsize = GetStageSize(destination.GetStageNumber());
-
-  for (const ScanTaskPoint end(destination.GetStageNumber(), dsize);
-       destination != end; destination.IncrementPointIndex())
-    Link(destination, curNode, CalcDistance(curNode, destination));
+  return (*boundaries[stage])[index];
 }
 
 void
-TaskDijkstra::AddZeroStartEdges()
+TaskDijkstra::UpdateStage(unsigned stage)
 {
-  const unsigned stage = 0;
-  ScanTaskPoint destination(stage, 0);
-  const unsigned dsize = GetStageSize(stage);
+  assert(stage < num_stages);
 
-  for (const ScanTaskPoint end(stage, dsize);
-       destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, 0);
+  const SearchPointVector &boundary = *boundaries[stage];
+  Stage &s = stages[stage];
+
+  s.locations.clear();
+  for (const SearchPoint &sp : boundary)
+    s.locations.push_back(sp.GetLocation());
+
+  s.nodes.resize(boundary.size());
+
+  if (stage + 1 == num_stages) {
+    /* the finish */
+    for (Node &node : s.nodes) {
+      node.distance = 0;
+      node.next = 0;
+    }
+
+    return;
+  }
+
+  const SearchPointVector &next_boundary = *boundaries[stage + 1];
+  const std::vector<Node> &next_nodes = stages[stage + 1].nodes;
+  assert(next_nodes.size() == next_boundary.size());
+  assert(!next_nodes.empty());
+
+  for (unsigned i = 0, n = boundary.size(); i < n; ++i) {
+    Node &node = s.nodes[i];
+    node.next = 0;
+    node.distance = CalcDistance(boundary[i], next_boundary[0]) +
+      next_nodes[0].distance;
+
+    for (unsigned j = 1, m = next_boundary.size(); j < m; ++j) {
+      const unsigned distance = CalcDistance(boundary[i], next_boundary[j]) +
+        next_nodes[j].distance;
+      if (IsBetter(distance, node.distance)) {
+        node.distance = distance;
+        node.next = j;
+      }
+    }
+  }
 }
 
-void 
-TaskDijkstra::AddStartEdges(unsigned stage, const SearchPoint &currentLocation)
+bool
+TaskDijkstra::Update()
 {
-  assert(currentLocation.IsValid());
-
-  ScanTaskPoint destination(stage, 0);
-  const unsigned dsize = GetStageSize(stage);
-
-  for (const ScanTaskPoint end(stage, dsize);
-       destination != end; destination.IncrementPointIndex())
-    LinkStart(destination, CalcDistance(destination, currentLocation));
+  if (num_stages == 0)
+    return false;
+
+  for (unsigned i = 0; i < num_stages; ++i)
+    if (boundaries[i]->empty())
+      return false;
+
+  /* skip the unmodified stages at the end; their sub-paths can be
+     reused */
+  const unsigned first_valid = num_stages - n_valid;
+  unsigned stage = num_stages;
+  while (stage > first_valid &&
+         !stages[stage - 1].IsModified(*boundaries[stage - 1]))
+    --stage;
+
+  /* recalculate the last modified stage and all stages before it */
+  n_valid = num_stages - stage;
+  while (stage > 0) {
+    UpdateStage(--stage);
+    ++n_valid;
+  }
+
+  return true;
 }
 
-bool
-TaskDijkstra::Run()
+void
+TaskDijkstra::Solve(const SearchPoint &location)
 {
-  const bool retval = DistanceGeneral() == SolverResult::VALID;
-  dijkstra.Clear();
-  return retval;
+  assert(n_valid == num_stages);
+
+  const SearchPointVector &boundary = *boundaries[0];
+  const std::vector<Node> &nodes = stages[0].nodes;
+
+  unsigned best = 0, best_distance = 0;
+  for (unsigned i = 0, n = nodes.size(); i < n; ++i) {
+    unsigned distance = nodes[i].distance;
+    if (location.IsValid())
+      distance += CalcDistance(boundary[i], location);
+
+    if (i == 0 || IsBetter(distance, best_distance)) {
+      best = i;
+      best_distance = distance;
+    }
+  }
+
+  solution[0] = best;
+  for (unsigned i = 1; i < num_stages; ++i)
+    solution[i] = stages[i - 1].nodes[solution[i - 1]].next;
 }
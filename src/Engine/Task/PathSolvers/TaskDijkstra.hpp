@@ -23,21 +23,19 @@
 #ifndef TASK_DIJKSTRA_HPP
 #define TASK_DIJKSTRA_HPP
 
-#include "PathSolvers/NavDijkstra.hpp"
 #include "Geo/SearchPoint.hpp"
+#include "Compiler.h"
+
+#include <vector>
 
 #include <assert.h>
 
-class OrderedTask;
 class SearchPointVector;
 
 /**
  * Class used to scan an OrderedTask for maximum/minimum distance
  * points.
  *
- * Uses flat-projected integer representation of search points for
- * speed, but this also makes the system approximate.
- *
  * Search points are located on OZ boundaries and each form a convex
  * hull, as this produces the minimum search vector size without loss
  * of accuracy.
@@ -49,14 +47,75 @@ class SearchPointVector;
  * Before each calculation, set up this object with SetTaskSize() and
  * call SetBoundary() for each task point.
  *
- * This uses a Dijkstra search and so is O(N log(N)).
+ * The search graph is layered (edges lead only from one task point
+ * to the next one), therefore the shortest/longest path is found by
+ * walking the task points backwards, determining for each search
+ * point the best sub-path to the finish.  These sub-paths are kept
+ * between calculations, and only the task points whose boundary (or
+ * whose successors' boundaries) have changed are recalculated.  The
+ * aircraft location only affects the first leg.
  */
-class TaskDijkstra : protected NavDijkstra
+class TaskDijkstra
 {
-  const SearchPointVector *boundaries[MAX_STAGES];
+public:
+  static constexpr unsigned MAX_STAGES = 32;
+
+private:
+  /**
+   * The best sub-path from one search point to the finish.
+   */
+  struct Node {
+    /**
+     * The distance [m] to the finish.
+     */
+    unsigned distance;
+
+    /**
+     * The index of the next search point on this sub-path.
+     */
+    unsigned next;
+  };
+
+  /**
+   * The cached calculation of one task point.
+   */
+  struct Stage {
+    /**
+     * The locations of the boundary which #nodes was calculated
+     * for.
+     */
+    std::vector<GeoPoint> locations;
+
+    std::vector<Node> nodes;
+
+    /**
+     * Does #locations differ from this boundary?
+     */
+    gcc_pure
+    bool IsModified(const SearchPointVector &boundary) const;
+  };
 
   const bool is_min;
 
+  unsigned num_stages;
+
+  const SearchPointVector *boundaries[MAX_STAGES];
+
+  Stage stages[MAX_STAGES];
+
+  /**
+   * The number of stages at the end of the task whose #Stage::nodes
+   * are up to date with the boundaries passed to SetBoundary().
+   * Sub-paths depend on all following stages, therefore a modified
+   * stage invalidates all stages before it.
+   */
+  unsigned n_valid;
+
+  /**
+   * The point index for each of the solution's stages.
+   */
+  unsigned solution[MAX_STAGES];
+
 public:
   /**
    * Constructor
@@ -66,7 +125,13 @@ public:
   TaskDijkstra(const bool is_min);
 
   void SetTaskSize(unsigned size) {
-    SetStageCount(size);
+    assert(size <= MAX_STAGES);
+
+    if (size != num_stages) {
+      /* the stages would be shifted; start from scratch */
+      num_stages = size;
+      n_valid = 0;
+    }
   }
 
   void SetBoundary(unsigned idx, const SearchPointVector &boundary) {
@@ -82,74 +147,55 @@ public:
   const SearchPoint &GetSolution(unsigned stage) const {
     assert(stage < num_stages);
 
-    return GetPoint(ScanTaskPoint(stage, solution[stage]));
+    return GetPoint(stage, solution[stage]);
   }
 
 protected:
   gcc_pure
-  const SearchPoint &GetPoint(ScanTaskPoint sp) const;
-
-  bool Run();
+  const SearchPoint &GetPoint(unsigned stage, unsigned index) const;
 
-  bool Link(const ScanTaskPoint node, const ScanTaskPoint parent,
-            unsigned value) {
-    if (!is_min)
-      value = DIJKSTRA_MINMAX_OFFSET - value;
+  /**
+   * Bring the sub-paths of all stages up to date.
+   *
+   * @return false if there is no solution (a boundary is empty)
+   */
+  bool Update();
 
-    return NavDijkstra::Link(node, parent, value);
-  }
+  /**
+   * Choose the best point of the first stage and follow its
+   * sub-path to fill the #solution array.  Call Update() first.
+   *
+   * @param location the aircraft location; the distance to it is
+   * added to the sub-paths of the first stage (if it is valid)
+   */
+  void Solve(const SearchPoint &location);
 
+private:
   /**
-   * Add a zero-length start edge to each point in the first stage.
+   * Calculate the sub-paths of the specified stage, assuming the
+   * following stage is up to date.
    */
-  void AddZeroStartEdges();
+  void UpdateStage(unsigned stage);
 
   /**
-   * Add a start edge from the given location to each point in the
-   * given stage.
+   * Is "a" better than "b"?
    */
-  void AddStartEdges(unsigned stage, const SearchPoint &loc);
+  bool IsBetter(unsigned a, unsigned b) const {
+    return is_min ? a < b : a > b;
+  }
 
   /** 
-   * Distance function for free point
-   * 
-   * @param curNode Destination node
-   * @param currentLocation Origin location
+   * Distance function
    * 
    * @return Distance (flat) from origin to destination
    */
   gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint curNode,
-                        const SearchPoint &currentLocation) const {
+  static unsigned CalcDistance(const SearchPoint &a, const SearchPoint &b) {
     /* using expensive floating point formulas here to avoid integer
        rounding errors */
 
-    const GeoPoint &a = GetPoint(curNode).GetLocation();
-    const GeoPoint &b = currentLocation.GetLocation();
-
-    return (unsigned)a.Distance(b);
+    return (unsigned)a.GetLocation().Distance(b.GetLocation());
   }
-
-  /** 
-   * Distance function for edges
-   * 
-   * @param s1 Origin node
-   * @param s2 Destination node
-   * 
-   * @return Distance (flat) from origin to destination
-   */
-  gcc_pure
-  unsigned CalcDistance(const ScanTaskPoint s1, const ScanTaskPoint s2) const {
-    return CalcDistance(s1, GetPoint(s2));
-  }
-
-private:
-  gcc_pure
-  unsigned GetStageSize(const unsigned stage) const;
-
-protected:
-  /* methods from NavDijkstra */
-  virtual void AddEdges(ScanTaskPoint curNode) final;
 };
 
 #endif
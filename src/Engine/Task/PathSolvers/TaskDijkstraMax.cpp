@@ -25,8 +25,9 @@
 bool
 TaskDijkstraMax::DistanceMax()
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
-  AddZeroStartEdges();
-  return Run();
+  if (!Update())
+    return false;
+
+  Solve(SearchPoint::Invalid());
+  return true;
 }
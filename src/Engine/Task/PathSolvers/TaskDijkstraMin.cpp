@@ -25,15 +25,9 @@
 bool
 TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation)
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
+  if (!Update())
+    return false;
 
-  if (currentLocation.IsValid()) {
-    AddStartEdges(0, currentLocation);
-  } else {
-    AddZeroStartEdges();
-  }
-
-  return Run();
+  Solve(currentLocation);
+  return true;
 }
-
@@ -22,29 +22,40 @@
 
 #include "AbortTask.hpp"
 #include "AbortIntersectionTest.hpp"
-#include "AlternateList.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
-#include "Task/Solvers/TaskSolution.hpp"
+#include "GlideSolvers/GlideState.hpp"
+#include "GlideSolvers/MacCready.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Waypoint/WaypointVisitor.hpp"
 #include "Util/ReservablePriorityQueue.hpp"
 #include "Util/Clamp.hpp"
 
+#include <algorithm>
+
 /** min search range in m */
 static constexpr fixed min_search_range = fixed(50000);
 
 /** max search range in m */
 static constexpr fixed max_search_range = fixed(100000);
 
+/**
+ * Additional range of the waypoint query in m; the aircraft may fly
+ * this far before the query needs to be repeated.
+ */
+static constexpr fixed cache_margin = fixed(5000);
+
 AbortTask::AbortTask(const TaskBehaviour &_task_behaviour,
                      const Waypoints &wps)
   :UnorderedTask(TaskType::ABORT, _task_behaviour),
    waypoints(wps),
    intersection_test(NULL),
-   active_waypoint(0)
+   active_waypoint(0),
+   pruning(true)
 {
   task_points.reserve(32);
+  candidates.reserve(128);
+  cache_location.SetInvalid();
 }
 
 void
@@ -115,14 +126,38 @@ AbortTask::IsTaskFull() const
   return task_points.size() >= max_abort;
 }
 
-/** Function object used to rank waypoints by arrival time */
-struct AbortRank
-  : public std::binary_function<AlternatePoint, AlternatePoint, bool>
+/**
+ * Returns the time [s] which the glide solution is ranked by.
+ */
+gcc_pure
+static fixed
+GetRankTime(const GlideResult &result)
 {
-  /** Condition, ranks by arrival time */
-  bool operator()(const AlternatePoint &x, const AlternatePoint &y) const {
-    return x.solution.time_elapsed + x.solution.time_virtual >
-           y.solution.time_elapsed + y.solution.time_virtual;
+  return result.time_elapsed + result.time_virtual;
+}
+
+/**
+ * Returns a lower bound of GetRankTime() for a destination at the
+ * specified distance: no MacCready solution is faster than flying
+ * straight at maximum speed with the wind from behind.
+ *
+ * @param inv_max_speed the inverse of the maximum ground speed [s/m]
+ */
+gcc_const
+static fixed
+GetMinTime(fixed distance, fixed inv_max_speed)
+{
+  /* leave some room for rounding errors */
+  return distance * inv_max_speed * fixed(0.95);
+}
+
+/** Function object used to rank candidates by arrival time */
+struct AbortTask::CandidateRank
+  : public std::binary_function<const Candidate *, const Candidate *, bool>
+{
+  /** Condition, ranks by arrival time (slowest on top) */
+  bool operator()(const Candidate *x, const Candidate *y) const {
+    return GetRankTime(x->solution) < GetRankTime(y->solution);
   }
 };
 
@@ -135,76 +170,107 @@ IsReachable(const GlideResult &result, bool final_glide)
     : result.IsAchievable();
 }
 
+const GlideResult &
+AbortTask::SolveCandidate(Candidate &c, const AircraftState &state,
+                          const GlidePolar &polar) const
+{
+  if (!c.solved) {
+    /* same as TaskSolution::GlideSolutionRemaining() with an
+       UnorderedTaskPoint, but without copying the Waypoint */
+    const GlideState gs(c.vector,
+                        std::max(fixed(0), c.waypoint->elevation +
+                                 task_behaviour.safety_height_arrival),
+                        state.altitude, state.wind);
+    c.solution = MacCready::Solve(task_behaviour.glide, polar, gs);
+    c.solved = true;
+  }
+
+  return c.solution;
+}
+
 bool
 AbortTask::FillReachable(const AircraftState &state,
-                         AlternateList &approx_waypoints,
                          const GlidePolar &polar, bool only_airfield,
                          bool final_glide, bool safety)
 {
-  if (IsTaskFull() || approx_waypoints.empty())
+  if (IsTaskFull() || candidates.empty())
     return false;
 
-  const AGeoPoint p_start(state.location, state.altitude);
+  const unsigned n_wanted = max_abort - task_points.size();
+  const fixed inv_max_speed = fixed(1) /
+    (polar.GetVMax() * std::max(fixed(1), polar.GetCruiseEfficiency())
+     + state.wind.norm);
 
   bool found_final_glide = false;
-  reservable_priority_queue<AlternatePoint, AlternateList, AbortRank> q;
-  q.reserve(32);
 
-  for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
-    if (only_airfield && !v->waypoint.IsAirport()) {
-      ++v;
-      continue;
-    }
+  /* the best results found so far; the slowest one is on top, to be
+     replaced by better ones */
+  reservable_priority_queue<Candidate *, std::vector<Candidate *>,
+                            CandidateRank> q;
+  q.reserve(n_wanted + 1);
 
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+  for (auto &c : candidates) {
+    if (pruning && q.size() >= n_wanted &&
+        GetMinTime(c.vector.distance, inv_max_speed) > GetRankTime(q.top()->solution))
+      /* candidates are sorted by distance; none of the remaining
+         ones can beat the results we have */
+      break;
 
-    if (IsReachable(result, final_glide)) {
-      bool intersects = false;
-      const bool is_reachable_final = IsReachable(result, true);
-
-      if (intersection_test && final_glide && is_reachable_final)
-        intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint.location, result.min_arrival_altitude));
+    if (c.used || (only_airfield && !c.waypoint->IsAirport()))
+      continue;
 
-      if (!intersects) {
-        q.push(AlternatePoint(v->waypoint, result));
-        // remove it since it's already in the list now      
-        v = approx_waypoints.erase(v);
+    const GlideResult &result = SolveCandidate(c, state, polar);
+    if (!IsReachable(result, final_glide))
+      continue;
 
-        if (is_reachable_final)
-          found_final_glide = true;
+    const bool is_reachable_final = IsReachable(result, true);
 
-        continue; // skip incrementing v since we just erased it
+    if (intersection_test && final_glide && is_reachable_final) {
+      if (!c.intersection_checked) {
+        c.intersects = intersection_test->Intersects(
+            AGeoPoint(c.waypoint->location, result.min_arrival_altitude));
+        c.intersection_checked = true;
       }
-    } 
 
-    ++v;
+      if (c.intersects)
+        continue;
+    }
+
+    q.push(&c);
+    if (q.size() > n_wanted)
+      q.pop();
+
+    if (is_reachable_final)
+      found_final_glide = true;
   }
 
-  while (!q.empty() && !IsTaskFull()) {
-    const AlternatePoint top = q.top();
-    task_points.emplace_back(top.waypoint, task_behaviour, top.solution);
+  /* the queue pops the slowest first; reverse that order */
+  const unsigned n = q.size();
+  Candidate *best[max_abort];
+  for (unsigned i = n; i-- > 0; q.pop())
+    best[i] = q.top();
+
+  for (unsigned i = 0; i < n; ++i) {
+    Candidate &c = *best[i];
+    c.used = true;
 
-    const int i = task_points.size() - 1;
-    if (task_points[i].point.GetWaypoint().id == active_waypoint)
-      active_task_point = i;
+    task_points.emplace_back(*c.waypoint, task_behaviour, c.solution);
 
-    q.pop();
+    const int index = task_points.size() - 1;
+    if (task_points[index].point.GetWaypoint().id == active_waypoint)
+      active_task_point = index;
   }
 
   return found_final_glide;
 }
 
 /**
- * Class to build vector from visited waypoints.
+ * Class to build vector from visited landable waypoints.
  * Intended to be used temporarily.
  */
-class WaypointVisitorVector: public WaypointVisitor
+class LandableVisitorVector: public WaypointVisitor
 {
-  AlternateList &vector;
+  std::vector<const Waypoint *> &vector;
 
 public:
   /**
@@ -214,7 +280,7 @@ public:
    *
    * @return Initialised object
    */
-  WaypointVisitorVector(AlternateList &wpv):vector(wpv) {}
+  LandableVisitorVector(std::vector<const Waypoint *> &wpv):vector(wpv) {}
 
   /**
    * Visit method, adds result to vector
@@ -223,10 +289,40 @@ public:
    */
   void Visit(const Waypoint& wp) {
     if (wp.IsLandable())
-      vector.emplace_back(wp);
+      vector.push_back(&wp);
   }
 };
 
+void
+AbortTask::CollectCandidates(const GeoPoint &location, fixed range)
+{
+  if (!cache_location.IsValid() ||
+      cache_serial != waypoints.GetSerial() ||
+      location.Distance(cache_location) + range > cache_range) {
+    /* query a bigger area than needed, so the result can be reused
+       for a while */
+    cache_location = location;
+    cache_range = range + cache_margin;
+    cache_serial = waypoints.GetSerial();
+
+    candidate_cache.clear();
+    LandableVisitorVector lvv(candidate_cache);
+    waypoints.VisitWithinRange(cache_location, cache_range, lvv);
+  }
+
+  candidates.clear();
+  for (const Waypoint *wp : candidate_cache) {
+    const GeoVector vector(location, wp->location);
+    if (vector.distance <= range)
+      candidates.emplace_back(*wp, vector);
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate &a, const Candidate &b) {
+              return a.vector.distance < b.vector.distance;
+            });
+}
+
 void 
 AbortTask::ClientUpdate(const AircraftState &state_now, bool reachable)
 {
@@ -256,13 +352,8 @@ AbortTask::UpdateSample(const AircraftState &state,
     /* can't work without a polar */
     return false;
 
-  AlternateList approx_waypoints;
-  approx_waypoints.reserve(128);
-
-  WaypointVisitorVector wvv(approx_waypoints);
-  waypoints.VisitWithinRange(state.location,
-                             GetAbortRange(state, glide_polar), wvv);
-  if (approx_waypoints.empty()) {
+  CollectCandidates(state.location, GetAbortRange(state, glide_polar));
+  if (candidates.empty()) {
     /** @todo increase range */
     return false;
   }
@@ -270,16 +361,16 @@ AbortTask::UpdateSample(const AircraftState &state,
   // sort by arrival time
 
   // first try with final glide only
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, glide_polar,
                                        true, true, true);
-  reachable_landable |=  FillReachable(state, approx_waypoints, glide_polar,
+  reachable_landable |=  FillReachable(state, glide_polar,
                                        false, true, true);
 
   // inform clients that the landable reachable scan has been performed 
   ClientUpdate(state, true);
 
   // now try without final glide constraint and not preferring airports
-  FillReachable(state, approx_waypoints, glide_polar, false, false, false);
+  FillReachable(state, glide_polar, false, false, false);
 
   // inform clients that the landable unreachable scan has been performed 
   ClientUpdate(state, false);
@@ -26,6 +26,8 @@
 #include "UnorderedTask.hpp"
 #include "UnorderedTaskPoint.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "Geo/GeoVector.hpp"
+#include "Util/Serial.hpp"
 
 #include <vector>
 
@@ -33,7 +35,6 @@
 
 class Waypoints;
 class AbortIntersectionTest;
-class AlternateList;
 
 /**
  * Abort task provides automatic management of a sorted list of task points
@@ -78,9 +79,64 @@ protected:
   AbortIntersectionTest* intersection_test;
 
 private:
+  /**
+   * A landable waypoint within the abort range.  Its glide solution
+   * is calculated on demand, at most once per update.
+   */
+  struct Candidate {
+    const Waypoint *waypoint;
+
+    /** Vector from the aircraft to the waypoint */
+    GeoVector vector;
+
+    GlideResult solution;
+
+    /** Has #solution been calculated? */
+    bool solved;
+
+    /** Has #intersects been determined? */
+    bool intersection_checked;
+
+    /** Does the final glide path intersect with terrain? */
+    bool intersects;
+
+    /** Has this candidate been added to the task? */
+    bool used;
+
+    Candidate(const Waypoint &_waypoint, const GeoVector &_vector)
+      :waypoint(&_waypoint), vector(_vector),
+       solved(false), intersection_checked(false), intersects(false),
+       used(false) {}
+  };
+
+  struct CandidateRank;
+
+  /**
+   * The candidates of the current update, sorted by distance.
+   */
+  std::vector<Candidate> candidates;
+
+  /**
+   * All landable waypoints within #cache_range around
+   * #cache_location.  This query result is reused by the following
+   * updates until the aircraft leaves that area or the waypoint
+   * database is modified.
+   */
+  std::vector<const Waypoint *> candidate_cache;
+
+  Serial cache_serial;
+  GeoPoint cache_location;
+  fixed cache_range;
+
   unsigned active_waypoint;
   bool reachable_landable;
 
+  /**
+   * Shall FillReachable() stop early when the remaining candidates
+   * cannot beat the ones already found?
+   */
+  bool pruning;
+
 public:
   /** 
    * Base constructor.
@@ -156,12 +212,16 @@ protected:
                       const GlidePolar &glide_polar) const;
 
   /**
-   * Fill abort task list with candidate waypoints given a list of
-   * waypoints satisfying approximate range queries.  Can be used
-   * to add airfields only, or landpoints.
+   * Fill abort task list with candidate waypoints found by
+   * CollectCandidates().  Can be used to add airfields only, or
+   * landpoints.
+   *
+   * Candidates are solved nearest first, and the search stops as
+   * soon as the remaining ones cannot arrive earlier than the ones
+   * already found (see GetMinTime()), so usually only a few of them
+   * need a full MacCready solution.
    *
    * @param state Aircraft state
-   * @param approx_waypoints List of candidate waypoints
    * @param polar Polar used for tests
    * @param only_airfield If true, only add waypoints that are airfields.
    * @param final_glide Whether solution must be glide only or climb allowed
@@ -170,10 +230,23 @@ protected:
    * @return True if a landpoint within final glide was found
    */
   bool FillReachable(const AircraftState &state,
-                     AlternateList &approx_waypoints,
                      const GlidePolar &polar, bool only_airfield,
                      bool final_glide, bool safety);
 
+private:
+  /**
+   * Fill #candidates with the landable waypoints within the
+   * specified range, sorted by distance.
+   */
+  void CollectCandidates(const GeoPoint &location, fixed range);
+
+  /**
+   * Calculate the glide solution of the candidate (if that has not
+   * been done already in this update).
+   */
+  const GlideResult &SolveCandidate(Candidate &c, const AircraftState &state,
+                                    const GlidePolar &polar) const;
+
 protected:
   /**
    * This is called by update_sample after the turnpoint list has 
@@ -192,6 +265,15 @@ public:
     is_active = _active;
   }
 
+  /**
+   * Enable or disable the early termination of FillReachable().
+   * This does not change the result, disabling it only makes the
+   * update slower.  It is meant for unit tests.
+   */
+  void SetPruning(bool _pruning) {
+    pruning = _pruning;
+  }
+
   /**
    * Set external test function to be used for additional intersection tests
    */
@@ -0,0 +1,139 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Snapshot.hpp"
+#include "Trace.hpp"
+#include "Vector.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+void
+TraceSnapshot::CopyTo(TracePointVector &v, unsigned first) const
+{
+  assert(first <= n);
+
+  v.reserve(v.size() + n - first);
+
+  while (first < n) {
+    const Chunk &chunk = *list->chunks[first / CHUNK_SIZE];
+    const unsigned offset = first % CHUNK_SIZE;
+    const unsigned count = std::min(CHUNK_SIZE - offset, n - first);
+    v.insert(v.end(), chunk.points + offset, chunk.points + offset + count);
+    first += count;
+  }
+}
+
+void
+TraceSnapshot::CopyTo(TracePointVector &v, unsigned min_time,
+                      const GeoPoint &location, fixed resolution) const
+{
+  /* skip the trace points that are before min_time */
+  unsigned i = 0;
+  while (i < n && (*this)[i].GetTime() < min_time)
+    ++i;
+
+  if (i == n)
+    /* nothing left */
+    return;
+
+  v.reserve(n - i);
+
+  const unsigned range =
+    list->projection.ProjectRangeInteger(location, resolution);
+  const unsigned sq_range = range * range;
+
+  const TracePoint *previous = &(*this)[i];
+  v.push_back(*previous);
+
+  for (++i; i < n; ++i) {
+    const TracePoint &point = (*this)[i];
+    if (point.FlatSquareDistanceTo(*previous) >= sq_range) {
+      v.push_back(point);
+      previous = &point;
+    }
+  }
+}
+
+void
+TraceSnapshotBuilder::Rebuild(const Trace &trace)
+{
+  /* never modify the old list, it may still be referenced by
+     snapshots */
+  list = std::make_shared<TraceSnapshot::ChunkList>();
+  list->epoch = ++epoch;
+  if (!trace.empty())
+    list->projection = trace.GetProjection();
+
+  n = 0;
+  modify_serial = trace.GetModifySerial();
+
+  for (const auto &point : trace)
+    Append(point);
+}
+
+void
+TraceSnapshotBuilder::Append(const TracePoint &point)
+{
+  constexpr unsigned CHUNK_SIZE = TraceSnapshot::CHUNK_SIZE;
+
+  if (n % CHUNK_SIZE == 0 && n / CHUNK_SIZE == list->chunks.size()) {
+    /* the chunk vector may be in use by a snapshot; copy it instead
+       of reallocating it in place */
+    auto new_list = std::make_shared<TraceSnapshot::ChunkList>(*list);
+    new_list->chunks.emplace_back(std::make_shared<TraceSnapshot::Chunk>());
+    list = std::move(new_list);
+  }
+
+  /* this slot is beyond the size of all existing snapshots, so it
+     may be written without affecting them */
+  list->chunks[n / CHUNK_SIZE]->points[n % CHUNK_SIZE] = point;
+  ++n;
+}
+
+void
+TraceSnapshotBuilder::Sync(const Trace &trace)
+{
+  if (list == nullptr || trace.GetModifySerial() != modify_serial ||
+      trace.size() < n || (n == 0 && !trace.empty())) {
+    Rebuild(trace);
+    return;
+  }
+
+  if (trace.size() == n)
+    /* no news */
+    return;
+
+  for (auto i = std::prev(trace.end(), trace.size() - n), end = trace.end();
+       i != end; ++i)
+    Append(*i);
+}
+
+TraceSnapshot
+TraceSnapshotBuilder::Get() const
+{
+  TraceSnapshot snapshot;
+  snapshot.list = list;
+  snapshot.n = n;
+  return snapshot;
+}
@@ -0,0 +1,176 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRACE_SNAPSHOT_HPP
+#define XCSOAR_TRACE_SNAPSHOT_HPP
+
+#include "Point.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "Util/Serial.hpp"
+#include "Compiler.h"
+
+#include <memory>
+#include <vector>
+
+#include <assert.h>
+
+class Trace;
+class TracePointVector;
+
+/**
+ * An immutable copy of a #Trace which can be passed to other threads
+ * without locking.  The points are stored in fixed-size chunks that
+ * are shared (reference counted) between consecutive snapshots; a
+ * new snapshot of a trace which has only been appended to shares all
+ * chunks but the last one with its predecessor.
+ *
+ * Snapshots are created by #TraceSnapshotBuilder.  Copying a
+ * snapshot is cheap, it only copies a reference.
+ */
+class TraceSnapshot {
+  friend class TraceSnapshotBuilder;
+
+public:
+  static constexpr unsigned CHUNK_SIZE = 64;
+
+private:
+  struct Chunk {
+    TracePoint points[CHUNK_SIZE];
+  };
+
+  struct ChunkList {
+    /**
+     * Incremented each time the #Trace was modified in a way other
+     * than appending, i.e. when the indices of the snapshot cannot be
+     * compared with the ones of its predecessor.
+     */
+    unsigned epoch;
+
+    TaskProjection projection;
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+  };
+
+  std::shared_ptr<const ChunkList> list;
+
+  /**
+   * The number of points in this snapshot.  The #ChunkList may be
+   * shared with newer snapshots which contain more points, but the
+   * first #size points are never modified.
+   */
+  unsigned n;
+
+public:
+  TraceSnapshot():n(0) {}
+
+  unsigned size() const {
+    return n;
+  }
+
+  bool empty() const {
+    return n == 0;
+  }
+
+  /**
+   * Returns the epoch of this snapshot.  Two snapshots with the same
+   * epoch were taken from the same trace without thinning or
+   * clearing in between: the first size() points of the older one
+   * are the same as in the newer one.
+   */
+  unsigned GetEpoch() const {
+    return list != nullptr ? list->epoch : 0;
+  }
+
+  const TracePoint &operator[](unsigned i) const {
+    assert(i < n);
+
+    return list->chunks[i / CHUNK_SIZE]->points[i % CHUNK_SIZE];
+  }
+
+  const TracePoint &back() const {
+    assert(!empty());
+
+    return (*this)[n - 1];
+  }
+
+  /**
+   * Returns the flat projection the trace points were projected
+   * with.  Must not be called on an empty snapshot.
+   */
+  const TaskProjection &GetProjection() const {
+    assert(!empty());
+
+    return list->projection;
+  }
+
+  /**
+   * Append all points starting at the specified index to the vector.
+   * Pass the number of points obtained from an older snapshot of the
+   * same epoch to load only the points which were added since.
+   */
+  void CopyTo(TracePointVector &v, unsigned first=0) const;
+
+  /**
+   * Copy the points which are not older than #min_time, omitting
+   * points which are closer than #resolution to their predecessor.
+   * This is equivalent to Trace::GetPoints().
+   */
+  void CopyTo(TracePointVector &v, unsigned min_time,
+              const GeoPoint &location, fixed resolution) const;
+};
+
+/**
+ * Maintains a #TraceSnapshot of a #Trace.  It must be used by the
+ * thread which modifies the #Trace.
+ */
+class TraceSnapshotBuilder {
+  std::shared_ptr<TraceSnapshot::ChunkList> list;
+
+  unsigned n;
+
+  unsigned epoch;
+
+  Serial modify_serial;
+
+public:
+  TraceSnapshotBuilder():n(0), epoch(0) {}
+
+  /**
+   * Update the internal state after the #Trace has been modified.
+   * Appended points are copied incrementally; after any other
+   * modification, the snapshot is rebuilt from scratch.
+   */
+  void Sync(const Trace &trace);
+
+  /**
+   * Returns a snapshot of the state at the last Sync() call.
+   */
+  gcc_pure
+  TraceSnapshot Get() const;
+
+private:
+  void Rebuild(const Trace &trace);
+  void Append(const TracePoint &point);
+};
+
+#endif
@@ -497,8 +497,8 @@ public:
         if (*this == end)
           return *this;
 
-        const TraceDelta &td = (const TraceDelta &)**this;
-        if (td.point.FlatSquareDistanceTo(previous) >= sq_resolution)
+        const TracePoint &point = **this;
+        if (point.FlatSquareDistanceTo(previous) >= sq_resolution)
           return *this;
       }
     }
@@ -138,7 +138,7 @@ Waypoints::Optimise()
 }
 
 const Waypoint &
-Waypoints::Append(Waypoint &&wp)
+Waypoints::AppendNoSerial(Waypoint &&wp)
 {
   if (waypoint_tree.HaveBounds()) {
     wp.Project(task_projection);
@@ -158,11 +158,29 @@ Waypoints::Append(Waypoint &&wp)
   const Waypoint &new_wp = waypoint_tree.Add(std::move(wp));
   name_tree.Add(new_wp);
 
-  ++serial;
+  return new_wp;
+}
 
+const Waypoint &
+Waypoints::Append(Waypoint &&wp)
+{
+  const Waypoint &new_wp = AppendNoSerial(std::move(wp));
+  ++serial;
   return new_wp;
 }
 
+void
+Waypoints::Append(std::vector<Waypoint> &&list)
+{
+  if (list.empty())
+    return;
+
+  for (auto &wp : list)
+    AppendNoSerial(std::move(wp));
+
+  ++serial;
+}
+
 const Waypoint *
 Waypoints::GetNearest(const GeoPoint &loc, fixed range) const
 {
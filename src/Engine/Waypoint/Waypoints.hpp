@@ -29,6 +29,8 @@
 #include "Waypoint.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 
+#include <vector>
+
 class WaypointVisitor;
 
 /**
@@ -81,6 +83,11 @@ class Waypoints {
 
   const Waypoint *home;
 
+  /**
+   * Implementation of Append() without incrementing the serial.
+   */
+  const Waypoint &AppendNoSerial(Waypoint &&wp);
+
 public:
   typedef WaypointTree::const_iterator const_iterator;
 
@@ -109,6 +116,15 @@ public:
    */
   const Waypoint &Append(Waypoint &&wp);
 
+  /**
+   * Add a batch of waypoints, in the order of the vector.  This is
+   * equivalent to calling Append() for each one, but the waypoints
+   * are moved (not copied) into the internal store.
+   *
+   * @param list Waypoints to add; the vector contents are moved from
+   */
+  void Append(std::vector<Waypoint> &&list);
+
   /**
    * Erase waypoint from the internal store.  Requires optimise() to
    * be called afterwards
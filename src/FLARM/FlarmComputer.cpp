@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "FLARM/FlarmComputer.hpp"
 #include "FLARM/FlarmDetails.hpp"
+#include "FLARM/TrafficColumns.hpp"
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 
@@ -61,6 +62,11 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     }
   }
 
+  /* the ids of the previous targets in one array, for a fast
+     lookup */
+  TrafficColumns last_columns;
+  last_columns.Load(last_flarm.traffic);
+
   // for each item in traffic
   for (auto &traffic : flarm.traffic.list) {
     // if we don't know the target's name yet
@@ -105,9 +111,12 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
       continue;
 
     // Check if the target has been seen before in the last seconds
-    const FlarmTraffic *last_traffic =
-      last_flarm.traffic.FindTraffic(traffic.id);
-    if (last_traffic == NULL || !last_traffic->valid)
+    const int last_index = last_columns.Find(traffic.id);
+    if (last_index < 0)
+      continue;
+
+    const FlarmTraffic *last_traffic = &last_flarm.traffic.list[last_index];
+    if (!last_traffic->valid)
       continue;
 
     // Calculate the time difference between now and the last contact
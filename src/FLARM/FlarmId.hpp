@@ -65,6 +65,15 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Returns a hash of this id, to be used in hash tables.  The upper
+   * bits are well mixed.
+   */
+  constexpr uint32_t Hash() const {
+    /* Fibonacci hashing */
+    return value * 2654435761u;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
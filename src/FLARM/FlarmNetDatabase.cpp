@@ -22,33 +22,319 @@ Copyright_License {
 */
 
 #include "FlarmNetDatabase.hpp"
+#include "OS/FileMapping.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+
 #include <assert.h>
+#include <string.h>
+
+/**
+ * The header of the binary image written by
+ * FlarmNetDatabase::Save().  It is followed by the records, the hash
+ * table and the callsign index.
+ */
+struct FlarmNetImageHeader {
+  static constexpr uint32_t MAGIC = 0x4e464358;
+  static constexpr uint32_t VERSION = 1;
+
+  uint32_t magic, version;
+
+  /**
+   * sizeof(FlarmNetRecord), which depends on the platform.
+   */
+  uint32_t record_size;
+
+  uint32_t n_records, table_bits;
+
+  /**
+   * Offsets of the arrays, relative to the beginning of this header.
+   */
+  uint32_t records_offset, table_offset, callsigns_offset;
+};
+
+/**
+ * Round up to a multiple of 4, the alignment of the hash table and
+ * the callsign index.
+ */
+static constexpr size_t
+Align4(size_t size)
+{
+  return (size + 3) & ~size_t(3);
+}
+
+FlarmNetDatabase::FlarmNetDatabase()
+  :mapping(nullptr)
+{
+  Clear();
+}
+
+FlarmNetDatabase::~FlarmNetDatabase()
+{
+  delete mapping;
+}
+
+void
+FlarmNetDatabase::Clear()
+{
+  delete mapping;
+  mapping = nullptr;
+
+  record_vector.clear();
+  table_vector.clear();
+  callsign_vector.clear();
+  table_bits = 0;
+  finished = true;
+
+  UpdatePointers();
+}
+
+void
+FlarmNetDatabase::UpdatePointers()
+{
+  assert(mapping == nullptr);
+
+  records = record_vector.data();
+  n_records = record_vector.size();
+  table = table_vector.empty() ? nullptr : table_vector.data();
+  callsigns = callsign_vector.data();
+}
+
+inline const FlarmNetDatabase::Slot *
+FlarmNetDatabase::FindSlot(FlarmId id) const
+{
+  if (table == nullptr)
+    return nullptr;
+
+  const unsigned mask = (1u << table_bits) - 1;
+
+  /* linear probing; the table is never more than half full, so there
+     is always an empty slot */
+  for (unsigned i = id.Hash() >> (32 - table_bits);; i = (i + 1) & mask) {
+    const Slot &slot = table[i];
+    if (slot.id == id || !slot.id.IsDefined())
+      return &slot;
+  }
+}
+
+void
+FlarmNetDatabase::Rehash(unsigned bits)
+{
+  assert(mapping == nullptr);
+
+  Slot empty;
+  empty.id = FlarmId::Undefined();
+  empty.index = 0;
+
+  table_vector.assign(1u << bits, empty);
+  table_bits = bits;
+  table = table_vector.data();
+
+  for (unsigned i = 0; i < record_vector.size(); ++i) {
+    const FlarmId id = record_vector[i].GetId();
+    Slot &slot = const_cast<Slot &>(*FindSlot(id));
+    slot.id = id;
+    slot.index = i;
+  }
+}
 
 void
 FlarmNetDatabase::Insert(const FlarmNetRecord &record)
 {
+  assert(mapping == nullptr);
+
   FlarmId id = record.GetId();
   if (!id.IsDefined())
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  if ((record_vector.size() + 1) * 2 > table_vector.size())
+    Rehash(std::max(table_bits + 1, 6u));
+
+  Slot &slot = const_cast<Slot &>(*FindSlot(id));
+  if (slot.id.IsDefined())
+    /* duplicate: the first record wins */
+    return;
+
+  slot.id = id;
+  slot.index = record_vector.size();
+  record_vector.push_back(record);
+
+  callsign_vector.clear();
+  finished = false;
+
+  UpdatePointers();
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+void
+FlarmNetDatabase::Finish()
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (finished)
+    return;
+
+  callsign_vector.resize(record_vector.size());
+  for (unsigned i = 0; i < callsign_vector.size(); ++i)
+    callsign_vector[i] = i;
+
+  const FlarmNetRecord *r = record_vector.data();
+  std::stable_sort(callsign_vector.begin(), callsign_vector.end(),
+                   [r](uint32_t a, uint32_t b) {
+                     return _tcscmp(r[a].callsign, r[b].callsign) < 0;
+                   });
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  finished = true;
+  UpdatePointers();
+}
+
+bool
+FlarmNetDatabase::Save(FILE *file) const
+{
+  assert(finished);
+
+  const size_t table_size = table != nullptr ? (1u << table_bits) : 0;
+
+  FlarmNetImageHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = FlarmNetImageHeader::MAGIC;
+  header.version = FlarmNetImageHeader::VERSION;
+  header.record_size = sizeof(FlarmNetRecord);
+  header.n_records = n_records;
+  header.table_bits = table_bits;
+  header.records_offset = sizeof(header);
+  header.table_offset =
+    Align4(header.records_offset + n_records * sizeof(FlarmNetRecord));
+  header.callsigns_offset =
+    header.table_offset + table_size * sizeof(Slot);
+
+  static constexpr uint8_t padding[4] = {0, 0, 0, 0};
+  const size_t padding_size = header.table_offset -
+    (header.records_offset + n_records * sizeof(FlarmNetRecord));
+
+  return fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(records, sizeof(*records), n_records, file) == n_records &&
+    fwrite(padding, 1, padding_size, file) == padding_size &&
+    fwrite(table, sizeof(*table), table_size, file) == table_size &&
+    fwrite(callsigns, sizeof(*callsigns), n_records, file) == n_records;
+}
+
+gcc_pure
+static bool
+CheckArray(size_t size, size_t offset, size_t n, size_t element_size)
+{
+  return offset % 4 == 0 && offset <= size &&
+    n <= (size - offset) / element_size;
+}
+
+bool
+FlarmNetDatabase::Load(FileMapping *_mapping, size_t offset)
+{
+  Clear();
+
+  assert(_mapping != nullptr);
+
+  if (offset % 4 != 0 ||
+      _mapping->size() < offset + sizeof(FlarmNetImageHeader)) {
+    delete _mapping;
+    return false;
+  }
+
+  const size_t size = _mapping->size() - offset;
+  const uint8_t *base = (const uint8_t *)_mapping->at(offset);
+  const FlarmNetImageHeader &header = *(const FlarmNetImageHeader *)base;
+  if (header.magic != FlarmNetImageHeader::MAGIC ||
+      header.version != FlarmNetImageHeader::VERSION ||
+      header.record_size != sizeof(FlarmNetRecord) ||
+      /* the table must have between 64 and 2^31 slots */
+      header.table_bits < 6 || header.table_bits > 31) {
+    delete _mapping;
+    return false;
+  }
+
+  const size_t table_size = size_t(1) << header.table_bits;
+
+  if (header.n_records > table_size / 2 ||
+      header.records_offset < sizeof(header) ||
+      header.records_offset > size ||
+      header.n_records > (size - header.records_offset) /
+      sizeof(FlarmNetRecord) ||
+      !CheckArray(size, header.table_offset, table_size, sizeof(Slot)) ||
+      !CheckArray(size, header.callsigns_offset, header.n_records,
+                  sizeof(uint32_t))) {
+    delete _mapping;
+    return false;
+  }
+
+  const Slot *_table = (const Slot *)(base + header.table_offset);
+  const uint32_t *_callsigns =
+    (const uint32_t *)(base + header.callsigns_offset);
+
+  /* verify the indices, so a corrupt file cannot make us read beyond
+     the mapping; and count the used slots: FindSlot() relies on
+     having empty slots, or its linear probing would never end */
+  size_t n_defined = 0;
+  for (size_t i = 0; i < table_size; ++i) {
+    if (_table[i].id.IsDefined()) {
+      if (_table[i].index >= header.n_records) {
+        delete _mapping;
+        return false;
+      }
+
+      ++n_defined;
+    }
+  }
+
+  if (n_defined != header.n_records) {
+    delete _mapping;
+    return false;
   }
 
-  return NULL;
+  for (unsigned i = 0; i < header.n_records; ++i) {
+    if (_callsigns[i] >= header.n_records) {
+      delete _mapping;
+      return false;
+    }
+  }
+
+  mapping = _mapping;
+  records = (const FlarmNetRecord *)(base + header.records_offset);
+  n_records = header.n_records;
+  table = _table;
+  table_bits = header.table_bits;
+  callsigns = _callsigns;
+  finished = true;
+  return true;
+}
+
+std::pair<const uint32_t *, const uint32_t *>
+FlarmNetDatabase::FindCallSign(const TCHAR *cn, bool prefix) const
+{
+  assert(finished);
+
+  const FlarmNetRecord *r = records;
+  const uint32_t *begin = std::lower_bound(callsigns, callsigns + n_records,
+                                           cn,
+                                           [r](uint32_t i, const TCHAR *b) {
+    return _tcscmp(r[i].callsign, b) < 0;
+  });
+
+  const uint32_t *end = begin;
+  while (end != callsigns + n_records &&
+         (prefix
+          ? StringStartsWith(r[*end].callsign, cn)
+          : StringIsEqual(r[*end].callsign, cn)))
+    ++end;
+
+  return std::make_pair(begin, end);
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  const auto range = FindCallSign(cn, false);
+  return range.first != range.second
+    ? &records[*range.first]
+    : nullptr;
 }
 
 unsigned
@@ -56,15 +342,11 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
                                         const FlarmNetRecord *array[],
                                         unsigned size) const
 {
-  unsigned count = 0;
-
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  const auto range = FindCallSign(cn, false);
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  unsigned count = 0;
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &records[*i];
 
   return count;
 }
@@ -73,15 +355,25 @@ unsigned
 FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                                     unsigned size) const
 {
+  const auto range = FindCallSign(cn, false);
+
   unsigned count = 0;
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = records[*i].GetId();
+
+  return count;
+}
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+unsigned
+FlarmNetDatabase::FindRecordsByCallSignPrefix(const TCHAR *prefix,
+                                              const FlarmNetRecord *array[],
+                                              unsigned size) const
+{
+  const auto range = FindCallSign(prefix, true);
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
-  }
+  unsigned count = 0;
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &records[*i];
 
   return count;
 }
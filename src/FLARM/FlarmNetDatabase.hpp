@@ -26,29 +26,107 @@ Copyright_License {
 
 #include "FlarmId.hpp"
 #include "FlarmNetRecord.hpp"
+#include "Util/NonCopyable.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <vector>
+#include <utility>
+
 #include <tchar.h>
+#include <stdint.h>
+#include <stdio.h>
+
+class FileMapping;
 
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are stored in a flat array.  An open-addressing hash
+ * table maps FLARM ids to records, and an index sorted by callsign
+ * allows callsign and prefix searches.  The whole database can be
+ * saved to a native-endian binary image (Save()), which can later be
+ * mapped into memory (Load()) instead of parsing the text file again.
  */
-class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+class FlarmNetDatabase : private NonCopyable {
+public:
+  struct Slot {
+    /**
+     * FlarmId::Undefined() if this slot is empty.
+     */
+    FlarmId id;
+
+    uint32_t index;
+  };
+
+private:
+  /**
+   * The storage for a database which was populated with Insert().
+   */
+  std::vector<FlarmNetRecord> record_vector;
+  std::vector<Slot> table_vector;
+  std::vector<uint32_t> callsign_vector;
+
+  /**
+   * If this is not nullptr, then the database is a mapped binary
+   * image, and the vectors are empty.
+   */
+  FileMapping *mapping;
+
+  /**
+   * Pointers into either the vectors or the mapping.
+   */
+  const FlarmNetRecord *records;
+  unsigned n_records;
+
+  const Slot *table;
+  unsigned table_bits;
+
+  /**
+   * Record indices sorted by callsign.  Only valid if #finished is
+   * true.
+   */
+  const uint32_t *callsigns;
+
+  bool finished;
 
 public:
+  FlarmNetDatabase();
+  ~FlarmNetDatabase();
+
   bool IsEmpty() const {
-    return map.empty();
+    return n_records == 0;
   }
 
-  void Clear() {
-    map.clear();
+  unsigned GetCount() const {
+    return n_records;
   }
 
+  void Clear();
+
+  /**
+   * Add a record.  Records with a malformed or duplicate id are
+   * ignored.  Finish() must be called after the last record has been
+   * added.
+   */
   void Insert(const FlarmNetRecord &record);
 
+  /**
+   * Build the callsign index.
+   */
+  void Finish();
+
+  /**
+   * Write the database to a binary image.  Must be finished.
+   */
+  bool Save(FILE *file) const;
+
+  /**
+   * Use the binary image at the specified offset of the mapping.  On
+   * success, the mapping is owned by this object, otherwise it is
+   * deleted.
+   */
+  bool Load(FileMapping *mapping, size_t offset);
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
@@ -56,10 +134,10 @@ public:
    */
   gcc_pure
   const FlarmNetRecord *FindRecordById(FlarmId id) const {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
+    const Slot *slot = FindSlot(id);
+    return slot != nullptr && slot->id.IsDefined()
+      ? &records[slot->index]
+      : nullptr;
   }
 
   /**
@@ -76,13 +154,41 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  /**
+   * Finds all records whose callsign begins with the specified
+   * prefix, ordered by callsign.
+   */
+  unsigned FindRecordsByCallSignPrefix(const TCHAR *prefix,
+                                       const FlarmNetRecord *array[],
+                                       unsigned size) const;
+
+  const FlarmNetRecord *begin() const {
+    return records;
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  const FlarmNetRecord *end() const {
+    return records + n_records;
   }
+
+private:
+  void UpdatePointers();
+
+  void Rehash(unsigned bits);
+
+  /**
+   * Returns the slot containing the specified id, or the empty slot
+   * where it would be inserted, or nullptr if the table is empty.
+   */
+  gcc_pure
+  const Slot *FindSlot(FlarmId id) const;
+
+  /**
+   * Returns the range of the callsign index which contains all
+   * records with the specified callsign (or callsign prefix).
+   */
+  gcc_pure
+  std::pair<const uint32_t *, const uint32_t *>
+  FindCallSign(const TCHAR *cn, bool prefix) const;
 };
 
 #endif
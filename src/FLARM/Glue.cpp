@@ -30,15 +30,35 @@ Copyright_License {
 #include "MergeThread.hpp"
 #include "IO/DataFile.hpp"
 #include "IO/TextWriter.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileMapping.hpp"
+#include "LocalPath.hpp"
 #include "Profile/FlarmProfile.hpp"
 #include "LogFile.hpp"
 
+#include <windef.h> /* for MAX_PATH */
+
+static const TCHAR *const flarmnet_cache_name = _T("flarmnet");
+
 /**
- * Loads the FLARMnet file
+ * Loads the FLARMnet file.  The parsed database is saved as a binary
+ * image in the #FileCache, which is mapped into memory on the next
+ * start.
  */
 static void
 LoadFLARMnet(FlarmNetDatabase &db)
 {
+  TCHAR path[MAX_PATH];
+  LocalPath(path, _T("data.fln"));
+
+  if (file_cache != nullptr) {
+    FileMapping *mapping = file_cache->Map(flarmnet_cache_name, path);
+    if (mapping != nullptr && db.Load(mapping, FileCache::DATA_OFFSET)) {
+      LogFormat("%u FLARMnet ids found in cache", db.GetCount());
+      return;
+    }
+  }
+
   NLineReader *reader = OpenDataTextFileA(_T("data.fln"));
   if (reader == NULL)
     return;
@@ -46,8 +66,20 @@ LoadFLARMnet(FlarmNetDatabase &db)
   unsigned num_records = FlarmNetReader::LoadFile(*reader, db);
   delete reader;
 
-  if (num_records > 0)
-    LogFormat("%u FLARMnet ids found", num_records);
+  if (num_records == 0)
+    return;
+
+  LogFormat("%u FLARMnet ids found", num_records);
+
+  if (file_cache != nullptr) {
+    FILE *file = file_cache->Save(flarmnet_cache_name, path);
+    if (file != nullptr) {
+      if (db.Save(file))
+        file_cache->Commit(flarmnet_cache_name, file);
+      else
+        file_cache->Cancel(flarmnet_cache_name, file);
+    }
+  }
 }
 
 /**
@@ -0,0 +1,101 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TrafficColumns.hpp"
+#include "Math/FastRotation.hpp"
+
+#include <algorithm>
+
+void
+TrafficColumns::Load(const TrafficList &traffic)
+{
+  size = traffic.list.size();
+
+  for (unsigned i = 0; i < size; ++i) {
+    const FlarmTraffic &t = traffic.list[i];
+    id[i] = t.id;
+    north[i] = t.relative_north;
+    east[i] = t.relative_east;
+    distance[i] = t.distance;
+    alarm_level[i] = t.alarm_level;
+  }
+}
+
+int
+TrafficColumns::Find(FlarmId _id) const
+{
+  for (unsigned i = 0; i < size; ++i)
+    if (id[i] == _id)
+      return i;
+
+  return -1;
+}
+
+void
+TrafficColumns::Project(fixed range, unsigned radius,
+                        const FastRotation *rotation,
+                        int *x, int *y) const
+{
+  const fixed radius_f(radius);
+
+  for (unsigned i = 0; i < size; ++i) {
+    const fixed d = distance[i];
+    const fixed scale = std::min(d / range, fixed(1)) * radius_f;
+
+    /* unit vector; screen y grows downwards */
+    Point2D<fixed> p(fixed(0), fixed(0));
+    if (positive(d)) {
+      p.x = east[i] / d;
+      p.y = -north[i] / d;
+    }
+
+    if (rotation != nullptr)
+      p = rotation->Rotate(p);
+
+    x[i] = iround(p.x * scale);
+    y[i] = iround(p.y * scale);
+  }
+}
+
+unsigned
+TrafficColumns::GetAlarmOrder(uint8_t *dest) const
+{
+  unsigned n = 0;
+  for (unsigned i = 0; i < size; ++i)
+    if (alarm_level[i] != FlarmTraffic::AlarmType::NONE)
+      dest[n++] = i;
+
+  /* on a complete tie, the lower index is more critical, like in
+     TrafficList::FindMaximumAlert() */
+  std::sort(dest, dest + n, [this](uint8_t a, uint8_t b) {
+      if (alarm_level[a] != alarm_level[b])
+        return (unsigned)alarm_level[a] < (unsigned)alarm_level[b];
+
+      if (distance[a] != distance[b])
+        return distance[a] > distance[b];
+
+      return a > b;
+    });
+
+  return n;
+}
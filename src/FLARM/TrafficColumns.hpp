@@ -0,0 +1,100 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_COLUMNS_HPP
+#define XCSOAR_FLARM_TRAFFIC_COLUMNS_HPP
+
+#include "List.hpp"
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+#include <stdint.h>
+
+class FastRotation;
+
+/**
+ * A column-oriented copy of the #TrafficList values which are
+ * evaluated for all targets at once: each value is stored in its own
+ * array, indexed like TrafficList::list.  This keeps the loops over
+ * all targets (lookup by id, radar projection, threat order) within a
+ * few cache lines, instead of striding over the whole #FlarmTraffic
+ * objects.
+ */
+struct TrafficColumns {
+  static constexpr unsigned MAX_COUNT = TrafficList::MAX_COUNT;
+
+  unsigned size;
+
+  FlarmId id[MAX_COUNT];
+
+  /** relative position [m] */
+  fixed north[MAX_COUNT], east[MAX_COUNT];
+
+  /** horizontal distance [m] */
+  fixed distance[MAX_COUNT];
+
+  FlarmTraffic::AlarmType alarm_level[MAX_COUNT];
+
+  void Clear() {
+    size = 0;
+  }
+
+  /**
+   * Copy the values from the specified #TrafficList.
+   */
+  void Load(const TrafficList &traffic);
+
+  /**
+   * Looks up a target by its FLARM id.
+   *
+   * @return the index or -1 if not found
+   */
+  gcc_pure
+  int Find(FlarmId _id) const;
+
+  /**
+   * Calculate the radar screen coordinates of all targets.  Targets
+   * beyond the range are placed on the edge.
+   *
+   * @param range the distance [m] at the edge of the radar
+   * @param radius the radius of the radar [pixels]
+   * @param rotation rotate the relative positions by this; nullptr
+   * for north up
+   * @param x, y arrays of #size elements which receive the screen
+   * coordinates relative to the radar center
+   */
+  void Project(fixed range, unsigned radius, const FastRotation *rotation,
+               int *x, int *y) const;
+
+  /**
+   * Fill the array with the indices of all targets which have an
+   * alarm, ordered by increasing threat: by alarm level, then by
+   * decreasing distance.  The most critical target (the one
+   * TrafficList::FindMaximumAlert() returns) is the last one.
+   *
+   * @return the number of indices
+   */
+  unsigned GetAlarmOrder(uint8_t *dest) const;
+};
+
+#endif
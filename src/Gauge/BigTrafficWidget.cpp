@@ -155,6 +155,7 @@ FlarmTrafficControl::OnCreate()
   Profile::GetEnum(ProfileKeys::FlarmSideData, side_display_type);
   enable_auto_zoom = settings.auto_zoom;
   enable_north_up = settings.north_up;
+  projection_valid = false;
 }
 
 unsigned
@@ -180,6 +181,7 @@ FlarmTrafficControl::SetNorthUp(bool enabled)
 {
   TrafficSettings &settings = CommonInterface::SetUISettings().traffic;
   settings.north_up = enable_north_up = enabled;
+  projection_valid = false;
   Profile::Set(ProfileKeys::FlarmNorthUp, enabled);
   //north_up->SetState(enabled);
 }
@@ -197,17 +199,16 @@ void
 FlarmTrafficControl::CalcAutoZoom()
 {
   bool warning_mode = WarningMode();
-  RoughDistance zoom_dist = fixed(0);
+  fixed zoom_dist2 = fixed(0);
 
-  for (auto it = data.list.begin(), end = data.list.end();
-      it != end; ++it) {
-    if (warning_mode && !it->HasAlarm())
+  for (unsigned i = 0; i < columns.size; ++i) {
+    if (warning_mode &&
+        columns.alarm_level[i] == FlarmTraffic::AlarmType::NONE)
       continue;
 
-    zoom_dist = std::max(it->distance, zoom_dist);
+    zoom_dist2 = std::max(columns.distance[i], zoom_dist2);
   }
 
-  fixed zoom_dist2 = zoom_dist;
   for (unsigned i = 0; i <= 4; i++) {
     if (i == 4 || fixed(GetZoomDistance(i)) >= zoom_dist2) {
       SetZoom(i);
@@ -52,11 +52,14 @@ FlarmTrafficWindow::FlarmTrafficWindow(const FlarmTrafficLook &_look,
    selection(-1), warning(-1),
    h_padding(_h_padding), v_padding(_v_padding),
    small(_small),
+   projection_valid(false),
    enable_north_up(false),
    heading(Angle::Zero()),
+   n_alarms(0),
    side_display_type(SIDE_INFO_VARIO)
 {
   data.Clear();
+  columns.Clear();
 }
 
 bool
@@ -81,6 +84,7 @@ FlarmTrafficWindow::OnResize(PixelSize new_size)
   radius = std::min(half_width - h_padding, half_height - v_padding);
   radar_mid.x = half_width;
   radar_mid.y = half_height;
+  projection_valid = false;
 }
 
 void
@@ -167,16 +171,33 @@ FlarmTrafficWindow::UpdateSelector(const FlarmId id, const RasterPoint pt)
 }
 
 /**
- * Iterates through the traffic array, finds the target with the highest
- * alarm level and saves it to "warning".
+ * Orders the targets with an alarm by threat, and saves the most
+ * critical one to "warning".
  */
 void
 FlarmTrafficWindow::UpdateWarnings()
 {
-  const FlarmTraffic *alert = data.FindMaximumAlert();
-  warning = alert != NULL
-    ? (int)data.TrafficIndex(alert)
-    : - 1;
+  n_alarms = columns.GetAlarmOrder(alarm_order);
+  warning = n_alarms > 0
+    ? (int)alarm_order[n_alarms - 1]
+    : -1;
+}
+
+void
+FlarmTrafficWindow::UpdateProjection()
+{
+  if (projection_valid)
+    return;
+
+  int x[TrafficList::MAX_COUNT], y[TrafficList::MAX_COUNT];
+  columns.Project(distance, radius, enable_north_up ? nullptr : &fr, x, y);
+
+  for (unsigned i = 0; i < columns.size; ++i) {
+    sc[i].x = radar_mid.x + x[i];
+    sc[i].y = radar_mid.y + y[i];
+  }
+
+  projection_valid = true;
 }
 
 /**
@@ -203,6 +224,12 @@ FlarmTrafficWindow::Update(Angle new_direction, const TrafficList &new_data,
   data = new_data;
   settings = new_settings;
 
+  columns.Load(data);
+  for (unsigned i = 0; i < columns.size; ++i)
+    colors[i] = FlarmFriends::GetFriendColor(columns.id[i]);
+
+  projection_valid = false;
+
   UpdateWarnings();
   UpdateSelector(selection_id, pt);
 
@@ -274,35 +301,11 @@ FlarmTrafficWindow::PaintRadarTarget(Canvas &canvas,
                                      const FlarmTraffic &traffic,
                                      unsigned i)
 {
-  // Save relative East/North
-  Point2D<fixed> p(traffic.relative_east,
-                   -traffic.relative_north);
-
-  // Calculate the distance in pixels
-  fixed scale = RangeScale(traffic.distance);
-
   // Don't display distracting, far away targets in WarningMode
-  if (WarningMode() && !traffic.HasAlarm() && scale == fixed(radius))
+  if (WarningMode() && !traffic.HasAlarm() &&
+      RangeScale(columns.distance[i]) == fixed(radius))
     return;
 
-  // x and y are not between 0 and 1 (distance will be handled via scale)
-  if (!traffic.distance.IsZero()) {
-    p.x /= traffic.distance;
-    p.y /= traffic.distance;
-  } else {
-    p.x = fixed(0);
-    p.y = fixed(0);
-  }
-
-  if (!enable_north_up) {
-    // Rotate x and y to have a track up display
-    p = fr.Rotate(p);
-  }
-
-  // Calculate screen coordinates
-  sc[i].x = radar_mid.x + iround(p.x * scale);
-  sc[i].y = radar_mid.y + iround(p.y * scale);
-
   const Color *text_color;
   const Pen *target_pen, *circle_pen;
   const Brush *target_brush, *arrow_brush;
@@ -335,8 +338,7 @@ FlarmTrafficWindow::PaintRadarTarget(Canvas &canvas,
       arrow_brush = &look.passive_brush;
       hollow_brush = true;
     } else {
-      // Search for team color
-      const FlarmColor team_color = FlarmFriends::GetFriendColor(traffic.id);
+      const FlarmColor team_color = colors[i];
 
       // If team color found -> draw a colored circle around the target
       if (team_color != FlarmColor::NONE) {
@@ -556,12 +558,10 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas)
   if (!WarningMode())
     return;
 
-  // Iterate through the traffic (alarm traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
-    const FlarmTraffic &traffic = data.list[i];
-
-    if (traffic.HasAlarm())
-      PaintRadarTarget(canvas, traffic, i);
+  // Paint the alarm traffic, the most critical one last
+  for (unsigned j = 0; j < n_alarms; ++j) {
+    const unsigned i = alarm_order[j];
+    PaintRadarTarget(canvas, data.list[i], i);
   }
 }
 
@@ -691,6 +691,8 @@ FlarmTrafficWindow::Paint(Canvas &canvas)
   assert(warning < 0 || data.list[warning].IsDefined());
   assert(warning < 0 || data.list[warning].HasAlarm());
 
+  UpdateProjection();
+
   PaintRadarBackground(canvas);
   PaintRadarTraffic(canvas);
 }
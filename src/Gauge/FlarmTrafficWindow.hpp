@@ -26,6 +26,7 @@
 
 #include "Screen/PaintWindow.hpp"
 #include "FLARM/List.hpp"
+#include "FLARM/TrafficColumns.hpp"
 #include "FLARM/Color.hpp"
 #include "TeamCode/Settings.hpp"
 #include "Math/FastRotation.hpp"
@@ -63,13 +64,40 @@ protected:
 
   bool small;
 
+  /**
+   * The screen coordinates of all targets, see UpdateProjection().
+   */
   RasterPoint sc[TrafficList::MAX_COUNT];
 
+  /**
+   * Is #sc up to date?  Must be cleared whenever #data, #distance,
+   * #radius, #heading or #enable_north_up changes.
+   */
+  bool projection_valid;
+
   bool enable_north_up;
   Angle heading;
   FastRotation fr;
   FastIntegerRotation fir;
   TrafficList data;
+
+  /**
+   * A column-oriented copy of #data.
+   */
+  TrafficColumns columns;
+
+  /**
+   * The team color of each target in #data.
+   */
+  FlarmColor colors[TrafficList::MAX_COUNT];
+
+  /**
+   * The indices of all targets with an alarm, by increasing threat.
+   * These are painted last, so the most critical target is on top.
+   */
+  uint8_t alarm_order[TrafficList::MAX_COUNT];
+  unsigned n_alarms;
+
   TeamCodeSettings settings;
 
 public:
@@ -108,6 +136,7 @@ public:
 
   void SetDistance(fixed _distance) {
     distance = _distance;
+    projection_valid = false;
     Invalidate();
   }
 
@@ -118,6 +147,13 @@ protected:
 
   void UpdateSelector(const FlarmId id, const RasterPoint pt);
   void UpdateWarnings();
+
+  /**
+   * Calculate the screen coordinates of all targets (#sc), unless
+   * they are still valid.
+   */
+  void UpdateProjection();
+
   void Update(Angle new_direction, const TrafficList &new_data,
               const TeamCodeSettings &new_settings);
   void PaintRadarNoTraffic(Canvas &canvas) const;
@@ -157,6 +157,16 @@ public:
     --bb_ll.latitude;
     ++bb_ur.latitude;
   }
+
+  /**
+   * Expand the border by the specified amount
+   */
+  void Grow(int amount) {
+    bb_ll.longitude -= amount;
+    bb_ur.longitude += amount;
+    bb_ll.latitude -= amount;
+    bb_ur.latitude += amount;
+  }
 };
 
 #endif
@@ -29,22 +29,37 @@ Copyright_License {
 
 #include <assert.h>
 
+IGCWriter::FileWriter::FileWriter(const TCHAR *path)
+  :AsyncTextWriter(path), sign(false)
+{
+  grecord.Initialize();
+}
+
+void
+IGCWriter::FileWriter::OnLine(const char *line)
+{
+  grecord.AppendRecordToBuffer(line);
+}
+
+void
+IGCWriter::FileWriter::OnClose(TextWriter &file)
+{
+  if (sign) {
+    grecord.FinalizeBuffer();
+    grecord.WriteTo(file);
+  }
+}
+
 IGCWriter::IGCWriter(const TCHAR *path)
   :file(path)
 {
   fix.Clear();
-
-  grecord.Initialize();
 }
 
 bool
 IGCWriter::CommitLine(char *line)
 {
-  if (!file.WriteLine(line))
-    return false;
-
-  grecord.AppendRecordToBuffer(line);
-  return true;
+  return file.WriteLine(line);
 }
 
 bool
@@ -208,7 +223,6 @@ IGCWriter::LogPoint(const IGCFix &fix, int epe, int satellites)
           epe, satellites);
 
   WriteLine(b_record);
-  Flush();
 }
 
 void
@@ -271,11 +285,3 @@ IGCWriter::LogFRecord(const BrokenTime &time, const int *satellite_ids)
   WriteLine(f_record);
 }
 
-void
-IGCWriter::Sign()
-{
-  assert(file.IsOpen());
-
-  grecord.FinalizeBuffer();
-  grecord.WriteTo(file);
-}
@@ -25,9 +25,9 @@ Copyright_License {
 #define XCSOAR_IGC_WRITER_HPP
 
 #include "Logger/GRecord.hpp"
+#include "Logger/AsyncTextWriter.hpp"
 #include "Math/fixed.hpp"
 #include "IGCFix.hpp"
-#include "IO/TextWriter.hpp"
 
 #include <tchar.h>
 
@@ -41,9 +41,37 @@ class IGCWriter {
     MAX_IGC_BUFF = 255,
   };
 
-  TextWriter file;
+  /**
+   * Writes the IGC file in a background thread, and calculates the G
+   * record there.
+   */
+  class FileWriter final : public AsyncTextWriter {
+    GRecord grecord;
+
+    bool sign;
+
+  public:
+    FileWriter(const TCHAR *path);
+
+    ~FileWriter() {
+      Close();
+    }
+
+    /**
+     * Append the G record and close the file.
+     */
+    void Sign() {
+      sign = true;
+      Close();
+    }
+
+  protected:
+    /* virtual methods from class AsyncTextWriter */
+    void OnLine(const char *line) override;
+    void OnClose(TextWriter &file) override;
+  };
 
-  GRecord grecord;
+  FileWriter file;
 
   IGCFix fix;
 
@@ -59,11 +87,30 @@ public:
     return file.IsOpen();
   }
 
-  bool Flush() {
-    return file.Flush();
+  /**
+   * Ask the writer thread to write all pending lines to the file.
+   * This method does not block.
+   */
+  void Flush() {
+    file.Flush();
+  }
+
+  /**
+   * Append the G record and close the file.  This waits for the
+   * writer thread to finish.  No more lines can be written after
+   * this call.
+   */
+  void Sign() {
+    file.Sign();
   }
 
-  void Sign();
+  /**
+   * Returns the number of lines which were lost because the writer
+   * thread did not keep up.
+   */
+  unsigned GetDroppedLines() const {
+    return file.GetDroppedLines();
+  }
 
 private:
   /**
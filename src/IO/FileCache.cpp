@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "FileCache.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/FileMapping.hpp"
 #include "OS/PathName.hpp"
 #include "Compatibility/path.h"
 #include "Compiler.h"
@@ -122,6 +123,9 @@ GetRegularFileInfo(const TCHAR *path, FileInfo &info)
 #endif
 }
 
+const size_t FileCache::DATA_OFFSET =
+  sizeof(FILE_CACHE_MAGIC) + sizeof(FileInfo);
+
 FileCache::FileCache(const TCHAR *_cache_path)
   :cache_path(_tcsdup(_cache_path)), cache_path_length(_tcslen(_cache_path)) {}
 
@@ -191,6 +195,26 @@ FileCache::Load(const TCHAR *name, const TCHAR *original_path)
   return file;
 }
 
+FileMapping *
+FileCache::Map(const TCHAR *name, const TCHAR *original_path)
+{
+  /* let Load() validate the file */
+  FILE *file = Load(name, original_path);
+  if (file == NULL)
+    return NULL;
+
+  fclose(file);
+
+  TCHAR path[PathBufferSize(name)];
+  FileMapping *mapping = new FileMapping(MakeCachePath(path, name));
+  if (mapping->error() || mapping->size() < DATA_OFFSET) {
+    delete mapping;
+    return NULL;
+  }
+
+  return mapping;
+}
+
 FILE *
 FileCache::Save(const TCHAR *name, const TCHAR *original_path)
 {
@@ -27,6 +27,8 @@ Copyright_License {
 #include <stdio.h>
 #include <tchar.h>
 
+class FileMapping;
+
 class FileCache {
   TCHAR *cache_path;
   size_t cache_path_length;
@@ -43,6 +45,20 @@ public:
   void Flush(const TCHAR *name);
   FILE *Load(const TCHAR *name, const TCHAR *original_path);
 
+  /**
+   * The offset of the cached data within the file, i.e. the size of
+   * the header written by Save().
+   */
+  static const size_t DATA_OFFSET;
+
+  /**
+   * Like Load(), but map the cache file into memory instead of
+   * opening it.  The cached data begins at #DATA_OFFSET.
+   *
+   * @return the mapping or nullptr if there is no valid cache file
+   */
+  FileMapping *Map(const TCHAR *name, const TCHAR *original_path);
+
   FILE *Save(const TCHAR *name, const TCHAR *original_path);
   bool Commit(const TCHAR *name, FILE *file);
   void Cancel(const TCHAR *name, FILE *file);
@@ -0,0 +1,67 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MemoryLineReader.hpp"
+
+#include <string.h>
+
+char *
+MemoryLineReaderA::ReadLine()
+{
+  if (position >= end)
+    return nullptr;
+
+  const char *line = position;
+  const char *eol = (const char *)memchr(line, '\n', end - line);
+  if (eol != nullptr) {
+    position = eol + 1;
+
+    /* purge trailing carriage return characters */
+    while (eol > line && eol[-1] == '\r')
+      --eol;
+  } else
+    /* last line, not terminated by a line feed */
+    eol = position = end;
+
+  const size_t length = eol - line;
+  char *dest = buffer.get(length + 1);
+  if (dest == nullptr)
+    /* allocation has failed */
+    return nullptr;
+
+  memcpy(dest, line, length);
+  dest[length] = 0;
+  return dest;
+}
+
+long
+MemoryLineReaderA::GetSize() const
+{
+  return end - begin;
+}
+
+long
+MemoryLineReaderA::Tell() const
+{
+  return position - begin;
+}
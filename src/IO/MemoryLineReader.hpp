@@ -0,0 +1,51 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_MEMORY_LINE_READER_HPP
+#define XCSOAR_IO_MEMORY_LINE_READER_HPP
+
+#include "LineReader.hpp"
+#include "Util/ReusableArray.hpp"
+
+/**
+ * Reads lines from a (read-only) memory buffer, e.g. a #FileMapping.
+ * Line endings are handled like #LineSplitter does.  Each line is
+ * copied to an internal buffer, to be able to append the null byte.
+ */
+class MemoryLineReaderA : public NLineReader {
+  const char *const begin, *const end;
+  const char *position;
+
+  ReusableArray<char> buffer;
+
+public:
+  MemoryLineReaderA(const char *_begin, const char *_end)
+    :begin(_begin), end(_end), position(_begin) {}
+
+  /* virtual methods from class NLineReader */
+  virtual char *ReadLine() override;
+  virtual long GetSize() const override;
+  virtual long Tell() const override;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AsyncTextWriter.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+#include <string.h>
+
+AsyncTextWriter::AsyncTextWriter(const TCHAR *path, bool append,
+                                 unsigned _flush_interval)
+  :StandbyThread("AsyncTextWriter"),
+   file(path, append),
+   flush_interval(_flush_interval),
+   dropped_lines(0),
+   closed(false)
+{
+  pending.reserve(BUFFER_SIZE);
+  writing.reserve(BUFFER_SIZE);
+}
+
+bool
+AsyncTextWriter::WriteLine(const char *line)
+{
+  if (!file.IsOpen())
+    return false;
+
+  const size_t length = strlen(line) + 1;
+
+  ScopeLock protect(mutex);
+  if (closed)
+    return false;
+
+  const size_t old_size = pending.size();
+  if (length > MAX_BUFFER_SIZE - old_size) {
+    /* the thread does not keep up with the writes; it has been
+       woken up long ago, so there's nothing else to do */
+    ++dropped_lines;
+    return false;
+  }
+
+  pending.insert(pending.end(), line, line + length);
+
+  if (pending.size() >= BUFFER_SIZE / 2)
+    Trigger();
+  else if (old_size == 0)
+    /* this is the oldest line in the buffer: make sure it gets
+       written within the flush interval */
+    TriggerDelayed(flush_interval);
+
+  return true;
+}
+
+void
+AsyncTextWriter::Flush()
+{
+  if (!file.IsOpen())
+    return;
+
+  ScopeLock protect(mutex);
+  if (!closed && !pending.empty())
+    Trigger();
+}
+
+void
+AsyncTextWriter::Close()
+{
+  ScopeLock protect(mutex);
+  if (closed)
+    return;
+
+  closed = true;
+
+  if (file.IsOpen()) {
+    Trigger();
+    WaitDone();
+    Stop();
+  }
+}
+
+void
+AsyncTextWriter::Tick()
+{
+  std::swap(pending, writing);
+  assert(pending.empty());
+
+  const bool close = closed;
+
+  mutex.Unlock();
+
+  for (const char *p = writing.data(), *end = p + writing.size();
+       p != end; p += strlen(p) + 1) {
+    file.WriteLine(p);
+    OnLine(p);
+  }
+
+  writing.clear();
+
+  if (close)
+    OnClose(file);
+
+  file.Flush();
+
+  mutex.Lock();
+}
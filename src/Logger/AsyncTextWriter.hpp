@@ -0,0 +1,159 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ASYNC_TEXT_WRITER_HPP
+#define XCSOAR_ASYNC_TEXT_WRITER_HPP
+
+#include "IO/TextWriter.hpp"
+#include "Thread/StandbyThread.hpp"
+
+#include <vector>
+
+#include <tchar.h>
+#include <stddef.h>
+
+/**
+ * A text file writer which moves all file I/O to a separate thread.
+ * WriteLine() only copies the line into a memory buffer; the thread
+ * picks up all buffered lines at once, writes them and flushes the
+ * file.  This is done when the buffer is half full, when the oldest
+ * buffered line has waited for the flush interval, after Flush() and
+ * in Close().  Callers never wait for the file system, except in
+ * Close().
+ *
+ * If the file system is slow, the buffer grows up to
+ * #MAX_BUFFER_SIZE.  Lines which do not fit are discarded and
+ * counted, see GetDroppedLines().
+ *
+ * Subclasses may override OnLine() and OnClose() to process the
+ * lines in the writer thread.  They must call Close() in their
+ * destructor.
+ */
+class AsyncTextWriter : private StandbyThread {
+  /**
+   * The initial buffer size.  The thread is woken up as soon as half
+   * of it is filled.
+   */
+  static constexpr size_t BUFFER_SIZE = 16384;
+
+  /**
+   * The upper limit for the buffer while the thread is busy writing.
+   */
+  static constexpr size_t MAX_BUFFER_SIZE = 1024 * 1024;
+
+  TextWriter file;
+
+  /**
+   * The lines submitted by WriteLine(), each one null-terminated.
+   * Protected by the mutex.
+   */
+  std::vector<char> pending;
+
+  /**
+   * The buffer which is being written by the thread.  It gets
+   * swapped with #pending each time the thread wakes up.
+   */
+  std::vector<char> writing;
+
+  /**
+   * The maximum duration [ms] a line may stay in the buffer.
+   */
+  const unsigned flush_interval;
+
+  /**
+   * The number of lines discarded by WriteLine() because the buffer
+   * was full.  Protected by the mutex.
+   */
+  unsigned dropped_lines;
+
+  /**
+   * Has Close() been called?  Protected by the mutex.
+   */
+  bool closed;
+
+public:
+  /**
+   * Open the file.  The caller must check IsOpen().
+   *
+   * @param flush_interval the maximum duration [ms] a line may stay
+   * in memory before it gets written to the file
+   */
+  AsyncTextWriter(const TCHAR *path, bool append=false,
+                  unsigned flush_interval=5000);
+
+  ~AsyncTextWriter() {
+    Close();
+  }
+
+  bool IsOpen() const {
+    return file.IsOpen();
+  }
+
+  /**
+   * Append a line to the buffer.  This method does not block.
+   *
+   * @return false if the file is not open, if it has been closed
+   * already, or if the line was dropped because the buffer is full
+   */
+  bool WriteLine(const char *line);
+
+  /**
+   * Ask the thread to write all buffered lines and flush the file.
+   * This method does not block.
+   */
+  void Flush();
+
+  /**
+   * Write all buffered lines, invoke OnClose() and stop the thread.
+   * This method blocks until the thread has finished.  It is a no-op
+   * if the writer is already closed.
+   */
+  void Close();
+
+  /**
+   * Returns the number of lines which were discarded because the
+   * buffer was full.
+   */
+  unsigned GetDroppedLines() const {
+    ScopeLock protect(const_cast<Mutex &>(mutex));
+    return dropped_lines;
+  }
+
+protected:
+  /**
+   * Called by the writer thread after a line has been written.
+   */
+  virtual void OnLine(const char *line) {}
+
+  /**
+   * Called by the writer thread in Close(), after all lines have been
+   * written.  The implementation may write trailing data.
+   */
+  virtual void OnClose(TextWriter &file) {}
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() override;
+};
+
+#endif
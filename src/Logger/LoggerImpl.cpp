@@ -103,6 +103,10 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
 
   LogFormat(_T("Logger stopped: %s"), filename);
 
+  const unsigned dropped_lines = writer->GetDroppedLines();
+  if (dropped_lines > 0)
+    LogFormat(_T("Logger dropped %u lines"), dropped_lines);
+
   // Logger off
   delete writer;
   writer = nullptr;
@@ -22,8 +22,9 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "IO/TextWriter.hpp"
+#include "Logger/AsyncTextWriter.hpp"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "Time/BrokenDateTime.hpp"
 #include "Thread/Mutex.hpp"
 #include "OS/FileUtil.hpp"
@@ -35,7 +36,7 @@ Copyright_License {
 namespace NMEALogger
 {
   static Mutex mutex;
-  static TextWriter *writer;
+  static AsyncTextWriter *writer;
 
   bool enabled = false;
 
@@ -62,13 +63,21 @@ NMEALogger::Start()
 
   LocalPath(path, _T("logs"), name);
 
-  writer = new TextWriter(path, false);
+  writer = new AsyncTextWriter(path, false);
   return writer != nullptr;
 }
 
 void
 NMEALogger::Shutdown()
 {
+  if (writer != nullptr) {
+    writer->Close();
+
+    const unsigned dropped_lines = writer->GetDroppedLines();
+    if (dropped_lines > 0)
+      LogFormat(_T("NMEA logger dropped %u lines"), dropped_lines);
+  }
+
   delete writer;
 }
 
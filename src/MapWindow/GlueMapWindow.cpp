@@ -207,7 +207,7 @@ GlueMapWindow::Idle()
   clock.Update();
 
   bool still_dirty;
-  bool topography_dirty = true; /* scan topography in every Idle() call */
+  bool topography_dirty = true;
   bool terrain_dirty = true;
   bool weather_dirty = true;
 
@@ -215,10 +215,15 @@ GlueMapWindow::Idle()
     idle_robin = (idle_robin + 1) % 3;
     switch (idle_robin) {
     case 0:
-      topography_dirty = UpdateTopography(1) > 0;
+      /* topography shapes are loaded by a background thread, just
+         like terrain tiles */
+      topography_dirty = UpdateTopography();
       break;
 
     case 1:
+      /* terrain tiles are loaded by a background thread; don't spin
+         here while it's busy, but keep Idle() dirty until it's
+         done */
       terrain_dirty = UpdateTerrain();
       break;
 
@@ -227,7 +232,7 @@ GlueMapWindow::Idle()
       break;
     }
 
-    still_dirty = terrain_dirty || topography_dirty || weather_dirty;
+    still_dirty = weather_dirty;
   } while (!clock.Check(700) && /* stop after 700ms */
 #ifndef ENABLE_OPENGL
            !draw_thread->IsTriggered() &&
@@ -235,5 +240,5 @@ GlueMapWindow::Idle()
            IsUserIdle(2500) &&
            still_dirty);
 
-  return still_dirty;
+  return still_dirty || topography_dirty || terrain_dirty;
 }
@@ -234,6 +234,7 @@ private:
                      const NMEAInfo &info) const;
   void DrawCrossHairs(Canvas &canvas) const;
   void DrawPanInfo(Canvas &canvas) const;
+  void DrawProfiler(Canvas &canvas) const;
   void DrawThermalBand(Canvas &canvas, const PixelRect &rc) const;
   void DrawFinalGlide(Canvas &canvas, const PixelRect &rc) const;
   void DrawVario(Canvas &canvas, const PixelRect &rc) const;
@@ -33,6 +33,7 @@ Copyright_License {
 #include "Pan.hpp"
 #include "Util/Clamp.hpp"
 #include "Event/Idle.hpp"
+#include "Profiler/Profiler.hpp"
 
 #ifdef ENABLE_SDL
 #include <SDL_keyboard.h>
@@ -377,6 +378,8 @@ GlueMapWindow::OnPaint(Canvas &canvas)
 void
 GlueMapWindow::OnPaintBuffer(Canvas &canvas)
 {
+  const Profiler::ScopeTimer timer(Profiler::Stage::DRAW);
+
 #ifdef ENABLE_OPENGL
   ExchangeBlackboard();
 
@@ -396,6 +399,9 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas)
   if (IsPanning())
     DrawPanInfo(canvas);
 
+  if (Profiler::IsEnabled())
+    DrawProfiler(canvas);
+
 #ifdef ENABLE_OPENGL
   LeaveDrawThread();
 #endif
@@ -446,6 +452,7 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   if (IsNearSelf()) {
     draw_sw.Mark("DrawGlueMisc");
+    const Profiler::ScopeTimer timer(Profiler::Stage::OVERLAYS);
     if (GetMapSettings().show_thermal_profile)
       DrawThermalBand(canvas, rc);
     DrawStallRatio(canvas, rc);
@@ -40,6 +40,7 @@ Copyright_License {
 #include "Util/Clamp.hpp"
 #include "Look/GestureLook.hpp"
 #include "Input/InputEvents.hpp"
+#include "Profiler/Profiler.hpp"
 
 #include <stdio.h>
 
@@ -146,6 +147,56 @@ GlueMapWindow::DrawPanInfo(Canvas &canvas) const
   }
 }
 
+void
+GlueMapWindow::DrawProfiler(Canvas &canvas) const
+{
+  /* show the average per frame / per calculation cycle over the last
+     two seconds */
+  const uint64_t now = MonotonicClockUS();
+  const uint64_t since = now > 2000000 ? now - 2000000 : 0;
+
+  TextInBoxMode mode;
+  mode.shape = LabelShape::OUTLINED;
+
+  const Font &font = *look.overlay_font;
+  canvas.Select(font);
+
+  const UPixelScalar padding = Layout::FastScale(4);
+  const UPixelScalar height = font.GetHeight();
+  const PixelScalar x = padding;
+  PixelScalar y = padding;
+
+  for (unsigned c = 0; c < Profiler::N_CHANNELS; ++c) {
+    const Profiler::Channel channel = Profiler::Channel(c);
+    const Profiler::Stage root = Profiler::GetRootStage(channel);
+
+    Profiler::Summary summary;
+    Profiler::Summarise(channel, since, summary);
+    if (summary.n_roots == 0)
+      continue;
+
+    for (unsigned i = 0; i < Profiler::N_STAGES; ++i) {
+      const Profiler::Stage stage = Profiler::Stage(i);
+      if (Profiler::GetChannel(stage) != channel)
+        continue;
+
+      const unsigned average = summary.GetAverage(stage);
+      if (average < 100 && stage != root)
+        continue;
+
+      StaticString<64> buffer;
+      buffer.Format(stage == root ? _T("%s %u.%u ms") : _T("  %s %u.%u"),
+                    Profiler::GetName(stage),
+                    average / 1000, average / 100 % 10);
+
+      TextInBox(canvas, buffer, x, y, mode,
+                render_projection.GetScreenWidth(),
+                render_projection.GetScreenHeight());
+      y += height;
+    }
+  }
+}
+
 void
 GlueMapWindow::DrawGPSStatus(Canvas &canvas, const PixelRect &rc,
                              const NMEAInfo &info) const
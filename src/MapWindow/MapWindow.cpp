@@ -28,11 +28,14 @@ Copyright_License {
 #include "Terrain/RasterWeather.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Operation/Operation.hpp"
+#include "Geo/Math.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scissor.hpp"
 #endif
 
+#include <algorithm>
+
 /**
  * Constructor of the MapWindow class
  */
@@ -122,13 +125,45 @@ MapWindow::ReadBlackboard(const MoreData &nmea_info,
   ReadMapSettings(settings_map);
 }
 
-unsigned
-MapWindow::UpdateTopography(unsigned max_update)
+/**
+ * Returns the screen bounds, extended by the area which will become
+ * visible within the next minute if the map follows the aircraft.
+ */
+gcc_pure
+static GeoBounds
+PredictScreenBounds(const WindowProjection &projection,
+                    const NMEAInfo &basic, bool follow_aircraft)
+{
+  GeoBounds bounds = projection.GetScreenBounds();
+  if (!follow_aircraft || !basic.track_available ||
+      !basic.MovementDetected())
+    return bounds;
+
+  /* don't look ahead further than half a screen, or the prediction
+     would load more shapes than it saves */
+  const fixed distance = std::min(basic.ground_speed * 60,
+                                  projection.GetScreenWidthMeters() / 2);
+
+  const GeoPoint center = projection.GetGeoScreenCenter();
+  const GeoPoint delta =
+    FindLatitudeLongitude(center, basic.track, distance) - center;
+
+  GeoBounds predicted = bounds;
+  predicted.Extend(bounds.GetNorthWest() + delta);
+  predicted.Extend(bounds.GetSouthEast() + delta);
+  return predicted;
+}
+
+bool
+MapWindow::UpdateTopography()
 {
-  if (topography != nullptr && GetMapSettings().topography_enabled)
-    return topography->ScanVisibility(visible_projection, max_update);
-  else
-    return 0;
+  if (topography == nullptr || !GetMapSettings().topography_enabled)
+    return false;
+
+  topography_updater.Request(visible_projection.GetMapScale(),
+                             PredictScreenBounds(visible_projection, Basic(),
+                                                 IsNearSelf()));
+  return topography_updater.IsBusy();
 }
 
 bool
@@ -141,20 +176,15 @@ MapWindow::UpdateTerrain()
   fixed radius = visible_projection.GetScreenWidthMeters() / 2;
   if (terrain_radius >= radius && terrain_center.IsValid() &&
       terrain_center.Distance(location) < fixed(1000))
-    return false;
+    return terrain_loader.IsBusy();
 
   // always service terrain even if it's not used by the map,
   // because it's used by other calculations
-  RasterTerrain::ExclusiveLease lease(*terrain);
-  lease->SetViewCenter(location, radius);
-  if (lease->IsDirty())
-    terrain_radius = fixed(0);
-  else {
-    terrain_radius = radius;
-    terrain_center = location;
-  }
-
-  return lease->IsDirty();
+  terrain_loader.Request(location, radius);
+  terrain_radius = radius;
+  terrain_center = location;
+
+  return true;
 }
 
 bool
@@ -202,6 +232,8 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
 void
 MapWindow::SetTopography(TopographyStore *_topography)
 {
+  /* wait for the TopographyUpdater to release the old store */
+  topography_updater.SetStore(_topography);
   topography = _topography;
 
   delete topography_renderer;
@@ -213,6 +245,7 @@ MapWindow::SetTopography(TopographyStore *_topography)
 void
 MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
+  terrain_loader.SetTerrain(_terrain);
   terrain = _terrain;
   terrain_center = GeoPoint::Invalid();
   background.SetTerrain(_terrain);
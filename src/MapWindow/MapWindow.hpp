@@ -36,6 +36,8 @@ Copyright_License {
 #include "Renderer/BackgroundRenderer.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Terrain/TerrainTileLoader.hpp"
+#include "Topography/TopographyUpdater.hpp"
 #include "Compiler.h"
 #include "Weather/Features.hpp"
 #include "Tracking/SkyLines/Features.hpp"
@@ -116,10 +118,22 @@ protected:
   TopographyStore *topography;
   CachedTopographyRenderer *topography_renderer;
 
+  /**
+   * Loads topography shapes in background, so the renderer doesn't
+   * have to wait for it.
+   */
+  TopographyUpdater topography_updater;
+
   RasterTerrain *terrain;
   GeoPoint terrain_center;
   fixed terrain_radius;
 
+  /**
+   * Decodes terrain tiles in background, so the draw thread and the
+   * calculation thread don't have to wait for it.
+   */
+  TerrainTileLoader terrain_loader;
+
   RasterWeather *weather;
 
   const TrafficLook &traffic_look;
@@ -290,10 +304,18 @@ protected:
    */
   virtual void Render(Canvas &canvas, const PixelRect &rc);
 
-  unsigned UpdateTopography(unsigned max_update=1024);
+  /**
+   * Submit the current view (extended in the direction of flight) to
+   * the #TopographyUpdater.
+   *
+   * @return true if the #TopographyUpdater is still busy
+   */
+  bool UpdateTopography();
 
   /**
-   * @return true if UpdateTerrain() should be called again
+   * Submit the current view to the #TerrainTileLoader.
+   *
+   * @return true if the #TerrainTileLoader is still busy
    */
   bool UpdateTerrain();
 
@@ -67,7 +67,9 @@ MapWindow::OnDestroy()
   airspace_renderer.Clear();
   SetWaypoints(nullptr);
   SetTopography(nullptr);
+  topography_updater.Stop();
   SetTerrain(nullptr);
+  terrain_loader.Stop();
   SetWeather(nullptr);
 
 #ifndef ENABLE_OPENGL
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/MarkerRenderer.hpp"
+#include "Profiler/Profiler.hpp"
 
 #ifdef HAVE_NOAA
 #include "Weather/NOAAStore.hpp"
@@ -133,45 +134,59 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   if (basic.location_available)
       aircraft_pos = render_projection.GeoToScreen(basic.location);
 
+  Profiler::StageTimer timer;
+
   // Render terrain, groundline and topography
   draw_sw.Mark("RenderTerrain");
+  timer.Mark(Profiler::Stage::TERRAIN);
   RenderTerrain(canvas);
 
   draw_sw.Mark("RenderTopography");
+  timer.Mark(Profiler::Stage::TOPOGRAPHY);
   RenderTopography(canvas);
 
   draw_sw.Mark("RenderFinalGlideShading");
+  timer.Mark(Profiler::Stage::TERRAIN_ABOVE);
   RenderFinalGlideShading(canvas);
 
   // Render track bearing (projected track ground/air relative)
   draw_sw.Mark("DrawTrackBearing");
+  timer.Mark(Profiler::Stage::TRACK_BEARING);
   RenderTrackBearing(canvas, aircraft_pos);
 
   // Render airspace
   draw_sw.Mark("RenderAirspace");
+  timer.Mark(Profiler::Stage::AIRSPACE);
   RenderAirspace(canvas);
 
   // Render task, waypoints
   draw_sw.Mark("DrawContest");
+  timer.Mark(Profiler::Stage::CONTEST);
   DrawContest(canvas);
 
   draw_sw.Mark("DrawTask");
+  timer.Mark(Profiler::Stage::TASK);
   DrawTask(canvas);
 
   draw_sw.Mark("DrawWaypoints");
+  timer.Mark(Profiler::Stage::WAYPOINTS);
   DrawWaypoints(canvas);
 
   draw_sw.Mark("DrawNOAAStations");
+  timer.Mark(Profiler::Stage::WEATHER);
   RenderNOAAStations(canvas);
 
   draw_sw.Mark("RenderMisc1");
+  timer.Mark(Profiler::Stage::MISC);
   // Render weather/terrain max/min values
   DrawTaskOffTrackIndicator(canvas);
 
   // Render the snail trail
+  timer.Mark(Profiler::Stage::TRAIL);
   if (basic.location_available)
     RenderTrail(canvas, aircraft_pos);
 
+  timer.Mark(Profiler::Stage::MISC);
   RenderMarkers(canvas);
 
   // Render estimate of thermal location
@@ -179,13 +194,16 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   // Render topography on top of airspace, to keep the text readable
   draw_sw.Mark("RenderTopographyLabels");
+  timer.Mark(Profiler::Stage::TOPOGRAPHY_LABELS);
   RenderTopographyLabels(canvas);
 
   // Render glide through terrain range
   draw_sw.Mark("RenderGlide");
+  timer.Mark(Profiler::Stage::GLIDE);
   RenderGlide(canvas);
 
   draw_sw.Mark("RenderMisc2");
+  timer.Mark(Profiler::Stage::MISC);
 
   DrawBestCruiseTrack(canvas, aircraft_pos);
 
@@ -196,6 +214,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
     DrawWind(canvas, aircraft_pos, rc);
 
   // Draw traffic
+  timer.Mark(Profiler::Stage::TRAFFIC);
 
 #ifdef HAVE_SKYLINES_TRACKING_HANDLER
   DrawSkyLinesTraffic(canvas);
@@ -207,6 +226,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
     DrawFLARMTraffic(canvas, aircraft_pos);
 
   // Finally, draw you!
+  timer.Mark(Profiler::Stage::MISC);
   if (basic.location_available)
     AircraftRenderer::Draw(canvas, GetMapSettings(), look.aircraft,
                            basic.attitude.heading - render_projection.GetScreenAngle(),
@@ -68,6 +68,9 @@ MergeThread::Tick()
   {
     ScopeLock protect(device_blackboard.mutex);
 
+    /* pick up the data which was parsed by the port threads */
+    AllDevicesCollectData();
+
     Process();
 
     const MoreData &basic = device_blackboard.Basic();
@@ -21,41 +21,16 @@ Copyright_License {
 }
 */
 
-#ifndef XCSOAR_KDTREE_MATH_HPP
-#define XCSOAR_KDTREE_MATH_HPP
-
-#include "Math/FastMath.h"
-
-#include <math.h>
-
-namespace KDTree
-{
-  /**
-   * This overloads the math.h function, and maps it to isqrt4().
-   */
-  gcc_const
-  static inline unsigned int sqrt(unsigned long val)
-  {
-    return ::isqrt4(val);
-  }
-
-  /**
-   * This overloads the math.h function, and maps it to isqrt4().
-   */
-  gcc_const
-  static inline int sqrt(int val)
-  {
-    return ::isqrt4(val);
-  }
-
-  /**
-   * Import the math.h function into this namespace.
-   */
-  gcc_const
-  static inline double sqrt(double val)
-  {
-    return ::sqrt(val);
-  }
-} // namespace KDTree
-
-#endif // include guard
+#ifndef XCSOAR_OS_CPU_HPP
+#define XCSOAR_OS_CPU_HPP
+
+#include "Compiler.h"
+
+/**
+ * Returns the number of CPU cores which are online (at least 1).
+ */
+gcc_pure
+unsigned
+GetProcessorCount();
+
+#endif
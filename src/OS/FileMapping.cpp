@@ -65,11 +65,13 @@ FileMapping::FileMapping(const TCHAR *path)
 
   m_size = (size_t)st.st_size;
 
-  m_data = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  void *data = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
   close(fd);
-  if (m_data == NULL)
+  if (data == MAP_FAILED)
     return;
 
+  m_data = data;
+
   madvise(m_data, m_size, MADV_WILLNEED);
 #else /* !HAVE_POSIX */
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x0500
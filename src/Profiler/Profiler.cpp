@@ -0,0 +1,271 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Profiler.hpp"
+#include "IO/TextWriter.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Util/Macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <assert.h>
+
+namespace Profiler {
+  /**
+   * The capacity of each ring buffer.  Must be a power of two,
+   * because Ring::head wraps around.
+   */
+  static constexpr unsigned RING_SIZE = 2048;
+
+  /**
+   * A ring buffer which is written by exactly one thread and may be
+   * read by any thread.  The writer never waits for readers; instead,
+   * readers detect and discard samples which were overwritten while
+   * they were being copied.
+   */
+  class Ring {
+    static constexpr unsigned SIZE = RING_SIZE;
+
+    Sample samples[SIZE];
+
+    /**
+     * The number of samples which have been written so far.
+     */
+    std::atomic<unsigned> head;
+
+  public:
+    Ring():head(0) {}
+
+    void Push(const Sample &sample) {
+      const unsigned h = head.load(std::memory_order_relaxed);
+      samples[h % SIZE] = sample;
+      head.store(h + 1, std::memory_order_release);
+    }
+
+    unsigned Copy(Sample *dest, unsigned max) const;
+  };
+
+  bool enabled;
+
+  static Ring *rings[N_CHANNELS];
+
+  static constexpr const TCHAR *stage_names[] = {
+    _T("draw"),
+    _T("terrain"),
+    _T("topography"),
+    _T("terrain_above"),
+    _T("track_bearing"),
+    _T("airspace"),
+    _T("contest"),
+    _T("task"),
+    _T("waypoints"),
+    _T("weather"),
+    _T("trail"),
+    _T("topography_labels"),
+    _T("glide"),
+    _T("traffic"),
+    _T("misc"),
+    _T("overlays"),
+
+    _T("calculation"),
+    _T("read"),
+    _T("gps"),
+    _T("write"),
+    _T("idle"),
+    _T("air_data"),
+    _T("trace"),
+    _T("task"),
+    _T("route"),
+    _T("contest"),
+    _T("warning"),
+    _T("log"),
+  };
+
+  static_assert(ARRAY_SIZE(stage_names) == N_STAGES,
+                "Wrong number of stage names");
+
+  static constexpr const TCHAR *channel_names[] = {
+    _T("draw"),
+    _T("calculation"),
+  };
+
+  static_assert(ARRAY_SIZE(channel_names) == N_CHANNELS,
+                "Wrong number of channel names");
+}
+
+unsigned
+Profiler::Ring::Copy(Sample *dest, unsigned max) const
+{
+  const unsigned h1 = head.load(std::memory_order_acquire);
+  const unsigned n = std::min({h1, SIZE, max});
+  const unsigned begin = h1 - n;
+
+  for (unsigned i = 0; i < n; ++i)
+    dest[i] = samples[(begin + i) % SIZE];
+
+  /* the writer may have overwritten the oldest samples meanwhile
+     (including the one it is currently writing, which is not yet
+     published in "head") */
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const unsigned h2 = head.load(std::memory_order_relaxed);
+  const int overwritten = int(h2 + 1 - SIZE - begin);
+  if (overwritten <= 0)
+    return n;
+
+  if (unsigned(overwritten) >= n)
+    return 0;
+
+  std::copy(dest + overwritten, dest + n, dest);
+  return n - overwritten;
+}
+
+void
+Profiler::Enable()
+{
+  for (auto &ring : rings)
+    if (ring == nullptr)
+      ring = new Ring();
+
+  enabled = true;
+}
+
+void
+Profiler::Disable()
+{
+  enabled = false;
+
+  for (auto &ring : rings) {
+    delete ring;
+    ring = nullptr;
+  }
+}
+
+Profiler::Channel
+Profiler::GetChannel(Stage stage)
+{
+  return stage < Stage::CALCULATION
+    ? Channel::DRAW
+    : Channel::CALCULATION;
+}
+
+Profiler::Stage
+Profiler::GetRootStage(Channel channel)
+{
+  return channel == Channel::DRAW
+    ? Stage::DRAW
+    : Stage::CALCULATION;
+}
+
+const TCHAR *
+Profiler::GetName(Stage stage)
+{
+  assert(stage < Stage::COUNT);
+
+  return stage_names[unsigned(stage)];
+}
+
+const TCHAR *
+Profiler::GetName(Channel channel)
+{
+  return channel_names[unsigned(channel)];
+}
+
+void
+Profiler::Record(Stage stage, uint64_t start, uint64_t end)
+{
+  assert(stage < Stage::COUNT);
+  assert(end >= start);
+
+  Ring *ring = rings[unsigned(GetChannel(stage))];
+  if (ring == nullptr)
+    return;
+
+  Sample sample;
+  sample.start = start;
+  sample.duration = uint32_t(std::min<uint64_t>(end - start, 0xffffffff));
+  sample.stage = stage;
+  ring->Push(sample);
+}
+
+unsigned
+Profiler::Copy(Channel channel, Sample *dest, unsigned max)
+{
+  const Ring *ring = rings[unsigned(channel)];
+  return ring != nullptr
+    ? ring->Copy(dest, max)
+    : 0;
+}
+
+void
+Profiler::Summarise(Channel channel, uint64_t since, Summary &summary)
+{
+  summary.n_roots = 0;
+  std::fill_n(summary.totals, N_STAGES, 0);
+
+  AllocatedArray<Sample> samples(RING_SIZE);
+  const unsigned n = Copy(channel, samples.begin(), samples.size());
+  const Stage root = GetRootStage(channel);
+
+  for (unsigned i = 0; i < n; ++i) {
+    const Sample &sample = samples[i];
+    if (sample.start < since)
+      continue;
+
+    if (sample.stage == root)
+      ++summary.n_roots;
+
+    summary.totals[unsigned(sample.stage)] += sample.duration;
+  }
+}
+
+bool
+Profiler::Dump(const TCHAR *path)
+{
+  AllocatedArray<Sample> samples[N_CHANNELS];
+  unsigned n_samples[N_CHANNELS];
+  uint64_t oldest = UINT64_MAX;
+
+  for (unsigned c = 0; c < N_CHANNELS; ++c) {
+    samples[c].ResizeDiscard(RING_SIZE);
+    n_samples[c] = Copy(Channel(c), samples[c].begin(), samples[c].size());
+    if (n_samples[c] > 0)
+      oldest = std::min(oldest, samples[c][0].start);
+  }
+
+  TextWriter writer(path);
+  if (!writer.IsOpen())
+    return false;
+
+  for (unsigned c = 0; c < N_CHANNELS; ++c) {
+    for (unsigned i = 0; i < n_samples[c]; ++i) {
+      const Sample &sample = samples[c][i];
+      writer.FormatLine(_T("%s %s %lu %lu"),
+                        GetName(Channel(c)), GetName(sample.stage),
+                        (unsigned long)(sample.start - oldest),
+                        (unsigned long)sample.duration);
+    }
+  }
+
+  return writer.Flush();
+}
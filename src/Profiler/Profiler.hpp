@@ -0,0 +1,252 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_PROFILER_HPP
+#define XCSOAR_PROFILER_HPP
+
+#include "OS/Clock.hpp"
+#include "Compiler.h"
+
+#include <tchar.h>
+#include <stdint.h>
+
+/**
+ * A lightweight profiler which measures how much time is spent in the
+ * stages of map rendering and of the calculation thread.  It is
+ * disabled by default; when enabled (command line option "-timing"),
+ * each stage records a #Sample into a ring buffer.
+ *
+ * There is one ring buffer per #Channel, and each channel is written
+ * by only one thread (the one which draws the map, or the
+ * #CalculationThread), therefore recording needs no lock.
+ */
+namespace Profiler {
+  enum class Channel : uint8_t {
+    DRAW,
+    CALCULATION,
+  };
+
+  static constexpr unsigned N_CHANNELS = 2;
+
+  /**
+   * The first stage of each channel is its "root": it measures the
+   * whole frame or the whole calculation cycle.
+   */
+  enum class Stage : uint8_t {
+    DRAW,
+    TERRAIN,
+    TOPOGRAPHY,
+    TERRAIN_ABOVE,
+    TRACK_BEARING,
+    AIRSPACE,
+    CONTEST,
+    TASK,
+    WAYPOINTS,
+    WEATHER,
+    TRAIL,
+    TOPOGRAPHY_LABELS,
+    GLIDE,
+    TRAFFIC,
+    MISC,
+    OVERLAYS,
+
+    CALCULATION,
+    CALCULATION_READ,
+    CALCULATION_GPS,
+    CALCULATION_WRITE,
+    CALCULATION_IDLE,
+
+    /* the following stages are nested inside CALCULATION_GPS and
+       CALCULATION_IDLE; they break down the time spent in the
+       individual computers */
+    CALCULATION_AIR_DATA,
+    CALCULATION_TRACE,
+    CALCULATION_TASK,
+    CALCULATION_ROUTE,
+    CALCULATION_CONTEST,
+    CALCULATION_WARNING,
+    CALCULATION_LOG,
+
+    COUNT
+  };
+
+  static constexpr unsigned N_STAGES = unsigned(Stage::COUNT);
+
+  struct Sample {
+    /**
+     * The start time [us] (MonotonicClockUS()).
+     */
+    uint64_t start;
+
+    /**
+     * The duration [us].
+     */
+    uint32_t duration;
+
+    Stage stage;
+  };
+
+  /**
+   * Per-stage totals over a period of time, see Summarise().
+   */
+  struct Summary {
+    /**
+     * The number of root samples, i.e. frames or calculation
+     * cycles.
+     */
+    unsigned n_roots;
+
+    /**
+     * The total duration of each stage [us].
+     */
+    uint64_t totals[N_STAGES];
+
+    /**
+     * Returns the average duration [us] of the specified stage per
+     * frame or calculation cycle.
+     */
+    gcc_pure
+    unsigned GetAverage(Stage stage) const {
+      return n_roots > 0
+        ? unsigned(totals[unsigned(stage)] / n_roots)
+        : 0;
+    }
+  };
+
+  extern bool enabled;
+
+  static inline bool IsEnabled() {
+    return enabled;
+  }
+
+  /**
+   * Enable the profiler and allocate the ring buffers.  Must be
+   * called before the instrumented threads are started.
+   */
+  void Enable();
+
+  /**
+   * Disable the profiler and free the ring buffers.  Must not be
+   * called while the instrumented threads are running.
+   */
+  void Disable();
+
+  gcc_const
+  Channel GetChannel(Stage stage);
+
+  gcc_const
+  Stage GetRootStage(Channel channel);
+
+  gcc_const
+  const TCHAR *GetName(Stage stage);
+
+  gcc_const
+  const TCHAR *GetName(Channel channel);
+
+  /**
+   * Add a sample to the ring buffer of the stage's channel.  May only
+   * be called by the thread which owns the channel.
+   */
+  void Record(Stage stage, uint64_t start, uint64_t end);
+
+  /**
+   * Copy the most recent samples of a channel, oldest first.  This
+   * may be called from any thread; samples which are overwritten by
+   * the writer during the copy are omitted.
+   *
+   * @return the number of samples copied
+   */
+  unsigned Copy(Channel channel, Sample *dest, unsigned max);
+
+  /**
+   * Sum up the durations of all samples of a channel which were
+   * started at or after the specified time.
+   */
+  void Summarise(Channel channel, uint64_t since, Summary &summary);
+
+  /**
+   * Write the contents of all ring buffers to a text file, one sample
+   * per line: "CHANNEL STAGE START DURATION", where START is relative
+   * to the oldest sample and both times are in microseconds.
+   */
+  bool Dump(const TCHAR *path);
+
+  /**
+   * Measures the time until the object is destructed.
+   */
+  class ScopeTimer {
+    const Stage stage;
+    const uint64_t start;
+
+  public:
+    explicit ScopeTimer(Stage _stage)
+      :stage(_stage), start(IsEnabled() ? MonotonicClockUS() : 0) {}
+
+    ScopeTimer(const ScopeTimer &) = delete;
+
+    ~ScopeTimer() {
+      if (start != 0)
+        Record(stage, start, MonotonicClockUS());
+    }
+  };
+
+  /**
+   * Measures a sequence of stages: each Mark() call finishes the
+   * previous stage and begins a new one, similar to
+   * #ScreenStopWatch.
+   */
+  class StageTimer {
+    Stage stage;
+    uint64_t start;
+
+  public:
+    StageTimer():start(0) {}
+
+    StageTimer(const StageTimer &) = delete;
+
+    ~StageTimer() {
+      Finish();
+    }
+
+    void Mark(Stage _stage) {
+      if (!IsEnabled())
+        return;
+
+      const uint64_t now = MonotonicClockUS();
+      if (start != 0)
+        Record(stage, start, now);
+
+      stage = _stage;
+      start = now;
+    }
+
+    void Finish() {
+      if (start != 0) {
+        Record(stage, start, MonotonicClockUS());
+        start = 0;
+      }
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspacePolygonCache.hpp"
+#include "Screen/OpenGL/FallbackBuffer.hpp"
+#include "Screen/OpenGL/Triangulate.hpp"
+#include "Airspace/Airspaces.hpp"
+#include "Airspace/AirspacePolygon.hpp"
+#include "Math/Point2D.hpp"
+
+#include <algorithm>
+
+AirspacePolygonCache::Polygon::~Polygon()
+{
+  delete buffer;
+}
+
+AirspacePolygonCache::AirspacePolygonCache()
+  :airspaces(nullptr)
+{
+  AddSurfaceListener(*this);
+}
+
+AirspacePolygonCache::~AirspacePolygonCache()
+{
+  RemoveSurfaceListener(*this);
+}
+
+void
+AirspacePolygonCache::Update(const Airspaces &_airspaces)
+{
+  if (&_airspaces == airspaces && _airspaces.GetSerial() == serial)
+    return;
+
+  Clear();
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+}
+
+AirspacePolygonCache::Polygon *
+AirspacePolygonCache::Get(const AirspacePolygon &airspace)
+{
+  auto i = polygons.find(&airspace);
+  if (i != polygons.end())
+    return i->second.buffer != nullptr
+      ? &i->second
+      : nullptr;
+
+  /* create a new entry; it remains empty if this polygon cannot be
+     cached, so we don't retry in every frame */
+  Polygon &polygon = polygons[&airspace];
+
+  const SearchPointVector &points = airspace.GetPoints();
+  const unsigned n = points.size();
+  if (n < 3 || n >= 0x10000)
+    return nullptr;
+
+  polygon.bounds = airspace.GetGeoBounds();
+  polygon.reference = polygon.bounds.GetCenter();
+  polygon.n_vertices = n;
+
+  AllocatedArray<FloatPoint> vertices(n);
+  for (unsigned j = 0; j < n; ++j) {
+    const GeoPoint delta = points[j].GetLocation() - polygon.reference;
+    vertices[j] = FloatPoint(float(delta.longitude.Native()),
+                             float(delta.latitude.Native()));
+  }
+
+  /* triangulate with thinning disabled; the original vertices are
+     kept, because the polygon may be drawn at any zoom level */
+  polygon.indices.GrowDiscard(3 * (n - 2));
+  polygon.n_indices = PolygonToTriangles(vertices.begin(), n,
+                                         polygon.indices.begin(), 0);
+
+  polygon.buffer = new GLFallbackArrayBuffer();
+  void *data = polygon.buffer->BeginWrite(n * sizeof(FloatPoint));
+  std::copy_n(vertices.begin(), n, (FloatPoint *)data);
+  polygon.buffer->CommitWrite(n * sizeof(FloatPoint), data);
+
+  return &polygon;
+}
+
+void
+AirspacePolygonCache::SurfaceCreated()
+{
+}
+
+void
+AirspacePolygonCache::SurfaceDestroyed()
+{
+  Clear();
+}
+
+#endif /* ENABLE_OPENGL */
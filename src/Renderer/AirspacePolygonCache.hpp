@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_POLYGON_CACHE_HPP
+#define XCSOAR_AIRSPACE_POLYGON_CACHE_HPP
+
+#include "Screen/OpenGL/Surface.hpp"
+#include "Screen/OpenGL/System.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Util/Serial.hpp"
+
+#include <unordered_map>
+
+class Airspaces;
+class AbstractAirspace;
+class AirspacePolygon;
+class GLFallbackArrayBuffer;
+
+/**
+ * Caches the vertices and the triangulation of airspace polygons for
+ * the OpenGL renderer, so they need to be neither projected nor
+ * triangulated again in each frame.  The vertices are stored in an
+ * OpenGL buffer in geographic coordinates (relative to a reference
+ * point), and the map projection is applied by the OpenGL matrix.
+ *
+ * Entries are created when an airspace is drawn for the first time,
+ * and the whole cache is discarded when the #Airspaces object is
+ * modified.
+ */
+class AirspacePolygonCache final : GLSurfaceListener {
+public:
+  struct Polygon {
+    GeoBounds bounds;
+
+    /**
+     * The vertices are relative to this location.
+     */
+    GeoPoint reference;
+
+    /**
+     * The vertices (FloatPoint, angles in radians).
+     */
+    GLFallbackArrayBuffer *buffer;
+
+    unsigned n_vertices;
+
+    /**
+     * The triangle indices of the polygon fill.  Zero if the polygon
+     * could not be triangulated.
+     */
+    unsigned n_indices;
+
+    AllocatedArray<GLushort> indices;
+
+    Polygon():bounds(GeoBounds::Invalid()), buffer(nullptr) {}
+    Polygon(const Polygon &) = delete;
+    ~Polygon();
+  };
+
+private:
+  const Airspaces *airspaces;
+  Serial serial;
+
+  std::unordered_map<const AbstractAirspace *, Polygon> polygons;
+
+public:
+  AirspacePolygonCache();
+  ~AirspacePolygonCache();
+
+  AirspacePolygonCache(const AirspacePolygonCache &) = delete;
+
+  /**
+   * Discard the cache if the #Airspaces object has been replaced or
+   * modified since the last call.
+   */
+  void Update(const Airspaces &airspaces);
+
+  void Clear() {
+    polygons.clear();
+  }
+
+  /**
+   * Look up the cache entry for the specified polygon, and create it
+   * if it does not exist yet.
+   *
+   * @return the entry or nullptr if the polygon cannot be cached
+   * (it has too few or too many vertices)
+   */
+  Polygon *Get(const AirspacePolygon &airspace);
+
+private:
+  /* virtual methods from class GLSurfaceListener */
+  virtual void SurfaceCreated() override;
+  virtual void SurfaceDestroyed() override;
+};
+
+#endif
@@ -27,7 +27,9 @@ Copyright_License {
 #include "Util/StaticArray.hpp"
 #include "Geo/GeoPoint.hpp"
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+#include "AirspacePolygonCache.hpp"
+#else
 #include "TransparentRendererCache.hpp"
 #endif
 
@@ -52,7 +54,13 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> intersections;
 
-#ifndef ENABLE_OPENGL
+#ifdef ENABLE_OPENGL
+  /**
+   * This object caches the vertices and triangles of all polygons
+   * which have been drawn.
+   */
+  AirspacePolygonCache polygon_cache;
+#else
   /**
    * This object caches the airspace fill.  This avoids drawing it
    * again and again each frame when nothing has changed.
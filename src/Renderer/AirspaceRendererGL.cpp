@@ -36,9 +36,137 @@ Copyright_License {
 #include "Airspace/AirspaceWarningCopy.hpp"
 
 #include "Screen/OpenGL/Scope.hpp"
+#include "Screen/OpenGL/Geo.hpp"
+#include "Screen/OpenGL/VertexPointer.hpp"
+#include "Screen/OpenGL/FallbackBuffer.hpp"
+
+#ifdef USE_GLSL
+#include "Screen/OpenGL/Shaders.hpp"
+#include "Screen/OpenGL/Program.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+#endif
+
+/**
+ * A #MapCanvas which draws airspace polygons from the
+ * #AirspacePolygonCache.  Passes with a thick pen fall back to screen
+ * coordinates, because Canvas::DrawPolygon() generates thick lines in
+ * screen space.
+ */
+class CachedAirspaceCanvas : protected MapCanvas {
+  AirspacePolygonCache &cache;
+
+  const WindowProjection &window_projection;
+
+  const GeoBounds screen_bounds;
+
+  const AirspacePolygon *current;
+
+  /**
+   * The cache entry of #current.  If this is nullptr, then the
+   * polygon is drawn from screen coordinates.
+   */
+  AirspacePolygonCache::Polygon *cached;
+
+  /**
+   * Has #current been projected to screen coordinates already, and
+   * was it visible?
+   */
+  bool prepared, prepared_visible;
+
+protected:
+  CachedAirspaceCanvas(Canvas &_canvas, const WindowProjection &_projection,
+                       AirspacePolygonCache &_cache)
+    :MapCanvas(_canvas, _projection,
+               _projection.GetScreenBounds().Scale(fixed(1.1))),
+     cache(_cache), window_projection(_projection),
+     screen_bounds(_projection.GetScreenBounds().Scale(fixed(1.1))) {}
+
+  /**
+   * Select the polygon for the following DrawAirspace() calls.
+   *
+   * @return false if the polygon is not visible
+   */
+  bool PrepareAirspace(const AirspacePolygon &airspace) {
+    current = &airspace;
+    prepared = false;
+
+    cached = cache.Get(airspace);
+    if (cached == nullptr)
+      return PrepareScreen();
+
+    return cached->bounds.Overlaps(screen_bounds);
+  }
+
+  /**
+   * Draw the polygon selected by PrepareAirspace() with the current
+   * pen and brush of the #Canvas.
+   */
+  void DrawAirspace() {
+    const Pen &pen = canvas.GetPen();
+    if (cached == nullptr || (pen.IsDefined() && pen.GetWidth() > 2)) {
+      if (PrepareScreen())
+        DrawPrepared();
+      return;
+    }
+
+    DrawCached(pen, canvas.GetBrush());
+  }
+
+private:
+  bool PrepareScreen() {
+    if (!prepared) {
+      prepared = true;
+      prepared_visible = PreparePolygon(current->GetPoints());
+    }
+
+    return prepared_visible;
+  }
+
+  void DrawCached(const Pen &pen, const Brush &brush) {
+#ifdef USE_GLSL
+    OpenGL::solid_shader->Use();
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(ToGLM(window_projection,
+                                            cached->reference)));
+#else
+    glPushMatrix();
+    ApplyProjection(window_projection, cached->reference);
+#endif
+
+    const FloatPoint *points = (const FloatPoint *)
+      cached->buffer->BeginRead();
+
+    {
+      ScopeVertexPointer vp(points);
+
+      if (!brush.IsHollow() && cached->n_indices > 0) {
+        brush.Set();
+        glDrawElements(GL_TRIANGLES, cached->n_indices, GL_UNSIGNED_SHORT,
+                       cached->indices.begin());
+      }
+
+      if (pen.IsDefined() &&
+          (brush.IsHollow() || brush.GetColor() != pen.GetColor())) {
+        pen.Bind();
+        glDrawArrays(GL_LINE_LOOP, 0, cached->n_vertices);
+        pen.Unbind();
+      }
+    }
+
+    cached->buffer->EndRead();
+
+#ifdef USE_GLSL
+    glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                       glm::value_ptr(glm::mat4()));
+#else
+    glPopMatrix();
+#endif
+  }
+};
 
 class AirspaceVisitorRenderer final
-  : public AirspaceVisitor, protected MapCanvas
+  : public AirspaceVisitor, protected CachedAirspaceCanvas
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
@@ -46,11 +174,11 @@ class AirspaceVisitorRenderer final
 
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                          AirspacePolygonCache &_cache,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
                           const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(fixed(1.1))),
+    :CachedAirspaceCanvas(_canvas, _projection, _cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glStencilMask(0xff);
@@ -101,7 +229,7 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    if (!PrepareAirspace(airspace))
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -120,7 +248,7 @@ private:
       if (!fill_airspace) {
         // set stencil for filling (bit 0)
         SetFillStencil();
-        DrawPrepared();
+        DrawAirspace();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
 
@@ -128,20 +256,20 @@ private:
       {
         SetupInterior(airspace, !fill_airspace);
         GLEnable blend(GL_BLEND);
-        DrawPrepared();
+        DrawAirspace();
       }
 
       if (!fill_airspace) {
         // clear fill stencil (bit 0)
         ClearFillStencil();
-        DrawPrepared();
+        DrawAirspace();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawAirspace();
   }
 
 protected:
@@ -216,7 +344,7 @@ private:
 };
 
 class AirspaceFillRenderer final
-  : public AirspaceVisitor, protected MapCanvas
+  : public AirspaceVisitor, protected CachedAirspaceCanvas
 {
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
@@ -224,11 +352,11 @@ class AirspaceFillRenderer final
 
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                       AirspacePolygonCache &_cache,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
                        const AirspaceRendererSettings &_settings)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().Scale(fixed(1.1))),
+    :CachedAirspaceCanvas(_canvas, _projection, _cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -250,18 +378,18 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    if (!PrepareAirspace(airspace))
       return;
 
     if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
       // fill interior without overpainting any previous outlines
       GLEnable blend(GL_BLEND);
-      DrawPrepared();
+      DrawAirspace();
     }
 
     // draw outline
     if (SetupOutline(airspace))
-      DrawPrepared();
+      DrawAirspace();
   }
 
 protected:
@@ -314,16 +442,18 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
+  polygon_cache.Update(*airspaces);
+
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc,
-                                  settings);
+    AirspaceFillRenderer renderer(canvas, projection, polygon_cache,
+                                  look, awc, settings);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters(),
                                 renderer, visible);
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc,
-                                     settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, polygon_cache,
+                                     look, awc, settings);
     airspaces->VisitWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters(),
                                 renderer, visible);
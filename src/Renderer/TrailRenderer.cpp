@@ -38,8 +38,12 @@ Copyright_License {
 bool
 TrailRenderer::LoadTrace(const TraceComputer &trace_computer)
 {
-  trace.clear();
-  trace_computer.LockedCopyTo(trace);
+  const TraceSnapshot snapshot = trace_computer.GetSnapshot();
+  if (snapshot.GetEpoch() != loaded_epoch || trace.size() > snapshot.size())
+    trace.clear();
+
+  snapshot.CopyTo(trace, trace.size());
+  loaded_epoch = snapshot.GetEpoch();
   return !trace.empty();
 }
 
@@ -49,9 +53,10 @@ TrailRenderer::LoadTrace(const TraceComputer &trace_computer,
                          const WindowProjection &projection)
 {
   trace.clear();
-  trace_computer.LockedCopyTo(trace, min_time,
-                              projection.GetGeoScreenCenter(),
-                              projection.DistancePixelsToMeters(3));
+  loaded_epoch = 0;
+  trace_computer.GetSnapshot().CopyTo(trace, min_time,
+                                      projection.GetGeoScreenCenter(),
+                                      projection.DistancePixelsToMeters(3));
   return !trace.empty();
 }
 
@@ -46,11 +46,20 @@ class TrailRenderer {
   TracePointVector trace;
   AllocatedArray<RasterPoint> points;
 
+  /**
+   * The epoch of the snapshot that #trace was completely loaded
+   * from, or 0 if it contains a filtered trace.  This allows
+   * LoadTrace() to copy only new points.
+   */
+  unsigned loaded_epoch;
+
 public:
-  TrailRenderer(const TrailLook &_look):look(_look) {}
+  TrailRenderer(const TrailLook &_look):look(_look), loaded_epoch(0) {}
 
   /**
-   * Load the full trace into this object.
+   * Load the full trace into this object.  If the previous call
+   * loaded the full trace as well, only the points appended since
+   * then are copied.
    */
   bool LoadTrace(const TraceComputer &trace_computer);
 
@@ -32,7 +32,6 @@ Copyright_License {
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Engine/Waypoint/WaypointVisitor.hpp"
-#include "Engine/GlideSolvers/GlideState.hpp"
 #include "Engine/GlideSolvers/GlideResult.hpp"
 #include "Engine/GlideSolvers/MacCready.hpp"
 #include "Engine/Task/AbstractTask.hpp"
@@ -74,19 +73,7 @@ struct VisibleWaypoint {
     in_task = _in_task;
   }
 
-  void CalculateReachabilityDirect(const MoreData &basic,
-                                   const SpeedVector &wind,
-                                   const MacCready &mac_cready,
-                                   const TaskBehaviour &task_behaviour) {
-    assert(basic.location_available);
-    assert(basic.NavAltitudeAvailable());
-
-    const fixed elevation = waypoint->elevation +
-      task_behaviour.safety_height_arrival;
-    const GlideState state(GeoVector(basic.location, waypoint->location),
-                           elevation, basic.nav_altitude, wind);
-
-    const GlideResult result = mac_cready.SolveStraight(state);
+  void SetReachabilityDirect(const GlideResult &result) {
     if (!result.IsOk())
       return;
 
@@ -417,15 +404,42 @@ public:
       ? polar_settings.glide_polar_task
       : calculated.glide_polar_safety;
     const MacCready mac_cready(task_behaviour.glide, glide_polar);
+    const SpeedVector wind = calculated.GetWindOrZero();
+
+    /* solve the glides in batches, which is cheaper than solving each
+       one separately */
+    static constexpr unsigned BATCH_SIZE = 32;
+    VisibleWaypoint *batch[BATCH_SIZE];
+    GeoVector vectors[BATCH_SIZE];
+    fixed min_arrival_altitudes[BATCH_SIZE];
+    GlideResult results[BATCH_SIZE];
+    unsigned n = 0;
+
+    auto flush = [&]() {
+      mac_cready.SolveStraight(n, vectors, min_arrival_altitudes,
+                               basic.nav_altitude, wind, results);
+      for (unsigned i = 0; i < n; ++i)
+        batch[i]->SetReachabilityDirect(results[i]);
+      n = 0;
+    };
 
     for (auto it = waypoints.begin(), end = waypoints.end(); it != end; ++it) {
       VisibleWaypoint &vwp = *it;
       const Waypoint &way_point = *vwp.waypoint;
 
-      if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachabilityDirect(basic, calculated.GetWindOrZero(),
-                                        mac_cready, task_behaviour);
+      if (!way_point.IsLandable() && !way_point.flags.watched)
+        continue;
+
+      batch[n] = &vwp;
+      vectors[n] = GeoVector(basic.location, way_point.location);
+      min_arrival_altitudes[n] = way_point.elevation +
+        task_behaviour.safety_height_arrival;
+      if (++n == BATCH_SIZE)
+        flush();
     }
+
+    if (n > 0)
+      flush();
   }
 
   void Calculate(const ProtectedRoutePlanner *route_planner,
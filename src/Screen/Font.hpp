@@ -29,6 +29,7 @@ Copyright_License {
 
 #ifdef USE_FREETYPE
 typedef struct FT_FaceRec_ *FT_Face;
+class GlyphCache;
 #endif
 
 #ifdef WIN32
@@ -48,6 +49,12 @@ class Font {
 protected:
 #ifdef USE_FREETYPE
   FT_Face face;
+
+  /**
+   * Caches metrics and bitmaps of the glyphs which have been used
+   * so far.
+   */
+  GlyphCache *glyph_cache;
 #elif defined(ANDROID)
   TextUtil *text_util_object;
 
@@ -64,7 +71,7 @@ protected:
 
 public:
 #ifdef USE_FREETYPE
-  Font():face(nullptr) {}
+  Font():face(nullptr), glyph_cache(nullptr) {}
 #elif defined(ANDROID)
   Font():text_util_object(nullptr) {}
 #else
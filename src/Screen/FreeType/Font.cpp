@@ -25,6 +25,7 @@ Copyright_License {
 #include "Screen/Debug.hpp"
 #include "Screen/Custom/Files.hpp"
 #include "Init.hpp"
+#include "GlyphCache.hpp"
 #include "Asset.hpp"
 
 #ifndef ENABLE_OPENGL
@@ -57,7 +58,6 @@ static Mutex freetype_mutex;
 #endif
 
 static FT_Int32 load_flags = FT_LOAD_DEFAULT;
-static FT_Render_Mode render_mode = FT_RENDER_MODE_NORMAL;
 
 static const char *font_path;
 static const char *bold_font_path;
@@ -76,13 +76,6 @@ IsMono()
 #endif
 }
 
-gcc_const
-static inline FT_Long
-FT_FLOOR(FT_Long x)
-{
-  return (x & -64) / 64;
-}
-
 gcc_const
 static inline FT_Long
 FT_CEIL(FT_Long x)
@@ -107,7 +100,6 @@ Font::Initialise()
   if (IsMono()) {
     /* disable anti-aliasing */
     load_flags |= FT_LOAD_TARGET_MONO;
-    render_mode = FT_RENDER_MODE_MONO;
   }
 
   font_path = FindDefaultFont();
@@ -165,6 +157,7 @@ Font::LoadFile(const char *file, UPixelScalar ptsize, bool bold, bool italic)
   // TODO: handle bold/italic
 
   face = new_face;
+  glyph_cache = new GlyphCache(face, load_flags, IsMono());
   return true;
 }
 
@@ -223,6 +216,9 @@ Font::Destroy()
 
   assert(IsScreenInitialized());
 
+  delete glyph_cache;
+  glyph_cache = nullptr;
+
   ::FT_Done_Face(face);
   face = nullptr;
 }
@@ -235,7 +231,7 @@ Font::TextSize(const TCHAR *text) const
   assert(ValidateUTF8(text));
 #endif
 
-  const FT_Face face = this->face;
+  GlyphCache &glyphs = *glyph_cache;
   const bool use_kerning = FT_HAS_KERNING(face);
 
   int x = 0, minx = 0, maxx = 0;
@@ -253,41 +249,28 @@ Font::TextSize(const TCHAR *text) const
     const unsigned ch = n.first;
     text = n.second;
 
-    FT_UInt i = FT_Get_Char_Index(face, ch);
-    if (i == 0)
-      continue;
-
-    FT_Error error = FT_Load_Glyph(face, i, load_flags);
-    if (error)
+    const GlyphCache::Glyph &glyph = glyphs.Get(ch);
+    if (!glyph.IsDefined())
       continue;
 
-    const FT_GlyphSlot glyph = face->glyph;
-    const FT_Glyph_Metrics &metrics = glyph->metrics;
-
-    const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-    const int glyph_maxx = minx + FT_CEIL(metrics.width);
-    const int glyph_advance = FT_CEIL(metrics.horiAdvance);
+    const int glyph_maxx = minx + glyph.width;
 
     if (use_kerning) {
-      if (prev_index != 0 && i != 0) {
-        FT_Vector delta;
-        FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
-                       &delta);
-        x += delta.x >> 6;
-      }
-
-      prev_index = i;
+      if (prev_index != 0)
+        x += glyphs.GetKerning(prev_index, glyph.index);
+
+      prev_index = glyph.index;
     }
 
-    int z = x + glyph_minx;
+    int z = x + glyph.minx;
     if (z < minx)
       minx = z;
 
-    z = x + std::max(glyph_maxx, glyph_advance);
+    z = x + std::max(glyph_maxx, glyph.advance);
     if (z > maxx)
       maxx = z;
 
-    x += glyph_advance;
+    x += glyph.advance;
   }
 
   return PixelSize{unsigned(maxx - minx), height};
@@ -295,12 +278,9 @@ Font::TextSize(const TCHAR *text) const
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y)
+            const uint8_t *src, unsigned pitch, int width, int height,
+            int x, int y)
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
-
   if (x < 0) {
     src -= x;
     width += x;
@@ -314,7 +294,7 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     width = buffer_width - x;
 
   if (y < 0) {
-    src -= y * pitch;
+    src -= y * int(pitch);
     height += y;
     y = 0;
   }
@@ -332,50 +312,6 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     std::copy(src, src + width, buffer);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n)
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src)
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y)
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(const TCHAR *text, const PixelSize size, void *_buffer) const
 {
@@ -387,7 +323,7 @@ Font::Render(const TCHAR *text, const PixelSize size, void *_buffer) const
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  const FT_Face face = this->face;
+  GlyphCache &glyphs = *glyph_cache;
   const bool use_kerning = FT_HAS_KERNING(face);
 
   int x = 0, minx = 0;
@@ -405,40 +341,26 @@ Font::Render(const TCHAR *text, const PixelSize size, void *_buffer) const
     const unsigned ch = n.first;
     text = n.second;
 
-    FT_UInt i = FT_Get_Char_Index(face, ch);
-    if (i == 0)
-      continue;
-
-    FT_Error error = FT_Load_Glyph(face, i, load_flags);
-    if (error)
+    const GlyphCache::Glyph &glyph = glyphs.Get(ch);
+    if (!glyph.IsDefined())
       continue;
 
-    const FT_GlyphSlot glyph = face->glyph;
-    const FT_Glyph_Metrics &metrics = glyph->metrics;
-
-    const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-    const int glyph_advance = FT_CEIL(metrics.horiAdvance);
-
     if (use_kerning) {
-      if (prev_index != 0) {
-        FT_Vector delta;
-        FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
-                       &delta);
-        x += delta.x >> 6;
-      }
-
-      prev_index = i;
+      if (prev_index != 0)
+        x += glyphs.GetKerning(prev_index, glyph.index);
+
+      prev_index = glyph.index;
     }
 
-    int z = x + glyph_minx;
+    int z = x + glyph.minx;
     if (z < minx)
       minx = z;
 
-    const int glyph_maxy = FT_FLOOR(metrics.horiBearingY);
-
-    RenderGlyph((uint8_t *)buffer, size.cx, size.cy,
-                glyph, x - minx, ascent_height - glyph_maxy);
+    RenderGlyph(buffer, size.cx, size.cy,
+                glyphs.GetBitmap(glyph), glyphs.GetPitch(),
+                glyph.bitmap_width, glyph.bitmap_height,
+                x - minx, ascent_height - glyph.maxy);
 
-    x += glyph_advance;
+    x += glyph.advance;
   }
 }
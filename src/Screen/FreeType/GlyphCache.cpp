@@ -0,0 +1,211 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "GlyphCache.hpp"
+#include "Util/Macros.hpp"
+
+#if defined(__clang__) && defined(__arm__)
+/* work around warning: 'register' storage class specifier is
+   deprecated */
+#define register
+#endif
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+
+#include <assert.h>
+
+/**
+ * The initial width of the atlas [pixels].  It is widened when a
+ * glyph does not fit.
+ */
+static constexpr unsigned INITIAL_ATLAS_WIDTH = 256;
+
+gcc_const
+static inline FT_Long
+FT_FLOOR(FT_Long x)
+{
+  return (x & -64) / 64;
+}
+
+gcc_const
+static inline FT_Long
+FT_CEIL(FT_Long x)
+{
+  return ((x + 63) & -64) / 64;
+}
+
+static void
+ConvertMono(uint8_t *dest, const uint8_t *src, unsigned n)
+{
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
+  }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
+}
+
+GlyphCache::GlyphCache(FT_Face _face, int32_t _load_flags, bool _mono)
+  :face(_face), load_flags(_load_flags), mono(_mono),
+   atlas_width(INITIAL_ATLAS_WIDTH),
+   shelf_y(0), shelf_height(0), shelf_x(0)
+{
+  std::fill_n(latin1, ARRAY_SIZE(latin1), nullptr);
+}
+
+const GlyphCache::Glyph &
+GlyphCache::Get(unsigned ch)
+{
+  if (ch < ARRAY_SIZE(latin1) && latin1[ch] != nullptr)
+    return *latin1[ch];
+
+  auto result = glyphs.emplace(ch, Glyph());
+  Glyph &glyph = result.first->second;
+  if (result.second)
+    Load(glyph, ch);
+
+  /* std::unordered_map never moves its elements, therefore this
+     pointer remains valid */
+  if (ch < ARRAY_SIZE(latin1))
+    latin1[ch] = &glyph;
+
+  return glyph;
+}
+
+int
+GlyphCache::GetKerning(unsigned prev_index, unsigned index)
+{
+  assert(FT_HAS_KERNING(face));
+
+  const uint64_t key = (uint64_t(prev_index) << 32) | index;
+  auto i = kerning.find(key);
+  if (i != kerning.end())
+    return i->second;
+
+  FT_Vector delta;
+  FT_Error error = FT_Get_Kerning(face, prev_index, index,
+                                  ft_kerning_default, &delta);
+  const int distance = error ? 0 : int(delta.x >> 6);
+  kerning.emplace(key, distance);
+  return distance;
+}
+
+void
+GlyphCache::Load(Glyph &glyph, unsigned ch)
+{
+  glyph.index = 0;
+  glyph.minx = glyph.maxy = glyph.width = glyph.advance = 0;
+  glyph.atlas_x = glyph.atlas_y = 0;
+  glyph.bitmap_width = glyph.bitmap_height = 0;
+
+  FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0)
+    return;
+
+  FT_Error error = FT_Load_Glyph(face, i, load_flags);
+  if (error)
+    return;
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  glyph.index = i;
+  glyph.minx = FT_FLOOR(metrics.horiBearingX);
+  glyph.maxy = FT_FLOOR(metrics.horiBearingY);
+  glyph.width = FT_CEIL(metrics.width);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+
+  /* a glyph which cannot be rendered (e.g. a space) still has
+     metrics; it just doesn't get a bitmap */
+  error = FT_Render_Glyph(slot, mono
+                          ? FT_RENDER_MODE_MONO
+                          : FT_RENDER_MODE_NORMAL);
+  if (error)
+    return;
+
+  const FT_Bitmap &bitmap = slot->bitmap;
+  const unsigned width = bitmap.width, height = bitmap.rows;
+  if (width == 0 || height == 0)
+    return;
+
+  Allocate(width, height, glyph.atlas_x, glyph.atlas_y);
+  glyph.bitmap_width = width;
+  glyph.bitmap_height = height;
+
+  const uint8_t *src = (const uint8_t *)bitmap.buffer;
+  uint8_t *dest = atlas.data() + glyph.atlas_y * atlas_width + glyph.atlas_x;
+
+  for (unsigned y = 0; y < height;
+       ++y, src += bitmap.pitch, dest += atlas_width) {
+    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+      /* with anti-aliasing disabled, FreeType writes each pixel in
+         one bit; expand it to one byte per pixel */
+      ConvertMono(dest, src, width);
+    else
+      std::copy_n(src, width, dest);
+  }
+}
+
+void
+GlyphCache::Allocate(unsigned width, unsigned height,
+                     unsigned &x_r, unsigned &y_r)
+{
+  if (width > atlas_width)
+    Widen(width);
+
+  if (shelf_x + width > atlas_width) {
+    /* this shelf is full; begin a new one below */
+    shelf_y += shelf_height;
+    shelf_height = 0;
+    shelf_x = 0;
+  }
+
+  x_r = shelf_x;
+  y_r = shelf_y;
+
+  shelf_x += width;
+  if (height > shelf_height) {
+    shelf_height = height;
+    atlas.resize((shelf_y + shelf_height) * atlas_width);
+  }
+}
+
+void
+GlyphCache::Widen(unsigned new_width)
+{
+  assert(new_width > atlas_width);
+
+  const unsigned height = atlas.size() / atlas_width;
+
+  std::vector<uint8_t> new_atlas(height * new_width);
+  for (unsigned y = 0; y < height; ++y)
+    std::copy_n(atlas.data() + y * atlas_width, atlas_width,
+                new_atlas.data() + y * new_width);
+
+  atlas.swap(new_atlas);
+  atlas_width = new_width;
+}
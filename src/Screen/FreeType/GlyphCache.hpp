@@ -0,0 +1,156 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+#define XCSOAR_SCREEN_FREETYPE_GLYPH_CACHE_HPP
+
+#include "Compiler.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include <stdint.h>
+
+typedef struct FT_FaceRec_ *FT_Face;
+
+/**
+ * Caches the metrics and the rendered coverage bitmaps of the glyphs
+ * of one #Font.  Each glyph is loaded from FreeType only once;
+ * after that, measuring and rendering text is a matter of table
+ * lookups.
+ *
+ * The coverage bitmaps (8 bits per pixel, monochrome glyphs are
+ * expanded) are packed into one "atlas" bitmap, row by row ("shelf
+ * packing").  The atlas only grows; it is freed with the #Font.
+ *
+ * This class is not thread-safe; the caller is responsible for
+ * locking.
+ */
+class GlyphCache {
+public:
+  struct Glyph {
+    /**
+     * The FreeType glyph index.  0 means the font does not have a
+     * glyph for this character (or loading it has failed).
+     */
+    unsigned index;
+
+    /**
+     * The horizontal and vertical bearing [pixels].
+     */
+    int minx, maxy;
+
+    /**
+     * The width of the glyph and the horizontal advance [pixels].
+     */
+    int width, advance;
+
+    /**
+     * The position and the size of the coverage bitmap within the
+     * atlas.
+     */
+    unsigned atlas_x, atlas_y, bitmap_width, bitmap_height;
+
+    bool IsDefined() const {
+      return index != 0;
+    }
+  };
+
+private:
+  const FT_Face face;
+  const int32_t load_flags;
+  const bool mono;
+
+  std::unordered_map<unsigned, Glyph> glyphs;
+
+  /**
+   * A shortcut into #glyphs for the first 256 code points, which are
+   * by far the most frequent ones.
+   */
+  const Glyph *latin1[256];
+
+  std::unordered_map<uint64_t, int> kerning;
+
+  /**
+   * The coverage bitmaps of all glyphs; #atlas_width bytes per row.
+   */
+  std::vector<uint8_t> atlas;
+
+  unsigned atlas_width;
+
+  /**
+   * The current shelf: the top row, the height of the tallest glyph
+   * and the column where the next glyph will be placed.
+   */
+  unsigned shelf_y, shelf_height, shelf_x;
+
+public:
+  /**
+   * @param mono render monochrome glyphs (FT_RENDER_MODE_MONO)
+   */
+  GlyphCache(FT_Face _face, int32_t _load_flags, bool _mono);
+
+  GlyphCache(const GlyphCache &) = delete;
+  GlyphCache &operator=(const GlyphCache &) = delete;
+
+  /**
+   * Look up the specified character, and load it from FreeType if
+   * it is not yet in the cache.
+   *
+   * @return a glyph which remains valid for the lifetime of this
+   * object; check Glyph::IsDefined() before using it
+   */
+  const Glyph &Get(unsigned ch);
+
+  /**
+   * Returns the kerning distance [pixels] between two glyphs.  Call
+   * only if the face has kerning information.
+   */
+  int GetKerning(unsigned prev_index, unsigned index);
+
+  /**
+   * Returns a pointer to the coverage bitmap of the specified glyph;
+   * rows are GetPitch() bytes apart.  The pointer is invalidated by
+   * the next Get() call.
+   */
+  const uint8_t *GetBitmap(const Glyph &glyph) const {
+    return atlas.data() + glyph.atlas_y * atlas_width + glyph.atlas_x;
+  }
+
+  unsigned GetPitch() const {
+    return atlas_width;
+  }
+
+private:
+  void Load(Glyph &glyph, unsigned ch);
+
+  /**
+   * Reserve an area in the atlas.
+   */
+  void Allocate(unsigned width, unsigned height,
+                unsigned &x_r, unsigned &y_r);
+
+  void Widen(unsigned new_width);
+};
+
+#endif
@@ -158,6 +158,14 @@ public:
     brush = Brush(COLOR_BLACK);
   }
 
+  const Pen &GetPen() const {
+    return pen;
+  }
+
+  const Brush &GetBrush() const {
+    return brush;
+  }
+
   void Select(const Pen &_pen) {
     pen = _pen;
   }
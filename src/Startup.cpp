@@ -55,6 +55,7 @@ Copyright_License {
 #include "Audio/VarioGlue.hpp"
 #include "Screen/Busy.hpp"
 #include "CommandLine.hpp"
+#include "Profiler/Profiler.hpp"
 #include "MainWindow.hpp"
 #include "Computer/GlideComputer.hpp"
 #include "Computer/GlideComputerInterface.hpp"
@@ -368,7 +369,7 @@ Startup()
 
   // Reads the airspace files
   ReadAirspace(airspace_database, terrain, computer_settings.pressure,
-               operation);
+               file_cache, operation);
 
   {
     const AircraftState aircraft_state =
@@ -566,6 +567,15 @@ Shutdown()
   LogFormat("delete MapWindow");
   main_window->Deinitialise();
 
+  if (Profiler::IsEnabled()) {
+    TCHAR path[MAX_PATH];
+    LocalPath(path, _T("timing.txt"));
+    if (!Profiler::Dump(path))
+      LogFormat(_T("Failed to write %s"), path);
+
+    Profiler::Disable();
+  }
+
   // Stop sound
   AudioVarioGlue::Deinitialise();
 
@@ -30,7 +30,11 @@ Copyright_License {
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include <algorithm>
+
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 void
 HeightMatrix::SetSize(size_t _size)
@@ -87,13 +91,93 @@ HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
   SetSize((screen_width + quantisation_pixels - 1) / quantisation_pixels,
           (screen_height + quantisation_pixels - 1) / quantisation_pixels);
 
-  short *p = data.begin();
-  for (unsigned y = 0; y < screen_height;
-       y += quantisation_pixels, p += width) {
-    map.ScanLine(projection.ScreenToGeo(0, y),
-                 projection.ScreenToGeo(screen_width, y),
-                 p, width, interpolate);
+  Fill(map, projection, RasterPoint(0, 0), quantisation_pixels,
+       0, 0, width, height, interpolate);
+}
+
+void
+HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
+                   RasterPoint origin, unsigned quantisation_pixels,
+                   unsigned x_start, unsigned y_start,
+                   unsigned x_end, unsigned y_end,
+                   bool interpolate)
+{
+  assert(x_start < x_end && x_end <= width);
+  assert(y_start < y_end && y_end <= height);
+
+  /* the cells are exactly quantisation_pixels apart in both
+     directions, so a partial fill after Shift() samples the same
+     locations as a full one */
+  const int x0 = origin.x + int(x_start * quantisation_pixels);
+  const int x1 = origin.x + int(x_end * quantisation_pixels);
+
+  short *p = data.begin() + y_start * width + x_start;
+  for (unsigned y = y_start; y < y_end; ++y, p += width) {
+    const int screen_y = origin.y + int(y * quantisation_pixels);
+    map.ScanLine(projection.ScreenToGeo(x0, screen_y),
+                 projection.ScreenToGeo(x1, screen_y),
+                 p, x_end - x_start, interpolate);
+  }
+}
+
+void
+HeightMatrix::Shift(int dx, int dy)
+{
+  assert(unsigned(abs(dx)) < width);
+  assert(unsigned(abs(dy)) < height);
+
+  const unsigned row_size = width - abs(dx);
+  const unsigned n_rows = height - abs(dy);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  if (dy >= 0) {
+    /* moving up: copy from top to bottom */
+    for (unsigned y = 0; y < n_rows; ++y)
+      memmove(data.begin() + y * width + dest_x,
+              data.begin() + (y + dy) * width + src_x,
+              row_size * sizeof(data[0]));
+  } else {
+    /* moving down: copy from bottom to top */
+    for (unsigned y = n_rows; y-- > 0;)
+      memmove(data.begin() + (y - dy) * width + dest_x,
+              data.begin() + y * width + src_x,
+              row_size * sizeof(data[0]));
   }
 }
 
+void
+HeightMatrix::Scroll(const RasterMap &map, const WindowProjection &projection,
+                     RasterPoint origin, unsigned quantisation_pixels,
+                     int dx, int dy, bool interpolate)
+{
+  Shift(dx, dy);
+
+  /* scan the exposed rows completely, and the exposed columns of the
+     remaining rows */
+
+  unsigned y_start = 0, y_end = height;
+  if (dy > 0) {
+    y_end = height - dy;
+    Fill(map, projection, origin, quantisation_pixels,
+         0, y_end, width, height, interpolate);
+  } else if (dy < 0) {
+    y_start = -dy;
+    Fill(map, projection, origin, quantisation_pixels,
+         0, 0, width, y_start, interpolate);
+  }
+
+  if (dx == 0)
+    return;
+
+  /* a single cell would be filled with TERRAIN_INVALID by
+     RasterMap::ScanLine(); rescan a valid neighbour as well */
+  const unsigned n = std::min(std::max(unsigned(abs(dx)), 2u), width);
+  if (dx > 0)
+    Fill(map, projection, origin, quantisation_pixels,
+         width - n, y_start, width, y_end, interpolate);
+  else
+    Fill(map, projection, origin, quantisation_pixels,
+         0, y_start, n, y_end, interpolate);
+}
+
 #endif
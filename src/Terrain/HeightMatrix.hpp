@@ -34,6 +34,7 @@ class RasterMap;
 class GeoBounds;
 #else
 class WindowProjection;
+struct RasterPoint;
 #endif
 
 class HeightMatrix : private NonCopyable {
@@ -61,6 +62,41 @@ public:
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
             unsigned quantisation_pixels, bool interpolate);
+
+  /**
+   * Copy values from the #RasterMap into a rectangle of the existing
+   * buffer, e.g. after Shift().  The size is not changed.
+   *
+   * @param origin the screen location of the first cell
+   * @param x_start, y_start, x_end, y_end the cell range to be filled
+   */
+  void Fill(const RasterMap &map, const WindowProjection &map_projection,
+            RasterPoint origin, unsigned quantisation_pixels,
+            unsigned x_start, unsigned y_start,
+            unsigned x_end, unsigned y_end,
+            bool interpolate);
+
+  /**
+   * Move the values by the specified number of cells towards the
+   * top left corner (negative values move to the bottom right).
+   * The cells which have become exposed are left undefined; the
+   * caller is responsible for filling them.
+   */
+  void Shift(int dx, int dy);
+
+  /**
+   * Shift() the values and fill the exposed cells from the
+   * #RasterMap.  The exposed rows are scanned completely.  The
+   * exposed columns are scanned at least two cells wide, because
+   * RasterMap::ScanLine() needs two samples; therefore one more
+   * column than exposed may get new values.
+   *
+   * @param origin the screen location of the first cell after
+   * shifting
+   */
+  void Scroll(const RasterMap &map, const WindowProjection &map_projection,
+              RasterPoint origin, unsigned quantisation_pixels,
+              int dx, int dy, bool interpolate);
 #endif
 
   unsigned GetWidth() const {
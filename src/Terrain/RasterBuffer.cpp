@@ -33,7 +33,66 @@ RasterBuffer::Resize(unsigned _width, unsigned _height)
 {
   assert(_width > 0 && _height > 0);
 
-  data.GrowDiscard(_width, _height);
+  storage.GrowDiscard(_width * _height);
+  values = storage.begin();
+  width = _width;
+  height = _height;
+}
+
+gcc_const
+static short
+ReduceValues(short a, short b, short c, short d)
+{
+  int sum = 0;
+  unsigned n = 0;
+
+  if (!RasterBuffer::IsSpecial(a)) {
+    sum += a;
+    ++n;
+  }
+
+  if (!RasterBuffer::IsSpecial(b)) {
+    sum += b;
+    ++n;
+  }
+
+  if (!RasterBuffer::IsSpecial(c)) {
+    sum += c;
+    ++n;
+  }
+
+  if (!RasterBuffer::IsSpecial(d)) {
+    sum += d;
+    ++n;
+  }
+
+  return n > 0 ? sum / (int)n : a;
+}
+
+void
+RasterBuffer::Reduce(const RasterBuffer &src)
+{
+  assert(src.IsDefined());
+  assert(&src != this);
+
+  const unsigned src_width = src.GetWidth(), src_height = src.GetHeight();
+  Resize(GetReducedSize(src_width), GetReducedSize(src_height));
+
+  short *gcc_restrict dest = GetData();
+  for (unsigned y = 0; y < height; ++y) {
+    const short *gcc_restrict row0 = src.GetDataAt(0, y * 2);
+    /* duplicate the last row/column if the source size is odd */
+    const short *gcc_restrict row1 = y * 2 + 1 < src_height
+      ? row0 + src_width
+      : row0;
+
+    for (unsigned x = 0; x < width; ++x) {
+      const unsigned x0 = x * 2;
+      const unsigned x1 = x0 + 1 < src_width ? x0 + 1 : x0;
+
+      *dest++ = ReduceValues(row0[x0], row0[x1], row1[x0], row1[x1]);
+    }
+  }
 }
 
 short
@@ -251,5 +310,7 @@ RasterBuffer::ScanLineChecked(unsigned ax, unsigned ay,
 short
 RasterBuffer::GetMaximum() const
 {
-  return IsDefined() ? *std::max_element(data.begin(), data.end()) : 0;
+  return IsDefined()
+    ? *std::max_element(values, values + width * height)
+    : 0;
 }
@@ -25,11 +25,14 @@ Copyright_License {
 #define XCSOAR_RASTER_BUFFER_HPP
 
 #include "Util/NonCopyable.hpp"
-#include "Util/AllocatedGrid.hpp"
+#include "Util/AllocatedArray.hpp"
 #include "Compiler.h"
 
+#include <utility>
 #include <cstddef>
 
+#include <assert.h>
+
 class RasterBuffer : private NonCopyable {
 public:
   /** invalid value for terrain */
@@ -67,23 +70,43 @@ public:
   }
 
 private:
-  AllocatedGrid<short> data;
+  /**
+   * The memory owned by this object.  It is empty if this object
+   * refers to memory owned by somebody else (see SetMapped()).
+   */
+  AllocatedArray<short> storage;
+
+  /**
+   * Points to the first height value; this is either the beginning
+   * of #storage or read-only memory passed to SetMapped().
+   */
+  const short *values;
+
+  unsigned width, height;
 
 public:
-  RasterBuffer() = default;
+  RasterBuffer():values(nullptr), width(0), height(0) {}
   RasterBuffer(unsigned _width, unsigned _height)
-    :data(_width, _height) {}
+    :storage(_width * _height), values(storage.begin()),
+     width(_width), height(_height) {}
 
   bool IsDefined() const {
-    return data.IsDefined();
+    return values != nullptr;
+  }
+
+  /**
+   * Does this object refer to memory owned by somebody else?
+   */
+  bool IsMapped() const {
+    return values != nullptr && values != storage.begin();
   }
 
   unsigned GetWidth() const {
-    return data.GetWidth();
+    return width;
   }
 
   unsigned GetHeight() const {
-    return data.GetHeight();
+    return height;
   }
 
   unsigned GetFineWidth() const {
@@ -94,24 +117,77 @@ public:
     return GetHeight() << 8;
   }
 
+  /**
+   * Returns a writable pointer to the height values.  Must not be
+   * used on a mapped buffer.
+   */
   short *GetData() {
-    return data.begin();
+    assert(!IsMapped());
+
+    return storage.begin();
   }
 
   const short *GetData() const {
-    return data.begin();
+    return values;
   }
 
   const short *GetDataAt(unsigned x, unsigned y) const {
-    return data.GetPointerAt(x, y);
+    assert(x < width);
+    assert(y < height);
+
+    return values + y * width + x;
   }
 
   void Reset() {
-    data.Reset();
+    storage.ResizeDiscard(0);
+    values = nullptr;
+    width = height = 0;
+  }
+
+  /**
+   * Refer to the specified read-only memory (e.g. inside a
+   * #FileMapping) instead of allocating a buffer.  The memory must
+   * remain valid until this object is reset or destructed.
+   */
+  void SetMapped(const short *_values, unsigned _width, unsigned _height) {
+    assert(_values != nullptr);
+    assert(_width > 0 && _height > 0);
+
+    storage.ResizeDiscard(0);
+    values = _values;
+    width = _width;
+    height = _height;
   }
 
   void Resize(unsigned _width, unsigned _height);
 
+  /**
+   * Returns the width or height of a buffer filled by Reduce().
+   */
+  constexpr
+  static unsigned GetReducedSize(unsigned size) {
+    return (size + 1) / 2;
+  }
+
+  /**
+   * Fill this buffer with a copy of the specified buffer with half
+   * the resolution.  Each value is the average of 2x2 source values;
+   * special values (water, invalid) do not contribute to the average.
+   */
+  void Reduce(const RasterBuffer &src);
+
+  /**
+   * Exchange the contents of the two buffers.  This is cheap, because
+   * only the pointers get swapped.
+   */
+  void Swap(RasterBuffer &other) {
+    /* the move operator of AllocatedArray swaps */
+    storage = std::move(other.storage);
+    std::swap(values, other.values);
+    std::swap(width, other.width);
+    std::swap(height, other.height);
+  }
+
   gcc_pure
   short GetInterpolated(unsigned lx, unsigned ly,
                         unsigned ix, unsigned iy) const;
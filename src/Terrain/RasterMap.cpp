@@ -45,9 +45,22 @@ ToNarrowPath(const TCHAR *src)
 }
 
 RasterMap::RasterMap(const TCHAR *_path, const TCHAR *world_file,
+                     const TCHAR *raw_file,
                      FileCache *cache, OperationEnvironment &operation)
   :path(ToNarrowPath(_path))
 {
+  if (raw_file != NULL && raster_tile_cache.LoadRaw(raw_file)) {
+    /* the uncompressed terrain file contains everything; no need to
+       decode the JPEG2000 file */
+    projection.Set(GetBounds(),
+                   raster_tile_cache.GetFineWidth(),
+                   raster_tile_cache.GetFineHeight());
+    return;
+  }
+
+  /* no usable uncompressed terrain file (missing, stale or written on
+     another platform): decode the JPEG2000 file */
+
   bool cache_loaded = false;
   if (cache != NULL) {
     /* load the cache file */
@@ -91,9 +104,18 @@ AngleToPixel(Angle value, Angle start, Angle end, unsigned width)
 
 void
 RasterMap::SetViewCenter(const GeoPoint &location, fixed radius)
+{
+  if (PrepareTiles(location, radius)) {
+    LoadTiles();
+    CommitTiles();
+  }
+}
+
+bool
+RasterMap::PrepareTiles(const GeoPoint &location, fixed radius)
 {
   if (!raster_tile_cache.GetInitialised())
-    return;
+    return false;
 
   const GeoBounds &bounds = GetBounds();
 
@@ -103,8 +125,8 @@ RasterMap::SetViewCenter(const GeoPoint &location, fixed radius)
   int y = AngleToPixel(location.latitude, bounds.GetNorth(), bounds.GetSouth(),
                        raster_tile_cache.GetHeight());
 
-  raster_tile_cache.UpdateTiles(path, x, y,
-                                projection.DistancePixelsCoarse(radius));
+  return raster_tile_cache.PrepareTiles(x, y,
+                                        projection.DistancePixelsCoarse(radius));
 }
 
 short
@@ -41,7 +41,13 @@ class RasterMap : private NonCopyable {
   RasterProjection projection;
 
 public:
-  RasterMap(const TCHAR *path, const TCHAR *world_file, FileCache *cache,
+  /**
+   * @param raw_file an optional uncompressed terrain file (see
+   * RasterTileCache::SaveRaw()) which is preferred over decoding the
+   * JPEG2000 file; may be NULL
+   */
+  RasterMap(const TCHAR *path, const TCHAR *world_file,
+            const TCHAR *raw_file, FileCache *cache,
             OperationEnvironment &operation);
   ~RasterMap();
 
@@ -65,6 +71,33 @@ public:
 
   void SetViewCenter(const GeoPoint &location, fixed radius);
 
+  /**
+   * The first step of the asynchronous version of SetViewCenter():
+   * determine which tiles need to be loaded.  The caller must have
+   * exclusive access to this object.
+   *
+   * @return true if LoadTiles() needs to be called
+   */
+  bool PrepareTiles(const GeoPoint &location, fixed radius);
+
+  /**
+   * Decode the tiles selected by PrepareTiles().  This is expensive,
+   * but may run while other threads are reading from this object.
+   *
+   * @see RasterTileCache::LoadStagedTiles()
+   */
+  void LoadTiles() {
+    raster_tile_cache.LoadStagedTiles(path);
+  }
+
+  /**
+   * Publish the tiles decoded by LoadTiles().  The caller must have
+   * exclusive access to this object.
+   */
+  void CommitTiles() {
+    raster_tile_cache.CommitStagedTiles();
+  }
+
   /**
    * Determines if SetViewCenter() should be called again to continue
    * loading.
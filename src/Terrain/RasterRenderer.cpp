@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Terrain/RasterRenderer.hpp"
 #include "Terrain/RasterMap.hpp"
+#include "Terrain/SlopeShading.hpp"
 #include "Math/FastMath.h"
 #include "Util/Clamp.hpp"
 #include "Screen/Ramp.hpp"
@@ -32,8 +33,12 @@ Copyright_License {
 #include "Asset.hpp"
 #include "Event/Idle.hpp"
 
+#include <algorithm>
+
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 /**
  * Interpolate between x and y with i/128, i.e. i/(1 << 7).
@@ -95,9 +100,12 @@ RasterRenderer::RasterRenderer()
 #ifdef ENABLE_OPENGL
    last_quantisation_pixels(-1),
    bounds(GeoBounds::Invalid()),
+#else
+   scan_valid(false), scroll_x(0), scroll_y(0), image_valid(false),
 #endif
    image(NULL),
-   contour_column_base(NULL)
+   contour_column_base(NULL),
+   shade_row(NULL)
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -110,6 +118,7 @@ RasterRenderer::~RasterRenderer()
 {
   delete image;
   delete[] contour_column_base;
+  delete[] shade_row;
 }
 
 #ifdef ENABLE_OPENGL
@@ -185,10 +194,156 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
 
   last_quantisation_pixels = quantisation_pixels;
 #else
+  if (ScrollMap(map, projection))
+    return;
+
   height_matrix.Fill(map, projection, quantisation_pixels, true);
+
+  scan_projection = projection;
+  scan_origin = RasterPoint(0, 0);
+  scan_valid = true;
+  image_valid = false;
 #endif
 }
 
+#ifndef ENABLE_OPENGL
+
+/**
+ * Round to the nearest multiple of the given divisor, and return the
+ * quotient.
+ */
+gcc_const
+static int
+RoundDivide(int value, int divisor)
+{
+  return value >= 0
+    ? (value + divisor / 2) / divisor
+    : -((divisor / 2 - value) / divisor);
+}
+
+bool
+RasterRenderer::ScrollMap(const RasterMap &map,
+                          const WindowProjection &projection)
+{
+  if (!scan_valid ||
+      projection.GetScreenWidth() != scan_projection.GetScreenWidth() ||
+      projection.GetScreenHeight() != scan_projection.GetScreenHeight() ||
+      projection.GetScreenOrigin().x != scan_projection.GetScreenOrigin().x ||
+      projection.GetScreenOrigin().y != scan_projection.GetScreenOrigin().y ||
+      projection.GetScale() != scan_projection.GetScale() ||
+      projection.GetScreenAngle() != scan_projection.GetScreenAngle())
+    return false;
+
+  const int q = quantisation_pixels;
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+
+  /* where is the first cell on the new screen? */
+  const RasterPoint old_origin =
+    projection.GeoToScreen(scan_projection.ScreenToGeo(scan_origin));
+
+  /* number of cells to move the matrix by */
+  const int dx = RoundDivide(-old_origin.x, q);
+  const int dy = RoundDivide(-old_origin.y, q);
+
+  /* the remaining error must not exceed one pixel, which is the
+     tolerance of CompareProjection */
+  if (abs(old_origin.x + dx * q) > 1 || abs(old_origin.y + dy * q) > 1)
+    return false;
+
+  const RasterPoint new_origin(scan_origin.x + dx * q,
+                               scan_origin.y + dy * q);
+
+  /* don't drift too far from the original projection, because it is
+     only approximately a translation */
+  if (abs(new_origin.x) >= int(projection.GetScreenWidth()) ||
+      abs(new_origin.y) >= int(projection.GetScreenHeight()) ||
+      abs(dx) >= width || abs(dy) >= height)
+    return false;
+
+  if (dx == 0 && dy == 0)
+    return true;
+
+  height_matrix.Scroll(map, scan_projection, new_origin, q, dx, dy, true);
+  scan_origin = new_origin;
+
+  scroll_x += dx;
+  scroll_y += dy;
+  return true;
+}
+
+/**
+ * Move the pixels by the specified number of cells towards the top
+ * left corner, see HeightMatrix::Shift().
+ */
+static void
+ShiftImage(RawBitmap &image, unsigned width, unsigned height,
+           int dx, int dy)
+{
+  assert(unsigned(abs(dx)) < width);
+  assert(unsigned(abs(dy)) < height);
+
+  const unsigned row_size = (width - abs(dx)) * sizeof(BGRColor);
+  const unsigned n_rows = height - abs(dy);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  if (dy >= 0) {
+    for (unsigned y = 0; y < n_rows; ++y)
+      memmove(image.GetRow(y) + dest_x, image.GetRow(y + dy) + src_x,
+              row_size);
+  } else {
+    for (unsigned y = n_rows; y-- > 0;)
+      memmove(image.GetRow(y - dy) + dest_x, image.GetRow(y) + src_x,
+              row_size);
+  }
+}
+
+/**
+ * Calculate the range of cells which must be regenerated on one axis
+ * after the image has been moved by the specified number of cells.
+ * These are the exposed cells plus the ones whose slope calculation
+ * reaches into them, and the ones which have become the new edge
+ * (where the slope calculation is clipped).
+ *
+ * @param border the distance used for the slope calculation
+ * @param range1 the first range (start, end) of cells
+ * @param range2 the second range (start, end) of cells
+ */
+static void
+GetDirtyRanges(int delta, int size, int border,
+               int range1[2], int range2[2])
+{
+  if (delta > 0) {
+    range1[0] = std::max(size - delta - border, 0);
+    range1[1] = size;
+    range2[0] = 0;
+    range2[1] = std::min(border, size);
+  } else if (delta < 0) {
+    range1[0] = 0;
+    range1[1] = std::min(border - delta, size);
+    range2[0] = std::max(size - border, 0);
+    range2[1] = size;
+  } else {
+    range1[0] = range1[1] = 0;
+    range2[0] = range2[1] = 0;
+  }
+}
+
+#endif
+
+unsigned
+RasterRenderer::GetHeightSlopeFactor() const
+{
+  if (quantisation_effective == 0)
+    return 0;
+
+  return Clamp((unsigned)pixel_size, 1u,
+               /* this upper limit avoids integer overflows in the "mag"
+                  formula; it effectively limits "dd2" so calculating its
+                  square will not overflow */
+               8192u / (quantisation_effective * quantisation_effective));
+}
+
 void
 RasterRenderer::GenerateImage(bool do_shading,
                               unsigned height_scale,
@@ -204,6 +359,13 @@ RasterRenderer::GenerateImage(bool do_shading,
 
     delete[] contour_column_base;
     contour_column_base = new unsigned char[height_matrix.GetWidth()];
+
+    delete[] shade_row;
+    shade_row = new signed char[height_matrix.GetWidth()];
+
+#ifndef ENABLE_OPENGL
+    image_valid = false;
+#endif
   }
 
   if (quantisation_effective == 0) {
@@ -213,33 +375,90 @@ RasterRenderer::GenerateImage(bool do_shading,
 
   const unsigned contour_height_scale = do_contour? height_scale * 2 : 16;
 
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+
+#ifndef ENABLE_OPENGL
+  const ImageParameters parameters = {
+    do_shading, height_scale, contrast, brightness, sunazimuth,
+    quantisation_effective, GetHeightSlopeFactor(),
+  };
+
+  /* contour lines depend on the rows above, so they cannot be
+     regenerated partially */
+  if (image_valid && !do_contour && parameters == image_parameters &&
+      abs(scroll_x) < width && abs(scroll_y) < height) {
+    if (scroll_x == 0 && scroll_y == 0)
+      /* nothing has changed */
+      return;
+
+    ShiftImage(*image, width, height, scroll_x, scroll_y);
+
+    const int border = do_shading ? (int)quantisation_effective : 0;
+
+    int rows[2][2], columns[2][2];
+    GetDirtyRanges(scroll_y, height, border, rows[0], rows[1]);
+    /* HeightMatrix::Scroll() may have rescanned one more column */
+    GetDirtyRanges(scroll_x, width, border + 1, columns[0], columns[1]);
+
+    ContourStart(contour_height_scale);
+
+    for (unsigned i = 0; i < 4; ++i) {
+      /* the first two are row bands, the others column bands */
+      const int *range = i < 2 ? rows[i] : columns[i - 2];
+      if (range[0] >= range[1])
+        continue;
+
+      const PixelRect rect = i < 2
+        ? PixelRect(0, range[0], width, range[1])
+        : PixelRect(range[0], 0, range[1], height);
+
+      if (do_shading)
+        GenerateSlopeImage(height_scale, contrast, brightness,
+                           sunazimuth, contour_height_scale, rect);
+      else
+        GenerateUnshadedImage(height_scale, contour_height_scale, rect);
+    }
+
+    scroll_x = scroll_y = 0;
+    image->SetDirty();
+    return;
+  }
+
+  image_parameters = parameters;
+  image_valid = true;
+  scroll_x = scroll_y = 0;
+#endif
+
+  const PixelRect rect(0, 0, width, height);
+
   ContourStart(contour_height_scale);
 
   if (do_shading)
     GenerateSlopeImage(height_scale, contrast, brightness,
-                       sunazimuth, contour_height_scale);
+                       sunazimuth, contour_height_scale, rect);
   else
-    GenerateUnshadedImage(height_scale, contour_height_scale);
+    GenerateUnshadedImage(height_scale, contour_height_scale, rect);
 
   image->SetDirty();
 }
 
 void
 RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
-                                      const unsigned contour_height_scale)
+                                      const unsigned contour_height_scale,
+                                      const PixelRect &rect)
 {
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
-  BGRColor *dest = image->GetTopRow();
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
-    BGRColor *p = dest;
-    dest = image->GetNextRow(dest);
+  for (unsigned y = rect.top; y < (unsigned)rect.bottom; ++y) {
+    const short *src = height_matrix.GetRow(y) + rect.left;
+    BGRColor *p = image->GetRow(y) + rect.left;
 
     unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    unsigned char *contour_this_column_base =
+      contour_column_base + rect.left;
 
-    for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
+    for (unsigned x = rect.right - rect.left; x > 0; --x) {
       int h = *src++;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -270,19 +489,6 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale,
   }
 }
 
-/**
- * Clip the difference between two adjacent terrain height values to
- * sane bounds.  This works around integer overflows in the
- * GenerateSlopeImage() formula when the map file is broken, avoiding
- * the sqrt() call with a negative argument.
- */
-gcc_const
-static int
-ClipHeightDelta(int d)
-{
-  return Clamp(d, -512, 512);
-}
-
 // JMW: if zoomed right in (e.g. one unit is larger than terrain
 // grid), then increase the step size to be equal to the terrain
 // grid for purposes of calculating slope, to avoid shading problems
@@ -292,7 +498,8 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz,
-                                   const unsigned contour_height_scale)
+                                   const unsigned contour_height_scale,
+                                   const PixelRect &rect)
 {
   assert(quantisation_effective > 0);
 
@@ -302,19 +509,22 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   border.right = height_matrix.GetWidth() - quantisation_effective;
   border.bottom = height_matrix.GetHeight() - quantisation_effective;
 
-  const unsigned height_slope_factor =
-    Clamp((unsigned)pixel_size, 1u,
-          /* this upper limit avoids integer overflows in the "mag"
-             formula; it effectively limits "dd2" so calculating its
-             square will not overflow */
-          8192u / (quantisation_effective * quantisation_effective));
+  const unsigned height_slope_factor = GetHeightSlopeFactor();
+
+  const SlopeShadingParameters params = { sx, sy, sz, contrast };
+
+  /* the range of columns which have both neighbours; their shading is
+     calculated in one SlopeShadingRow() call per row */
+  const int interior_start = std::max(border.left, rect.left);
+  const int interior_end = std::min(std::max(border.right, border.left),
+                                    rect.right);
+  const unsigned interior_size = std::max(interior_end - interior_start, 0);
 
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
 
-  BGRColor *dest = image->GetTopRow();
+  for (unsigned y = rect.top; y < (unsigned)rect.bottom; ++y) {
+    const short *src = height_matrix.GetRow(y) + rect.left;
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -326,13 +536,20 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
-    BGRColor *p = dest;
-    dest = image->GetNextRow(dest);
+    const short *const interior = height_matrix.GetRow(y) + interior_start;
+    SlopeShadingRow(interior, interior - row_minus_offset,
+                    interior + row_plus_offset,
+                    interior_size, quantisation_effective, p31,
+                    2 * quantisation_effective * p31 * height_slope_factor,
+                    params, shade_row);
+
+    BGRColor *p = image->GetRow(y) + rect.left;
 
     unsigned contour_row_base = ContourInterval(*src, contour_height_scale);
-    unsigned char *contour_this_column_base = contour_column_base;
+    unsigned char *contour_this_column_base =
+      contour_column_base + rect.left;
 
-    for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
+    for (unsigned x = rect.left; x < (unsigned)rect.right; ++x, ++src) {
       int h = *src;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -388,29 +605,22 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
           continue;
         }
 
-        const int p32 = ClipHeightDelta(h_above - h_below);
-        const int p22 = ClipHeightDelta(h_right - h_left);
+        int sindex;
+        if (x - unsigned(interior_start) < interior_size) {
+          sindex = shade_row[x - unsigned(interior_start)];
+        } else {
+          const int p32 = ClipHeightDelta(h_above - h_below);
+          const int p22 = ClipHeightDelta(h_right - h_left);
 
-        const unsigned p20 = column_plus_index + column_minus_index;
+          const unsigned p20 = column_plus_index + column_minus_index;
 
-        const int dd0 = p22 * int(p31);
-        const int dd1 = int(p20) * p32;
-        const unsigned dd2 = p20 * p31 * height_slope_factor;
-        const int num = (int(dd2) * sz + dd0 * sx + dd1 * sy);
-        const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
-#ifdef FIXED_MATH
-        const unsigned mag = isqrt4(square_mag);
-#else
-        const unsigned mag = (unsigned)sqrt((fixed)square_mag);
-#endif
-        /* this is a workaround for a SIGFPE (division by zero)
-           observed by our users on some Android devices (e.g. Nexus
-           7), even though we did our best to make sure that the
-           integer arithmetics above can't overflow */
-        /* TODO: debug this problem and replace this workaround */
-        const int sval = num / int(mag|1);
-        const int sindex = (sval - sz) * contrast / 128;
-        *p++ = oColorBuf[h + 256 * Clamp(sindex, -63, 63)];
+          const int dd0 = p22 * int(p31);
+          const int dd1 = int(p20) * p32;
+          const unsigned dd2 = p20 * p31 * height_slope_factor;
+          sindex = SlopeShadingIndex(dd0, dd1, dd2, params);
+        }
+
+        *p++ = oColorBuf[h + 256 * sindex];
       } else if (RasterBuffer::IsWater(h)) {
         // we're in the water, so look up the color for water
         *p++ = oColorBuf[255];
@@ -428,7 +638,8 @@ void
 RasterRenderer::GenerateSlopeImage(unsigned height_scale,
                                    int contrast, int brightness,
                                    const Angle sunazimuth,
-                                   const unsigned contour_height_scale)
+                                   const unsigned contour_height_scale,
+                                   const PixelRect &rect)
 {
   const Angle fudgeelevation = Angle::Degrees(10) +
     Angle::Degrees(80.0 / 255.0) * brightness;
@@ -438,13 +649,17 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   const int sz = (int)(255 * fudgeelevation.fastsine());
 
   GenerateSlopeImage(height_scale, contrast,
-                     sx, sy, sz, contour_height_scale);
+                     sx, sy, sz, contour_height_scale, rect);
 }
 
 void
 RasterRenderer::PrepareColorTable(const ColorRamp *color_ramp, bool do_water,
                                   unsigned height_scale, int interp_levels)
 {
+#ifndef ENABLE_OPENGL
+  image_valid = false;
+#endif
+
   for (int i = 0; i < 256; i++) {
     for (int mag = -64; mag < 64; mag++) {
       BGRColor color;
@@ -26,11 +26,15 @@ Copyright_License {
 
 #include "Terrain/HeightMatrix.hpp"
 #include "Screen/RawBitmap.hpp"
+#include "Screen/Point.hpp"
 #include "Math/fixed.hpp"
 #include "Util/NonCopyable.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
+#else
+#include "Projection/WindowProjection.hpp"
+#include "Math/Angle.hpp"
 #endif
 
 #define NUM_COLOR_RAMP_LEVELS 13
@@ -66,6 +70,58 @@ class RasterRenderer : private NonCopyable {
    * texture has to be redrawn.
    */
   GeoBounds bounds;
+#else
+  /**
+   * The projection which was used to fill the #HeightMatrix.  It is
+   * not updated when the map is scrolled; only #scan_origin is
+   * moved.  Only valid if #scan_valid is set.
+   */
+  WindowProjection scan_projection;
+
+  /**
+   * The location of the first #HeightMatrix cell on the screen of
+   * #scan_projection.
+   */
+  RasterPoint scan_origin;
+
+  bool scan_valid;
+
+  /**
+   * The number of cells the #HeightMatrix has been moved since the
+   * last GenerateImage() call.
+   */
+  int scroll_x, scroll_y;
+
+  /**
+   * The GenerateImage() parameters which affect the pixels.  If they
+   * are unchanged, the previous image may be scrolled instead of
+   * being regenerated completely.
+   */
+  struct ImageParameters {
+    bool do_shading;
+    unsigned height_scale;
+    int contrast, brightness;
+    Angle sunazimuth;
+    unsigned quantisation_effective, height_slope_factor;
+
+    bool operator==(const ImageParameters &other) const {
+      return do_shading == other.do_shading &&
+        height_scale == other.height_scale &&
+        contrast == other.contrast &&
+        brightness == other.brightness &&
+        sunazimuth == other.sunazimuth &&
+        quantisation_effective == other.quantisation_effective &&
+        height_slope_factor == other.height_slope_factor;
+    }
+  };
+
+  ImageParameters image_parameters;
+
+  /**
+   * Does #image contain the rendering of the #HeightMatrix, moved by
+   * #scroll_x and #scroll_y, with #image_parameters?
+   */
+  bool image_valid;
 #endif
 
   HeightMatrix height_matrix;
@@ -73,6 +129,12 @@ class RasterRenderer : private NonCopyable {
 
   unsigned char *contour_column_base;
 
+  /**
+   * Temporary buffer for GenerateSlopeImage(): the illumination
+   * index of the current row, see SlopeShadingRow().
+   */
+  signed char *shade_row;
+
   fixed pixel_size;
 
   BGRColor color_table[256 * 128];
@@ -113,6 +175,15 @@ public:
   const GLTexture &BindAndGetTexture() const {
     return image->BindAndGetTexture();
   }
+#else
+  /**
+   * Discard the previous #HeightMatrix and image, i.e. the next
+   * ScanMap() call will not attempt to scroll.
+   */
+  void Invalidate() {
+    scan_valid = false;
+    image_valid = false;
+  }
 #endif
 
   /**
@@ -124,12 +195,16 @@ public:
                          unsigned height_scale, int interp_levels);
 
   /**
-   * Scan the map and fill the height matrix.
+   * Scan the map and fill the height matrix.  If the projection has
+   * only been moved since the previous call, the existing values are
+   * scrolled and only the newly exposed cells are scanned.
    */
   void ScanMap(const RasterMap &map, const WindowProjection &projection);
 
   /**
-   * Convert the height matrix into the image.
+   * Convert the height matrix into the image.  After a scrolling
+   * ScanMap() call, only the pixels which may have changed are
+   * regenerated.
    */
   void GenerateImage(bool do_shading,
                      unsigned height_scale, int contrast, int brightness,
@@ -141,18 +216,39 @@ public:
   }
 
 protected:
+#ifndef ENABLE_OPENGL
+  /**
+   * Attempt to reuse the #HeightMatrix after the projection has been
+   * moved.
+   *
+   * @return false if the projection has changed in another way (or
+   * has been moved too far), and the caller must fill the whole
+   * #HeightMatrix
+   */
+  bool ScrollMap(const RasterMap &map, const WindowProjection &projection);
+#endif
+
+  gcc_pure
+  unsigned GetHeightSlopeFactor() const;
+
   /**
    * Convert the height matrix into the image, without shading.
+   *
+   * @param rect the range of cells to be converted
    */
   void GenerateUnshadedImage(unsigned height_scale,
-                             const unsigned contour_height_scale);
+                             const unsigned contour_height_scale,
+                             const PixelRect &rect);
 
   /**
    * Convert the height matrix into the image, with slope shading.
+   *
+   * @param rect the range of cells to be converted
    */
   void GenerateSlopeImage(unsigned height_scale, int contrast,
                           const int sx, const int sy, const int sz,
-                          const unsigned contour_height_scale);
+                          const unsigned contour_height_scale,
+                          const PixelRect &rect);
 
   /**
    * Convert the height matrix into the image, with slope shading.
@@ -160,7 +256,8 @@ protected:
   void GenerateSlopeImage(unsigned height_scale,
                           int contrast, int brightness,
                           const Angle sunazimuth,
-                          const unsigned contour_height_scale);
+                          const unsigned contour_height_scale,
+                          const PixelRect &rect);
 
 private:
 
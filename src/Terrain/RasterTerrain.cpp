@@ -24,6 +24,7 @@ Copyright_License {
 #include "Terrain/RasterTerrain.hpp"
 #include "Profile/Profile.hpp"
 #include "OS/PathName.hpp"
+#include "OS/FileUtil.hpp"
 #include "Compatibility/path.h"
 
 #include <windef.h> /* for MAX_PATH */
@@ -34,18 +35,29 @@ RasterTerrain *
 RasterTerrain::OpenTerrain(FileCache *cache, OperationEnvironment &operation)
 {
   TCHAR szFile[MAX_PATH], world_file_buffer[MAX_PATH];
-  const TCHAR *world_file;
+  TCHAR raw_file_buffer[MAX_PATH];
+  const TCHAR *world_file, *raw_file = NULL;
 
   if (Profile::GetPath(ProfileKeys::MapFile, szFile)) {
     _tcscpy(world_file_buffer, szFile);
     _tcscat(world_file_buffer, _T(DIR_SEPARATOR_S "terrain.j2w"));
     world_file = world_file_buffer;
 
+    /* use the uncompressed terrain file generated by ConvertTerrain,
+       unless it is older than the map file */
+    _tcscpy(raw_file_buffer, szFile);
+    _tcscat(raw_file_buffer, _T(".terrain"));
+    if (File::Exists(raw_file_buffer) &&
+        File::GetLastModification(raw_file_buffer) >=
+        File::GetLastModification(szFile))
+      raw_file = raw_file_buffer;
+
     _tcscat(szFile, _T("/terrain.jp2"));
   } else
     return NULL;
 
-  RasterTerrain *rt = new RasterTerrain(szFile, world_file, cache, operation);
+  RasterTerrain *rt = new RasterTerrain(szFile, world_file, raw_file,
+                                        cache, operation);
   if (!rt->map.IsDefined()) {
     delete rt;
     return NULL;
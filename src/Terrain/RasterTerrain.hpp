@@ -44,6 +44,7 @@ public:
   friend class RoutePlannerGlue; // for route planning
   friend class ProtectedTaskManager; // for intersection
   friend class WaypointVisitorMap; // for intersection rendering
+  friend class TerrainTileLoader; // for loading tiles without the lock
 
   /** invalid value for terrain */
   static constexpr short TERRAIN_INVALID = RasterBuffer::TERRAIN_INVALID;
@@ -57,9 +58,10 @@ public:
  * Constructor.  Returns uninitialised object. 
  * 
  */
-  RasterTerrain(const TCHAR *path, const TCHAR *world_file, FileCache *cache,
+  RasterTerrain(const TCHAR *path, const TCHAR *world_file,
+                const TCHAR *raw_file, FileCache *cache,
                 OperationEnvironment &operation)
-    :Guard<RasterMap>(map), map(path, world_file, cache, operation) {}
+    :Guard<RasterMap>(map), map(path, world_file, raw_file, cache, operation) {}
 
   const Serial &GetSerial() const {
     return map.GetSerial();
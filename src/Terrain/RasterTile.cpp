@@ -50,16 +50,6 @@ RasterTile::LoadCache(FILE *file)
   return true;
 }
 
-void
-RasterTile::Enable()
-{
-  if (!width || !height) {
-    Disable();
-  } else {
-    buffer.Resize(width, height);
-  }
-}
-
 short
 RasterTile::GetHeight(unsigned x, unsigned y) const
 {
@@ -95,6 +85,48 @@ RasterTile::GetInterpolatedHeight(unsigned lx, unsigned ly,
   return buffer.GetInterpolated(lx, ly, ix, iy);
 }
 
+void
+RasterTile::BuildReduced(const RasterBuffer &buffer,
+                         RasterBuffer (&reduced)[REDUCED_LEVELS])
+{
+  assert(buffer.IsDefined());
+
+  const RasterBuffer *src = &buffer;
+  for (unsigned i = 0; i < REDUCED_LEVELS; ++i) {
+    reduced[i].Reduce(*src);
+    src = &reduced[i];
+  }
+}
+
+size_t
+RasterTile::GetPyramidSize(unsigned width, unsigned height)
+{
+  size_t size = 0;
+  for (unsigned i = 0; i <= REDUCED_LEVELS; ++i) {
+    size += width * height;
+    width = RasterBuffer::GetReducedSize(width);
+    height = RasterBuffer::GetReducedSize(height);
+  }
+
+  return size;
+}
+
+void
+RasterTile::SetMapped(const short *values)
+{
+  buffer.SetMapped(values, width, height);
+  values += width * height;
+
+  const RasterBuffer *src = &buffer;
+  for (unsigned i = 0; i < REDUCED_LEVELS; ++i) {
+    const unsigned w = RasterBuffer::GetReducedSize(src->GetWidth());
+    const unsigned h = RasterBuffer::GetReducedSize(src->GetHeight());
+    reduced[i].SetMapped(values, w, h);
+    values += w * h;
+    src = &reduced[i];
+  }
+}
+
 bool
 RasterTile::CheckTileVisibility(int view_x, int view_y, unsigned view_radius)
 {
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Util/NonCopyable.hpp"
 
 #include <stdio.h>
+#include <assert.h>
 
 class RasterTile : private NonCopyable {
   struct MetaData {
@@ -35,6 +36,14 @@ class RasterTile : private NonCopyable {
   };
 
 public:
+  /**
+   * The number of reduced-resolution copies of the height values.
+   * Level 1 has half the width and height of the tile, level 2 a
+   * quarter and so on.
+   */
+  static constexpr unsigned REDUCED_LEVELS = 3;
+
+
   unsigned int xstart, ystart, xend, yend;
   unsigned int width, height;
 
@@ -48,6 +57,11 @@ public:
 
   RasterBuffer buffer;
 
+  /**
+   * The reduced-resolution copies of #buffer; element 0 is level 1.
+   */
+  RasterBuffer reduced[REDUCED_LEVELS];
+
 public:
   RasterTile()
     :xstart(0), ystart(0), xend(0), yend(0),
@@ -98,9 +112,46 @@ public:
 
   void Disable() {
     buffer.Reset();
+
+    for (unsigned i = 0; i < REDUCED_LEVELS; ++i)
+      reduced[i].Reset();
   }
 
-  void Enable();
+  /**
+   * Fill the reduced-resolution copies of the specified height
+   * buffer.
+   */
+  static void BuildReduced(const RasterBuffer &buffer,
+                           RasterBuffer (&reduced)[REDUCED_LEVELS]);
+
+  /**
+   * Install the height data which was decoded into the specified
+   * buffers.  The old (usually empty) buffers are returned in the
+   * parameters.
+   */
+  void SwapBuffer(RasterBuffer &other,
+                  RasterBuffer (&other_reduced)[REDUCED_LEVELS]) {
+    buffer.Swap(other);
+
+    for (unsigned i = 0; i < REDUCED_LEVELS; ++i)
+      reduced[i].Swap(other_reduced[i]);
+  }
+
+  /**
+   * Returns the number of height values of a tile with the given
+   * size, including all reduced levels.  This is the layout expected
+   * by SetMapped().
+   */
+  gcc_const
+  static size_t GetPyramidSize(unsigned width, unsigned height);
+
+  /**
+   * Refer to height values owned by somebody else, e.g. inside a
+   * file mapping.  The values of all reduced levels must follow the
+   * full-resolution values, see GetPyramidSize().
+   */
+  void SetMapped(const short *values);
+
   bool IsEnabled() const {
     return buffer.IsDefined();
   }
@@ -137,11 +188,28 @@ public:
 
   bool VisibilityChanged(int view_x, int view_y, unsigned view_radius);
 
+  /**
+   * Returns the height buffer of the specified resolution level (0
+   * is the full resolution).
+   */
+  const RasterBuffer &GetLevel(unsigned level) const {
+    assert(level <= REDUCED_LEVELS);
+
+    return level == 0 ? buffer : reduced[level - 1];
+  }
+
+  /**
+   * @param level the resolution level to be scanned; the (full
+   * resolution) coordinates are scaled down accordingly
+   */
   void ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
-                short *dest, unsigned size, bool interpolate) const {
-    buffer.ScanLine(ax - (xstart << 8), ay - (ystart << 8),
-                    bx - (xstart << 8), by - (ystart << 8),
-                    dest, size, interpolate);
+                short *dest, unsigned size, bool interpolate,
+                unsigned level=0) const {
+    GetLevel(level).ScanLine((ax - (xstart << 8)) >> level,
+                             (ay - (ystart << 8)) >> level,
+                             (bx - (xstart << 8)) >> level,
+                             (by - (ystart << 8)) >> level,
+                             dest, size, interpolate);
   }
 };
 
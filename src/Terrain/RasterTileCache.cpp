@@ -28,15 +28,37 @@ Copyright_License {
 #include "IO/ZipLineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Math/FastMath.h"
+#include "Thread/Mutex.hpp"
+#include "OS/FileMapping.hpp"
 
 #include <string.h>
 #include <algorithm>
 
+/**
+ * The JPEG2000 decoder reports to the global #raster_tile_current
+ * pointer, therefore only one file may be decoded at a time.  This
+ * mutex serialises terrain and weather map decoding, which may run
+ * in different threads.
+ */
+static Mutex jasper_mutex;
+
 short*
 RasterTileCache::GetImageBuffer(unsigned index)
 {
-  if (TileRequest(index))
-    return tiles.GetLinear(index).GetImageBuffer();
+  if (!loading_staged)
+    return NULL;
+
+  for (auto it = staged_tiles.begin(), end = staged_tiles.end();
+       it != end; ++it) {
+    if (it->index == index) {
+      const RasterTile &tile = tiles.GetLinear(index);
+      if (!tile.IsDefined())
+        return NULL;
+
+      it->buffer.Resize(tile.width, tile.height);
+      return it->buffer.GetData();
+    }
+  }
 
   return NULL;
 }
@@ -45,6 +67,11 @@ void
 RasterTileCache::SetTile(unsigned index,
                          int xstart, int ystart, int xend, int yend)
 {
+  if (loading_staged)
+    /* the tile metadata is already known; don't modify it while
+       other threads may be reading it */
+    return;
+
   if (!segments.empty() && !segments.last().IsTileSegment())
     /* link current marker segment with this tile */
     segments.last().tile = index;
@@ -68,7 +95,9 @@ struct RTDistanceSort {
 bool
 RasterTileCache::PollTiles(int x, int y, unsigned radius)
 {
-  if (scan_overview)
+  if (scan_overview || IsMapped())
+    /* nothing to load: either we're still loading the overview, or
+       all tiles are mapped */
     return false;
 
   /* tiles are usually 256 pixels wide; with a radius smaller than
@@ -77,14 +106,6 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
      the screen will be loaded in advance */
   radius += 256;
 
-  /**
-   * Maximum number of tiles loaded at a time, to reduce system load
-   * peaks.
-   */
-  constexpr unsigned MAX_ACTIVATE = MAX_ACTIVE_TILES > 32
-    ? 16
-    : MAX_ACTIVE_TILES / 2;
-
   /* query all tiles; all tiles which are either in range or already
      loaded are added to RequestTiles */
 
@@ -130,18 +151,6 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
   return num_activate > 0;
 }
 
-bool
-RasterTileCache::TileRequest(unsigned index)
-{
-  RasterTile &tile = tiles.GetLinear(index);
-
-  if (!tile.IsRequested())
-    return false;
-
-  tile.Enable();
-  return true; // want to load this one!
-}
-
 short
 RasterTileCache::GetHeight(unsigned px, unsigned py) const
 {
@@ -183,6 +192,9 @@ RasterTileCache::SetSize(unsigned _width, unsigned _height,
                          unsigned _tile_width, unsigned _tile_height,
                          unsigned tile_columns, unsigned tile_rows)
 {
+  if (loading_staged)
+    return;
+
   width = _width;
   height = _height;
   tile_width = _tile_width;
@@ -199,6 +211,9 @@ void
 RasterTileCache::SetLatLonBounds(double _lon_min, double _lon_max,
                                  double _lat_min, double _lat_max)
 {
+  if (loading_staged)
+    return;
+
   const Angle lon_min(Angle::Degrees(_lon_min));
   const Angle lon_max(Angle::Degrees(_lon_max));
   const Angle lat_min(Angle::Degrees(_lat_min));
@@ -211,6 +226,21 @@ RasterTileCache::SetLatLonBounds(double _lon_min, double _lon_max,
   bounds_initialised = true;
 }
 
+void
+RasterTileCache::BuildOverviewLevels()
+{
+  const RasterBuffer *src = &overview;
+  for (unsigned i = 0; i < OVERVIEW_REDUCED_LEVELS; ++i) {
+    overview_reduced[i].Reduce(*src);
+    src = &overview_reduced[i];
+  }
+}
+
+RasterTileCache::~RasterTileCache()
+{
+  delete mapping;
+}
+
 void
 RasterTileCache::Reset()
 {
@@ -218,13 +248,21 @@ RasterTileCache::Reset()
   height = 0;
   initialised = false;
   bounds_initialised = false;
+  dirty = false;
   segments.clear();
   scan_overview = true;
 
   overview.Reset();
+  for (unsigned i = 0; i < OVERVIEW_REDUCED_LEVELS; ++i)
+    overview_reduced[i].Reset();
 
   for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it)
     it->Disable();
+
+  /* now that no buffer refers to the mapping anymore, it can be
+     unmapped */
+  delete mapping;
+  mapping = NULL;
 }
 
 gcc_pure
@@ -324,24 +362,25 @@ RasterTileCache::MarkerSegment(long file_offset, unsigned id)
 
 extern RasterTileCache *raster_tile_current;
 
-void
+bool
 RasterTileCache::LoadJPG2000(const char *jp2_filename)
 {
   jas_stream_t *in;
 
+  const ScopeLock protect(jasper_mutex);
+
   raster_tile_current = this;
 
   in = jas_stream_fopen(jp2_filename, "rb");
-  if (!in) {
-    Reset();
-    return;
-  }
+  if (!in)
+    return false;
 
   if (operation != NULL)
     operation->SetProgressRange(jas_stream_length(in) / 65536);
 
   jp2_decode(in, scan_overview ? "xcsoar=2" : "xcsoar=1");
   jas_stream_close(in);
+  return true;
 }
 
 bool
@@ -422,7 +461,9 @@ RasterTileCache::LoadOverview(const char *path, const TCHAR *world_file,
   if (initialised && !bounds_initialised)
     initialised = false;
 
-  if (!initialised)
+  if (initialised)
+    BuildOverviewLevels();
+  else
     Reset();
 
   operation = NULL;
@@ -432,23 +473,76 @@ RasterTileCache::LoadOverview(const char *path, const TCHAR *world_file,
 void
 RasterTileCache::UpdateTiles(const char *path, int x, int y, unsigned radius)
 {
-  if (!PollTiles(x, y, radius))
+  if (!PrepareTiles(x, y, radius))
     return;
 
+  LoadStagedTiles(path);
+  CommitStagedTiles();
+}
+
+bool
+RasterTileCache::PrepareTiles(int x, int y, unsigned radius)
+{
+  assert(!loading_staged);
+
+  staged_tiles.clear();
+
+  if (!PollTiles(x, y, radius))
+    return false;
+
+  for (auto it = request_tiles.begin(), end = request_tiles.end();
+       it != end; ++it) {
+    const RasterTile &tile = tiles.GetLinear(*it);
+    if (tile.IsRequested()) {
+      StagedTile &staged = staged_tiles.append();
+      staged.index = *it;
+      assert(!staged.buffer.IsDefined());
+    }
+  }
+
+  return !staged_tiles.empty();
+}
+
+void
+RasterTileCache::LoadStagedTiles(const char *path)
+{
+  assert(!loading_staged);
+
   remaining_segments = 0;
 
+  loading_staged = true;
   LoadJPG2000(path);
+  loading_staged = false;
 
-  /* permanently disable the requested tiles which are still not
-     loaded, to prevent trying to reload them over and over in a busy
-     loop */
-  for (auto it = request_tiles.begin(), end = request_tiles.end();
-      it != end; ++it) {
-    RasterTile &tile = tiles.GetLinear(*it);
-    if (tile.IsRequested() && !tile.IsEnabled())
+  for (auto it = staged_tiles.begin(), end = staged_tiles.end();
+       it != end; ++it)
+    if (it->buffer.IsDefined())
+      RasterTile::BuildReduced(it->buffer, it->reduced);
+}
+
+void
+RasterTileCache::CommitStagedTiles()
+{
+  assert(!loading_staged);
+
+  for (auto it = staged_tiles.begin(), end = staged_tiles.end();
+       it != end; ++it) {
+    RasterTile &tile = tiles.GetLinear(it->index);
+    if (it->buffer.IsDefined())
+      tile.SwapBuffer(it->buffer, it->reduced);
+    else
+      /* permanently disable the requested tiles which could not be
+         loaded, to prevent trying to reload them over and over in a
+         busy loop */
       tile.Clear();
+
+    it->buffer.Reset();
+    for (unsigned i = 0; i < RasterTile::REDUCED_LEVELS; ++i)
+      it->reduced[i].Reset();
   }
 
+  staged_tiles.clear();
+
   ++serial;
 }
 
@@ -554,6 +648,8 @@ RasterTileCache::LoadCache(FILE *file)
             overview_size, file) != overview_size)
     return false;
 
+  BuildOverviewLevels();
+
   initialised = true;
   scan_overview = false;
   return true;
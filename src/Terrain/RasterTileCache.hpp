@@ -28,6 +28,7 @@ Copyright_License {
 #include "Geo/GeoBounds.hpp"
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hpp"
+#include "Util/AllocatedGrid.hpp"
 #include "Util/Serial.hpp"
 
 #include <assert.h>
@@ -41,6 +42,7 @@ Copyright_License {
 struct RasterLocation;
 struct GridLocation;
 class OperationEnvironment;
+class FileMapping;
 
 class RasterTileCache : private NonCopyable {
   static constexpr unsigned MAX_RTC_TILES = 4096;
@@ -62,12 +64,35 @@ class RasterTileCache : private NonCopyable {
   static constexpr unsigned MAX_ACTIVE_TILES = 16;
 #endif
 
+  /**
+   * Maximum number of tiles loaded at a time, to reduce system load
+   * peaks.
+   */
+  static constexpr unsigned MAX_ACTIVATE = MAX_ACTIVE_TILES > 32
+    ? 16
+    : MAX_ACTIVE_TILES / 2;
+
   /**
    * The width and height of the terrain bitmap is shifted by this
    * number of bits to determine the overview size.
    */
   static constexpr unsigned OVERVIEW_BITS = 4;
 
+  static_assert(RasterTile::REDUCED_LEVELS + 1 == OVERVIEW_BITS,
+                "the reduced tile levels must fill the gap to the overview");
+
+  /**
+   * The number of reduced-resolution copies of the overview.
+   */
+  static constexpr unsigned OVERVIEW_REDUCED_LEVELS = 3;
+
+  /**
+   * The coarsest resolution level.  Level 0 is the full resolution,
+   * level #OVERVIEW_BITS is the overview.
+   */
+  static constexpr unsigned MAX_LEVEL =
+    OVERVIEW_BITS + OVERVIEW_REDUCED_LEVELS;
+
   /**
    * Target number of steps in intersection searches; total distance
    * is shifted by this number of bits
@@ -114,6 +139,17 @@ protected:
     }
   };
 
+  /**
+   * A tile which is being decoded into a private buffer, to be moved
+   * into #tiles by CommitStagedTiles().
+   */
+  struct StagedTile {
+    uint16_t index;
+
+    RasterBuffer buffer;
+    RasterBuffer reduced[RasterTile::REDUCED_LEVELS];
+  };
+
   struct CacheHeader {
 #ifdef FIXED_MATH
     static constexpr unsigned VERSION = 0xa;
@@ -129,6 +165,51 @@ protected:
     GeoBounds bounds;
   };
 
+  /**
+   * The header of the uncompressed terrain file written by SaveRaw().
+   * It is followed by #RawTileHeader for each tile, the overview and
+   * the height values of each tile (see RasterTile::GetPyramidSize()),
+   * all in native byte order.
+   */
+  struct RawHeader {
+    static constexpr uint32_t MAGIC = 0x72544358;
+    static constexpr uint32_t VERSION = 3;
+
+    /**
+     * Written in host byte order; a file created on a machine with a
+     * different byte order has this value swapped, and LoadRaw()
+     * ignores it.
+     */
+    static constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+
+    uint32_t magic, version;
+    uint32_t width, height;
+    uint32_t tile_width, tile_height;
+    uint32_t tile_columns, tile_rows;
+
+    /**
+     * Offset of the overview within the file.
+     */
+    uint32_t overview_offset;
+
+    /**
+     * Always #BYTE_ORDER_TAG.
+     */
+    uint32_t byte_order;
+
+    double lon_min, lon_max, lat_min, lat_max;
+  };
+
+  struct RawTileHeader {
+    uint32_t xstart, ystart, xend, yend;
+
+    /**
+     * Offset of the height values within the file.  Zero if the tile
+     * has no data.
+     */
+    uint32_t offset;
+  };
+
   bool initialised;
 
   /** is the "bounds" attribute valid? */
@@ -146,6 +227,13 @@ protected:
   unsigned short tile_width, tile_height;
 
   RasterBuffer overview;
+
+  /**
+   * Reduced-resolution copies of #overview for zoomed-out views;
+   * element 0 has half the resolution of #overview.
+   */
+  RasterBuffer overview_reduced[OVERVIEW_REDUCED_LEVELS];
+
   bool scan_overview;
   unsigned int width, height;
   unsigned int overview_width_fine, overview_height_fine;
@@ -166,19 +254,60 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * The tiles selected by PrepareTiles(), with their decoded height
+   * data after LoadStagedTiles() has finished.
+   */
+  StaticArray<StagedTile, MAX_ACTIVATE> staged_tiles;
+
+  /**
+   * True while LoadStagedTiles() is running.  The decoder callbacks
+   * then write only to #staged_tiles and leave all other attributes
+   * alone, because other threads may be reading them concurrently.
+   */
+  bool loading_staged;
+
   /**
    * Progress callbacks for loading the file during startup.
    */
   OperationEnvironment *operation;
 
+  /**
+   * The uncompressed terrain file loaded by LoadRaw().  If this is
+   * set, then all tiles and the overview refer to this mapping, and
+   * there is nothing to decode.
+   */
+  FileMapping *mapping;
+
 public:
-  RasterTileCache():operation(NULL) {
+  RasterTileCache():loading_staged(false), operation(NULL), mapping(NULL) {
     Reset();
   }
 
+  ~RasterTileCache();
+
 protected:
   void ScanTileLine(GridLocation start, GridLocation end,
-                    short *buffer, unsigned size, bool interpolate) const;
+                    short *buffer, unsigned size, bool interpolate,
+                    unsigned level) const;
+
+  /**
+   * Returns the overview buffer of the specified resolution level,
+   * which must be at least #OVERVIEW_BITS.
+   */
+  const RasterBuffer &GetOverviewLevel(unsigned level) const {
+    assert(level >= OVERVIEW_BITS);
+    assert(level <= MAX_LEVEL);
+
+    return level == OVERVIEW_BITS
+      ? overview
+      : overview_reduced[level - OVERVIEW_BITS - 1];
+  }
+
+  /**
+   * Build #overview_reduced after the overview has been loaded.
+   */
+  void BuildOverviewLevels();
 
 public:
   /**
@@ -204,7 +333,9 @@ public:
 
   /**
    * Scan a straight line and fill the buffer with the specified
-   * number of samples along the line.
+   * number of samples along the line.  The resolution level is chosen
+   * to match the distance between two samples, which avoids aliasing
+   * and skips the tiles when the overview is good enough.
    *
    * @param start the sub-pixel start location
    * @param end the sub-pixel end location
@@ -227,7 +358,10 @@ public:
                int h_origin, const int slope_fact) const;
 
 protected:
-  void LoadJPG2000(const char *path);
+  /**
+   * @return false if the file could not be opened
+   */
+  bool LoadJPG2000(const char *path);
 
   /**
    * Load a world file (*.tfw or *.j2w).
@@ -253,8 +387,68 @@ public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
 
+  /**
+   * Decode all tiles and write them to an uncompressed terrain file
+   * which can later be loaded with LoadRaw().  This is expensive; it
+   * is meant to be used by a conversion tool.
+   *
+   * @param path the JPEG2000 file which was passed to LoadOverview()
+   */
+  bool SaveRaw(FILE *file, const char *path);
+
+  /**
+   * Map an uncompressed terrain file written by SaveRaw().  Tiles
+   * don't need to be decoded, they refer to the mapping, and the
+   * kernel's page cache decides which of them stay in memory.
+   *
+   * Fails if the file is malformed, or was written with a different
+   * #RawHeader::VERSION or byte order.  Such a file is not rewritten;
+   * the caller falls back to the JPEG2000 file until ConvertTerrain
+   * is run again.
+   */
+  bool LoadRaw(const TCHAR *path);
+
+  /**
+   * Was this object loaded by LoadRaw()?
+   */
+  bool IsMapped() const {
+    return mapping != NULL;
+  }
+
+  /**
+   * Synchronously load the tiles around the specified pixel
+   * location.  This is a shortcut for PrepareTiles(),
+   * LoadStagedTiles() and CommitStagedTiles().
+   */
   void UpdateTiles(const char *path, int x, int y, unsigned radius);
 
+  /**
+   * Determine which tiles need to be loaded for the specified view,
+   * and schedule them for LoadStagedTiles().
+   *
+   * The caller must have exclusive access to this object.
+   *
+   * @return true if LoadStagedTiles() needs to be called
+   */
+  bool PrepareTiles(int x, int y, unsigned radius);
+
+  /**
+   * Decode the tiles selected by PrepareTiles() into private staging
+   * buffers.  This is the expensive part, but it does not modify
+   * anything that is visible to readers; therefore it may run while
+   * other threads are reading from this object.  Only one thread may
+   * prepare, load and commit tiles at a time.
+   */
+  void LoadStagedTiles(const char *path);
+
+  /**
+   * Move the staging buffers filled by LoadStagedTiles() into the
+   * tile grid.  This is cheap; it only swaps pointers.
+   *
+   * The caller must have exclusive access to this object.
+   */
+  void CommitStagedTiles();
+
   /**
    * Determines if there are still tiles scheduled to be loaded.  Call
    * this after UpdateTiles() to determine if UpdateTiles() should be
@@ -291,8 +485,6 @@ public:
   long SkipMarkerSegment(long file_offset) const;
   void MarkerSegment(long file_offset, unsigned id);
 
-  bool TileRequest(unsigned index);
-
   short *GetOverview() {
     return overview.GetData();
   }
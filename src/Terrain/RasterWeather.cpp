@@ -188,7 +188,7 @@ RasterWeather::LoadItem(const TCHAR* name, unsigned time_index,
 {
   TCHAR rasp_filename[MAX_PATH];
   GetFilename(rasp_filename, name, time_index);
-  RasterMap *map = new RasterMap(rasp_filename, NULL, NULL, operation);
+  RasterMap *map = new RasterMap(rasp_filename, NULL, NULL, NULL, operation);
   if (!map->IsDefined()) {
     delete map;
     return false;
@@ -0,0 +1,257 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterTileCache.hpp"
+#include "OS/FileMapping.hpp"
+#include "Util/AllocatedArray.hpp"
+
+#include <string.h>
+
+/**
+ * The tile data is aligned to this size, so each tile occupies whole
+ * pages in the page cache.
+ */
+static constexpr unsigned RAW_TILE_ALIGNMENT = 4096;
+
+static bool
+WritePadding(FILE *file, unsigned alignment)
+{
+  long position = ftell(file);
+  if (position < 0)
+    return false;
+
+  static constexpr char zero[RAW_TILE_ALIGNMENT] = {};
+  const unsigned n = (alignment - position % alignment) % alignment;
+  return fwrite(zero, 1, n, file) == n;
+}
+
+static bool
+WriteBuffer(FILE *file, const RasterBuffer &buffer)
+{
+  const size_t n = buffer.GetWidth() * buffer.GetHeight();
+  return fwrite(buffer.GetData(), sizeof(short), n, file) == n;
+}
+
+bool
+RasterTileCache::SaveRaw(FILE *file, const char *path)
+{
+  if (!initialised || IsMapped())
+    return false;
+
+  assert(bounds_initialised);
+  assert(!loading_staged);
+
+  const unsigned n_tiles = tiles.GetSize();
+
+  RawHeader header;
+
+  /* zero-fill all implicit padding bytes */
+  memset(&header, 0, sizeof(header));
+
+  header.magic = RawHeader::MAGIC;
+  header.version = RawHeader::VERSION;
+  header.byte_order = RawHeader::BYTE_ORDER_TAG;
+  header.width = width;
+  header.height = height;
+  header.tile_width = tile_width;
+  header.tile_height = tile_height;
+  header.tile_columns = tiles.GetWidth();
+  header.tile_rows = tiles.GetHeight();
+  header.overview_offset = sizeof(header) + n_tiles * sizeof(RawTileHeader);
+  header.lon_min = (double)bounds.GetWest().Degrees();
+  header.lon_max = (double)bounds.GetEast().Degrees();
+  header.lat_min = (double)bounds.GetSouth().Degrees();
+  header.lat_max = (double)bounds.GetNorth().Degrees();
+
+  AllocatedArray<RawTileHeader> directory(n_tiles);
+  memset(directory.begin(), 0, n_tiles * sizeof(RawTileHeader));
+
+  for (unsigned i = 0; i < n_tiles; ++i) {
+    RasterTile &tile = tiles.GetLinear(i);
+    tile.ClearRequest();
+
+    RawTileHeader &entry = directory[i];
+    entry.xstart = tile.xstart;
+    entry.ystart = tile.ystart;
+    entry.xend = tile.xend;
+    entry.yend = tile.yend;
+  }
+
+  /* write the header, a preliminary directory (without offsets) and
+     the overview */
+
+  const size_t overview_size = overview.GetWidth() * overview.GetHeight();
+  if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+      fwrite(directory.begin(), sizeof(RawTileHeader), n_tiles,
+             file) != n_tiles ||
+      fwrite(overview.GetData(), sizeof(short), overview_size,
+             file) != overview_size)
+    return false;
+
+  /* decode all tiles in batches, using the staging buffers of the
+     asynchronous loader */
+
+  bool success = true;
+  for (unsigned i = 0; success && i < n_tiles;) {
+    staged_tiles.clear();
+    for (; i < n_tiles && !staged_tiles.full(); ++i) {
+      RasterTile &tile = tiles.GetLinear(i);
+      if (tile.IsDefined()) {
+        tile.SetRequest();
+        staged_tiles.append().index = i;
+      }
+    }
+
+    if (staged_tiles.empty())
+      break;
+
+    LoadStagedTiles(path);
+
+    for (auto it = staged_tiles.begin(), end = staged_tiles.end();
+         it != end; ++it) {
+      tiles.GetLinear(it->index).ClearRequest();
+
+      if (success && it->buffer.IsDefined()) {
+        const size_t total =
+          RasterTile::GetPyramidSize(it->buffer.GetWidth(),
+                                     it->buffer.GetHeight());
+
+        long position;
+        success = WritePadding(file, RAW_TILE_ALIGNMENT) &&
+          (position = ftell(file)) > 0 &&
+          /* the offsets are 32 bit */
+          (unsigned long)position + total * sizeof(short) < 0x80000000ul &&
+          WriteBuffer(file, it->buffer);
+
+        for (unsigned l = 0; success && l < RasterTile::REDUCED_LEVELS; ++l)
+          success = WriteBuffer(file, it->reduced[l]);
+
+        if (success)
+          directory[it->index].offset = position;
+      }
+
+      it->buffer.Reset();
+      for (unsigned l = 0; l < RasterTile::REDUCED_LEVELS; ++l)
+        it->reduced[l].Reset();
+    }
+  }
+
+  staged_tiles.clear();
+
+  /* now write the final directory */
+  return success &&
+    fseek(file, sizeof(header), SEEK_SET) == 0 &&
+    fwrite(directory.begin(), sizeof(RawTileHeader), n_tiles,
+           file) == n_tiles;
+}
+
+bool
+RasterTileCache::LoadRaw(const TCHAR *path)
+{
+  Reset();
+
+  mapping = new FileMapping(path);
+  if (mapping->error()) {
+    Reset();
+    return false;
+  }
+
+  const size_t size = mapping->size();
+  if (size < sizeof(RawHeader)) {
+    Reset();
+    return false;
+  }
+
+  const RawHeader &header = *(const RawHeader *)mapping->data();
+  if (header.magic != RawHeader::MAGIC ||
+      header.version != RawHeader::VERSION ||
+      header.byte_order != RawHeader::BYTE_ORDER_TAG ||
+      header.tile_columns == 0 || header.tile_columns > MAX_RTC_TILES ||
+      header.tile_rows == 0 || header.tile_rows > MAX_RTC_TILES) {
+    Reset();
+    return false;
+  }
+
+  const unsigned n_tiles = header.tile_columns * header.tile_rows;
+
+  if (header.width < 1024 || header.width > 1024 * 1024 ||
+      header.height < 1024 || header.height > 1024 * 1024 ||
+      header.tile_width == 0 || header.tile_height == 0 ||
+      n_tiles > MAX_RTC_TILES ||
+      header.overview_offset < sizeof(header) + n_tiles * sizeof(RawTileHeader) ||
+      header.overview_offset % sizeof(short) != 0) {
+    Reset();
+    return false;
+  }
+
+  SetSize(header.width, header.height,
+          header.tile_width, header.tile_height,
+          header.tile_columns, header.tile_rows);
+  SetLatLonBounds(header.lon_min, header.lon_max,
+                  header.lat_min, header.lat_max);
+
+  const size_t overview_size =
+    overview.GetWidth() * overview.GetHeight() * sizeof(short);
+  if (header.overview_offset > size ||
+      overview_size > size - header.overview_offset || bounds.IsEmpty()) {
+    Reset();
+    return false;
+  }
+
+  overview.SetMapped((const short *)mapping->at(header.overview_offset),
+                     overview.GetWidth(), overview.GetHeight());
+
+  const RawTileHeader *directory =
+    (const RawTileHeader *)mapping->at(sizeof(header));
+  for (unsigned i = 0; i < n_tiles; ++i) {
+    const RawTileHeader &entry = directory[i];
+    if (entry.xstart > entry.xend || entry.xend > width ||
+        entry.ystart > entry.yend || entry.yend > height) {
+      Reset();
+      return false;
+    }
+
+    RasterTile &tile = tiles.GetLinear(i);
+    tile.Set(entry.xstart, entry.ystart, entry.xend, entry.yend);
+    tile.ClearRequest();
+
+    if (entry.offset == 0 || !tile.IsDefined())
+      continue;
+
+    const size_t tile_size =
+      RasterTile::GetPyramidSize(tile.width, tile.height) * sizeof(short);
+    if (entry.offset % sizeof(short) != 0 ||
+        entry.offset > size || tile_size > size - entry.offset) {
+      Reset();
+      return false;
+    }
+
+    tile.SetMapped((const short *)mapping->at(entry.offset));
+  }
+
+  BuildOverviewLevels();
+
+  initialised = true;
+  scan_overview = false;
+  return true;
+}
@@ -24,6 +24,8 @@ Copyright_License {
 #include "Terrain/RasterTileCache.hpp"
 #include "Terrain/RasterLocation.hpp"
 
+#include <algorithm>
+
 #include <stdlib.h>
 
 struct GridLocation : public RasterLocation {
@@ -262,7 +264,7 @@ NextGridIntersection(const GridRay &ray,
 inline void
 RasterTileCache::ScanTileLine(GridLocation start, GridLocation end,
                               short *buffer, unsigned size,
-                              bool interpolate) const
+                              bool interpolate, unsigned level) const
 {
   assert(end.index >= start.index);
   assert(end.index <= size);
@@ -296,11 +298,13 @@ RasterTileCache::ScanTileLine(GridLocation start, GridLocation end,
     --start.tile_y;
   }
 
+  assert(level < OVERVIEW_BITS);
+
   const RasterTile &tile = tiles.Get(start.tile_x, start.tile_y);
   if (tile.IsEnabled())
     tile.ScanLine(start.x, start.y, end.x, end.y,
                   buffer + start.index, end.index - start.index,
-                  interpolate);
+                  interpolate, level);
   else
     /* need range checking in the overview buffer because its size may
        be rounded down, and then the "fine" location may exceed its
@@ -323,6 +327,25 @@ RasterTileCache::ScanLine(const RasterLocation _start,
   assert(_end.y < GetFineHeight());
   assert(size >= 2);
 
+  /* choose the resolution level: the distance between two samples
+     should be less than two pixels */
+  const unsigned dx = abs((int)_end.x - (int)_start.x);
+  const unsigned dy = abs((int)_end.y - (int)_start.y);
+  const unsigned step = std::max(dx, dy) / (size - 1);
+  unsigned level = 0;
+  while (level < MAX_LEVEL && (step >> level) >= (2u << SUBPIXEL_BITS))
+    ++level;
+
+  if (level >= OVERVIEW_BITS) {
+    /* the overview is good enough, don't bother with the tiles */
+    GetOverviewLevel(level).ScanLineChecked(_start.x >> level,
+                                            _start.y >> level,
+                                            _end.x >> level,
+                                            _end.y >> level,
+                                            buffer, size, interpolate);
+    return;
+  }
+
   const GridRay ray(GetFineTileWidth(), GetFineTileHeight(),
                     _start, _end, size);
   assert(ray.size == size);
@@ -332,7 +355,7 @@ RasterTileCache::ScanLine(const RasterLocation _start,
   GridLocation current = ray.start;
   while (current.index < size) {
     GridLocation next = NextGridIntersection(ray, current);
-    ScanTileLine(current, next, buffer, size, interpolate);
+    ScanTileLine(current, next, buffer, size, interpolate, level);
     current = next;
   }
 }
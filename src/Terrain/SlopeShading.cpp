@@ -0,0 +1,295 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "SlopeShading.hpp"
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+#include <emmintrin.h>
+#endif
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+void
+SlopeShadingRowPortable(const short *gcc_restrict src,
+                        const short *gcc_restrict above,
+                        const short *gcc_restrict below,
+                        unsigned n, unsigned column_distance,
+                        unsigned row_sum,
+                        unsigned dd2, const SlopeShadingParameters &params,
+                        signed char *gcc_restrict dest)
+{
+  const int p20 = 2 * column_distance;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const int p32 = ClipHeightDelta(above[i] - below[i]);
+    const int p22 = ClipHeightDelta(src[i + column_distance] -
+                                    src[int(i) - int(column_distance)]);
+
+    const int dd0 = p22 * int(row_sum);
+    const int dd1 = p20 * p32;
+    dest[i] = SlopeShadingIndex(dd0, dd1, dd2, params);
+  }
+}
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+
+/**
+ * Converts the lower two 32 bit integers to double.
+ */
+gcc_always_inline
+static inline __m128d
+ConvertLow(__m128i v)
+{
+  return _mm_cvtepi32_pd(v);
+}
+
+/**
+ * Converts the upper two 32 bit integers to double.
+ */
+gcc_always_inline
+static inline __m128d
+ConvertHigh(__m128i v)
+{
+  return _mm_cvtepi32_pd(_mm_srli_si128(v, 8));
+}
+
+/**
+ * Truncates two pairs of doubles to four 32 bit integers.
+ */
+gcc_always_inline
+static inline __m128i
+Truncate(__m128d low, __m128d high)
+{
+  return _mm_unpacklo_epi64(_mm_cvttpd_epi32(low), _mm_cvttpd_epi32(high));
+}
+
+/**
+ * The SSE2 implementation of SlopeShadingIndex() for four pixels.
+ * It uses double precision floating point instead of integer
+ * division, which gives the same results because all operands are
+ * small enough to be represented exactly.
+ */
+gcc_always_inline
+static inline __m128i
+SlopeShadingIndexSSE2(__m128i num, __m128i square_mag_01,
+                      __m128d dd2_squared, __m128i sz, __m128d contrast)
+{
+  const __m128i one = _mm_set1_epi32(1);
+
+  __m128i mag =
+    Truncate(_mm_sqrt_pd(_mm_add_pd(ConvertLow(square_mag_01), dd2_squared)),
+             _mm_sqrt_pd(_mm_add_pd(ConvertHigh(square_mag_01), dd2_squared)));
+  mag = _mm_or_si128(mag, one);
+
+  const __m128i sval =
+    Truncate(_mm_div_pd(ConvertLow(num), ConvertLow(mag)),
+             _mm_div_pd(ConvertHigh(num), ConvertHigh(mag)));
+
+  /* "contrast" is pre-divided by 128; the product is exact, and
+     truncation rounds towards zero just like integer division */
+  const __m128i delta = _mm_sub_epi32(sval, sz);
+  return Truncate(_mm_mul_pd(ConvertLow(delta), contrast),
+                  _mm_mul_pd(ConvertHigh(delta), contrast));
+}
+
+static void
+SlopeShadingRowSSE2(const short *gcc_restrict src,
+                    const short *gcc_restrict above,
+                    const short *gcc_restrict below,
+                    unsigned n, unsigned column_distance, unsigned row_sum,
+                    unsigned dd2, const SlopeShadingParameters &params,
+                    signed char *gcc_restrict dest)
+{
+  const __m128i min_delta = _mm_set1_epi16(-512);
+  const __m128i max_delta = _mm_set1_epi16(512);
+  const __m128i min_index = _mm_set1_epi16(-63);
+  const __m128i max_index = _mm_set1_epi16(63);
+
+  const __m128i row_sum_v = _mm_set1_epi16(row_sum);
+  const __m128i p20 = _mm_set1_epi16(2 * column_distance);
+
+  /* pairs of (sx, sy) for _mm_madd_epi16() */
+  const __m128i sxy = _mm_set1_epi32(((unsigned)params.sy << 16) |
+                                     ((unsigned)params.sx & 0xffff));
+
+  const __m128i dd2_sz = _mm_set1_epi32(int(dd2) * params.sz);
+  const __m128i sz = _mm_set1_epi32(params.sz);
+  const __m128d dd2_squared = _mm_set1_pd(double(dd2) * double(dd2));
+  const __m128d contrast = _mm_set1_pd(params.contrast / 128.);
+
+  const short *left = src - column_distance;
+  const short *right = src + column_distance;
+
+  for (unsigned i = 0; i < n / 8; ++i, left += 8, right += 8,
+         above += 8, below += 8, dest += 8) {
+    const __m128i h_left = _mm_loadu_si128((const __m128i *)left);
+    const __m128i h_right = _mm_loadu_si128((const __m128i *)right);
+    const __m128i h_above = _mm_loadu_si128((const __m128i *)above);
+    const __m128i h_below = _mm_loadu_si128((const __m128i *)below);
+
+    /* saturation followed by clipping is the same as
+       ClipHeightDelta() */
+    const __m128i p32 =
+      _mm_min_epi16(_mm_max_epi16(_mm_subs_epi16(h_above, h_below),
+                                  min_delta), max_delta);
+    const __m128i p22 =
+      _mm_min_epi16(_mm_max_epi16(_mm_subs_epi16(h_right, h_left),
+                                  min_delta), max_delta);
+
+    /* these fit in 16 bit: 512 * 50 */
+    const __m128i dd0 = _mm_mullo_epi16(p22, row_sum_v);
+    const __m128i dd1 = _mm_mullo_epi16(p20, p32);
+
+    const __m128i dd01_low = _mm_unpacklo_epi16(dd0, dd1);
+    const __m128i dd01_high = _mm_unpackhi_epi16(dd0, dd1);
+
+    const __m128i num_low =
+      _mm_add_epi32(_mm_madd_epi16(dd01_low, sxy), dd2_sz);
+    const __m128i num_high =
+      _mm_add_epi32(_mm_madd_epi16(dd01_high, sxy), dd2_sz);
+
+    const __m128i square_mag_low = _mm_madd_epi16(dd01_low, dd01_low);
+    const __m128i square_mag_high = _mm_madd_epi16(dd01_high, dd01_high);
+
+    const __m128i index_low =
+      SlopeShadingIndexSSE2(num_low, square_mag_low, dd2_squared,
+                            sz, contrast);
+    const __m128i index_high =
+      SlopeShadingIndexSSE2(num_high, square_mag_high, dd2_squared,
+                            sz, contrast);
+
+    __m128i index = _mm_packs_epi32(index_low, index_high);
+    index = _mm_min_epi16(_mm_max_epi16(index, min_index), max_index);
+    _mm_storel_epi64((__m128i *)dest, _mm_packs_epi16(index, index));
+  }
+
+  const unsigned done = n & ~7u;
+  SlopeShadingRowPortable(src + done, above, below, n - done,
+                          column_distance, row_sum, dd2, params, dest);
+}
+
+#endif
+
+#ifdef __ARM_NEON__
+
+/**
+ * The NEON implementation of SlopeShadingRow().  ARMv7 NEON has no
+ * division and no (exact) square root, therefore only the integer
+ * part is vectorised, and the result is finished with the scalar
+ * SlopeShadingIndex().
+ */
+static void
+SlopeShadingRowNEON(const short *gcc_restrict src,
+                    const short *gcc_restrict above,
+                    const short *gcc_restrict below,
+                    unsigned n, unsigned column_distance, unsigned row_sum,
+                    unsigned dd2, const SlopeShadingParameters &params,
+                    signed char *gcc_restrict dest)
+{
+  const int16x8_t min_delta = vdupq_n_s16(-512);
+  const int16x8_t max_delta = vdupq_n_s16(512);
+
+  const int16_t p20 = 2 * column_distance;
+  const int32x4_t dd2_sz = vdupq_n_s32(int(dd2) * params.sz);
+  const uint32x4_t dd2_squared = vdupq_n_u32(dd2 * dd2);
+
+  const short *left = src - column_distance;
+  const short *right = src + column_distance;
+
+  int32_t num[8];
+  uint32_t square_mag[8];
+
+  for (unsigned i = 0; i < n / 8; ++i, left += 8, right += 8,
+         above += 8, below += 8) {
+    const int16x8_t h_left = vld1q_s16(left);
+    const int16x8_t h_right = vld1q_s16(right);
+    const int16x8_t h_above = vld1q_s16(above);
+    const int16x8_t h_below = vld1q_s16(below);
+
+    /* saturation followed by clipping is the same as
+       ClipHeightDelta() */
+    const int16x8_t p32 =
+      vminq_s16(vmaxq_s16(vqsubq_s16(h_above, h_below), min_delta),
+                max_delta);
+    const int16x8_t p22 =
+      vminq_s16(vmaxq_s16(vqsubq_s16(h_right, h_left), min_delta),
+                max_delta);
+
+    /* these fit in 16 bit: 512 * 50 */
+    const int16x8_t dd0 = vmulq_n_s16(p22, row_sum);
+    const int16x8_t dd1 = vmulq_n_s16(p32, p20);
+
+    const int16x4_t dd0_low = vget_low_s16(dd0), dd0_high = vget_high_s16(dd0);
+    const int16x4_t dd1_low = vget_low_s16(dd1), dd1_high = vget_high_s16(dd1);
+
+    int32x4_t num_low = vmlal_n_s16(vmull_n_s16(dd0_low, params.sx),
+                                    dd1_low, params.sy);
+    int32x4_t num_high = vmlal_n_s16(vmull_n_s16(dd0_high, params.sx),
+                                     dd1_high, params.sy);
+    vst1q_s32(num, vaddq_s32(num_low, dd2_sz));
+    vst1q_s32(num + 4, vaddq_s32(num_high, dd2_sz));
+
+    const int32x4_t square_mag_low =
+      vmlal_s16(vmull_s16(dd0_low, dd0_low), dd1_low, dd1_low);
+    const int32x4_t square_mag_high =
+      vmlal_s16(vmull_s16(dd0_high, dd0_high), dd1_high, dd1_high);
+    vst1q_u32(square_mag,
+              vaddq_u32(vreinterpretq_u32_s32(square_mag_low), dd2_squared));
+    vst1q_u32(square_mag + 4,
+              vaddq_u32(vreinterpretq_u32_s32(square_mag_high), dd2_squared));
+
+    for (unsigned j = 0; j < 8; ++j)
+      *dest++ = SlopeShadingIndex(num[j], square_mag[j], params);
+  }
+
+  const unsigned done = n & ~7u;
+  SlopeShadingRowPortable(src + done, above, below, n - done,
+                          column_distance, row_sum, dd2, params, dest);
+}
+
+#endif
+
+void
+SlopeShadingRow(const short *gcc_restrict src,
+                const short *gcc_restrict above,
+                const short *gcc_restrict below,
+                unsigned n, unsigned column_distance, unsigned row_sum,
+                unsigned dd2, const SlopeShadingParameters &params,
+                signed char *gcc_restrict dest)
+{
+  assert(column_distance > 0 && column_distance <= 25);
+  assert(row_sum > 0 && row_sum <= 50);
+
+#if defined(__SSE2__) && !defined(FIXED_MATH)
+  SlopeShadingRowSSE2(src, above, below, n, column_distance, row_sum,
+                      dd2, params, dest);
+#elif defined(__ARM_NEON__)
+  SlopeShadingRowNEON(src, above, below, n, column_distance, row_sum,
+                      dd2, params, dest);
+#else
+  SlopeShadingRowPortable(src, above, below, n, column_distance, row_sum,
+                          dd2, params, dest);
+#endif
+}
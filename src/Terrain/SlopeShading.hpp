@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+#define XCSOAR_TERRAIN_SLOPE_SHADING_HPP
+
+#include "Math/fixed.hpp"
+#include "Math/FastMath.h"
+#include "Util/Clamp.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+
+/**
+ * Parameters for the slope shading calculation which are constant
+ * for the whole image.
+ */
+struct SlopeShadingParameters {
+  /** the light source vector */
+  int sx, sy, sz;
+
+  int contrast;
+};
+
+/**
+ * Clip the difference between two adjacent terrain height values to
+ * sane bounds.  This works around integer overflows in the
+ * SlopeShadingIndex() formula when the map file is broken, avoiding
+ * the sqrt() call with a negative argument.
+ */
+gcc_const
+static inline int
+ClipHeightDelta(int d)
+{
+  return Clamp(d, -512, 512);
+}
+
+/**
+ * Calculate the illumination index (-63..63) from the dot product of
+ * the surface normal with the light source vector and the squared
+ * magnitude of the surface normal.
+ */
+gcc_pure
+static inline int
+SlopeShadingIndex(int num, unsigned square_mag,
+                  const SlopeShadingParameters &params)
+{
+#ifdef FIXED_MATH
+  const unsigned mag = isqrt4(square_mag);
+#else
+  const unsigned mag = (unsigned)sqrt((fixed)square_mag);
+#endif
+  /* this is a workaround for a SIGFPE (division by zero)
+     observed by our users on some Android devices (e.g. Nexus
+     7), even though we did our best to make sure that the
+     integer arithmetics above can't overflow */
+  /* TODO: debug this problem and replace this workaround */
+  const int sval = num / int(mag|1);
+  const int sindex = (sval - params.sz) * params.contrast / 128;
+  return Clamp(sindex, -63, 63);
+}
+
+/**
+ * Calculate the illumination index (-63..63) for the given surface
+ * normal vector.
+ */
+gcc_pure
+static inline int
+SlopeShadingIndex(int dd0, int dd1, unsigned dd2,
+                  const SlopeShadingParameters &params)
+{
+  const int num = (int(dd2) * params.sz + dd0 * params.sx + dd1 * params.sy);
+  const unsigned square_mag = dd0 * dd0 + dd1 * dd1 + dd2 * dd2;
+  return SlopeShadingIndex(num, square_mag, params);
+}
+
+/**
+ * Calculate the illumination index of a row of pixels whose left,
+ * right, upper and lower neighbours are all available.  The result
+ * is undefined for pixels with "special" heights (water, invalid) or
+ * "special" neighbours; the caller must check those.
+ *
+ * This is the hot loop of RasterRenderer; it is implemented with
+ * SSE2 or NEON if available.
+ *
+ * @param src the first pixel
+ * @param above the pixel #row_distance rows above #src
+ * @param below the pixel #row_distance rows below #src
+ * @param column_distance the distance of the left and right
+ * neighbours (1..25)
+ * @param row_sum the sum of the distances of the upper and lower
+ * neighbours (1..50)
+ * @param dd2 the vertical component of the surface normal, which is
+ * constant for the whole row
+ */
+void
+SlopeShadingRow(const short *gcc_restrict src,
+                const short *gcc_restrict above,
+                const short *gcc_restrict below,
+                unsigned n, unsigned column_distance, unsigned row_sum,
+                unsigned dd2, const SlopeShadingParameters &params,
+                signed char *gcc_restrict dest);
+
+/**
+ * The portable implementation of SlopeShadingRow().  Only exposed for
+ * unit tests and benchmarks.
+ */
+void
+SlopeShadingRowPortable(const short *gcc_restrict src,
+                        const short *gcc_restrict above,
+                        const short *gcc_restrict below,
+                        unsigned n, unsigned column_distance,
+                        unsigned row_sum,
+                        unsigned dd2, const SlopeShadingParameters &params,
+                        signed char *gcc_restrict dest);
+
+#endif
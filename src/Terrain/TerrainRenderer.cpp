@@ -346,6 +346,10 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
     return;
 
   compare_projection = CompareProjection(map_projection);
+
+  if (terrain_serial != terrain->GetSerial())
+    /* new terrain data: the previous image cannot be scrolled */
+    raster_renderer.Invalidate();
 #endif
 
   terrain_serial = terrain->GetSerial();
@@ -64,9 +64,8 @@ public:
    * Flush the cache.
    */
   void Flush() {
-#ifdef ENABLE_OPENGL
     raster_renderer.Invalidate();
-#else
+#ifndef ENABLE_OPENGL
     compare_projection.Clear();
 #endif
   }
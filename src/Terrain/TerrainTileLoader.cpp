@@ -0,0 +1,104 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TerrainTileLoader.hpp"
+#include "RasterTerrain.hpp"
+
+TerrainTileLoader::TerrainTileLoader()
+  :StandbyThread("TerrainLoader"),
+   terrain(nullptr),
+   center(GeoPoint::Invalid()), radius(fixed(0)),
+   new_request(false) {}
+
+void
+TerrainTileLoader::SetTerrain(RasterTerrain *_terrain)
+{
+  ScopeLock protect(mutex);
+
+  /* the old terrain object may be deleted as soon as this method
+     returns; cancel the loop in Tick() and wait for the thread to
+     release it */
+  terrain = nullptr;
+  WaitDone();
+
+  terrain = _terrain;
+  center = GeoPoint::Invalid();
+}
+
+void
+TerrainTileLoader::Request(const GeoPoint &location, fixed _radius)
+{
+  assert(location.IsValid());
+
+  ScopeLock protect(mutex);
+  if (terrain == nullptr)
+    return;
+
+  center = location;
+  radius = _radius;
+
+  if (StandbyThread::IsBusy())
+    /* the running Tick() will pick up the new view */
+    new_request = true;
+  else
+    Trigger();
+}
+
+void
+TerrainTileLoader::Tick()
+{
+  /* loop until all tiles around the most recently requested view have
+     been loaded; PrepareTiles() activates only a limited number of
+     tiles at a time */
+  while (!IsStopped() && terrain != nullptr && center.IsValid()) {
+    RasterTerrain &_terrain = *terrain;
+    const GeoPoint location = center;
+    const fixed _radius = radius;
+    new_request = false;
+
+    mutex.Unlock();
+
+    bool dirty;
+
+    {
+      RasterTerrain::ExclusiveLease lease(_terrain);
+      dirty = lease->PrepareTiles(location, _radius);
+    }
+
+    if (dirty) {
+      /* this is the expensive part; the map is being read by other
+         threads meanwhile, and this thread is the only one which
+         modifies it */
+      _terrain.map.LoadTiles();
+
+      RasterTerrain::ExclusiveLease lease(_terrain);
+      lease->CommitTiles();
+      dirty = lease->IsDirty();
+    }
+
+    mutex.Lock();
+
+    if (!dirty && !new_request)
+      break;
+  }
+}
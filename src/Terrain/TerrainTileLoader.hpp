@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_TILE_LOADER_HPP
+#define XCSOAR_TERRAIN_TILE_LOADER_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/fixed.hpp"
+
+class RasterTerrain;
+
+/**
+ * Loads terrain tiles in a background thread.  The JPEG2000 decoder
+ * runs without holding the #RasterTerrain lock; the lock is only
+ * acquired exclusively for selecting the tiles and for publishing
+ * the decoded tiles.  Until a tile arrives, readers fall back to the
+ * overview.
+ */
+class TerrainTileLoader final : private StandbyThread {
+  RasterTerrain *terrain;
+
+  /**
+   * The most recently requested view.  Protected by
+   * StandbyThread::mutex.
+   */
+  GeoPoint center;
+  fixed radius;
+
+  /**
+   * Was a new view requested while the thread was busy?  Protected
+   * by StandbyThread::mutex.
+   */
+  bool new_request;
+
+public:
+  TerrainTileLoader();
+
+  /**
+   * Change the terrain object.  Waits for the current job to finish,
+   * so the old object may be deleted after this method returns.
+   */
+  void SetTerrain(RasterTerrain *_terrain);
+
+  /**
+   * Schedule loading the tiles around the specified location.  This
+   * method returns immediately.
+   */
+  void Request(const GeoPoint &location, fixed radius);
+
+  /**
+   * Is the thread still loading tiles?
+   */
+  bool IsBusy() {
+    ScopeLock protect(mutex);
+    return StandbyThread::IsBusy();
+  }
+
+  /**
+   * Stop the thread and wait for it to exit.
+   */
+  void Stop() {
+    LockStop();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() override;
+};
+
+#endif
@@ -25,7 +25,8 @@ Copyright_License {
 
 StandbyThread::StandbyThread(const char *_name)
   :Thread(_name),
-   alive(false), pending(false), busy(false), stop(false) {}
+   alive(false), pending(false), busy(false), stop(false),
+   delay_ms(0) {}
 
 StandbyThread::~StandbyThread()
 {
@@ -49,6 +50,23 @@ StandbyThread::Trigger()
     alive = Start();
 }
 
+void
+StandbyThread::TriggerDelayed(unsigned _delay_ms)
+{
+  assert(!IsInside());
+  assert(mutex.IsLockedByCurrent());
+  assert(_delay_ms > 0);
+
+  stop = false;
+  delay_ms = _delay_ms;
+
+  if (alive)
+    /* wake up the thread, to let it start the timed wait */
+    TriggerCommand();
+  else
+    alive = Start();
+}
+
 void
 StandbyThread::StopAsync()
 {
@@ -59,6 +77,7 @@ StandbyThread::StopAsync()
 
   /* clear the queued work */
   pending = false;
+  delay_ms = 0;
 
   TriggerCommand();
 }
@@ -110,7 +129,20 @@ StandbyThread::Run()
   while (!stop) {
     assert(!busy);
 
-    if (!pending) {
+    if (!pending && delay_ms > 0) {
+      /* wait for a command or for the delay to expire */
+#ifdef HAVE_POSIX
+      const bool triggered = cond.Wait(mutex, delay_ms);
+#else
+      command_trigger.Reset();
+      mutex.Unlock();
+      const bool triggered = command_trigger.Wait(delay_ms);
+      mutex.Lock();
+#endif
+
+      if (!triggered && !stop && delay_ms > 0)
+        pending = true;
+    } else if (!pending) {
       /* wait for a command */
 #ifdef HAVE_POSIX
       cond.Wait(mutex);
@@ -127,6 +159,7 @@ StandbyThread::Run()
     if (pending) {
       /* there's work to do */
       pending = false;
+      delay_ms = 0;
       busy = true;
       Tick();
       busy = false;
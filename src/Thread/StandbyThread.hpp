@@ -85,6 +85,13 @@ private:
    */
   bool stop;
 
+  /**
+   * If non-zero, then Tick() will be called after this number of
+   * milliseconds, even if Trigger() does not get called.  This gets
+   * cleared as soon as Tick() is invoked.
+   */
+  unsigned delay_ms;
+
 public:
   StandbyThread(const char *_name);
 
@@ -134,6 +141,17 @@ protected:
     Trigger();
   }
 
+  /**
+   * Schedule a Tick() call after the specified duration, unless
+   * Trigger() is called before.  If the thread is not already
+   * running, it is launched.  A pending delay is replaced.
+   *
+   * Caller must lock the mutex.
+   *
+   * @param _delay_ms the delay in milliseconds; must be positive
+   */
+  void TriggerDelayed(unsigned _delay_ms);
+
   /**
    * Is the thread currently working (i.e. inside Tick())?
    *
@@ -0,0 +1,457 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Topography/TopographyCache.hpp"
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/XShape.hpp"
+#include "Convert.hpp"
+#include "OS/FileMapping.hpp"
+#include "Util/ConvertString.hpp"
+#include "Util/StringUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#include <string.h>
+
+/**
+ * The maximum number of children of a #TopographyCache::Node.
+ */
+static constexpr unsigned NODE_SIZE = 16;
+
+static_assert(sizeof(ShapePoint) == 2 * sizeof(float),
+              "Unexpected ShapePoint size");
+
+TopographyCache::~TopographyCache()
+{
+  delete mapping;
+}
+
+void
+TopographyCache::Reset()
+{
+  delete mapping;
+  mapping = nullptr;
+}
+
+/**
+ * Check whether the array is inside the mapping and properly
+ * aligned.
+ */
+static bool
+CheckArray(size_t file_size, uint32_t offset, size_t n, size_t size,
+           size_t alignment)
+{
+  return offset % alignment == 0 && offset <= file_size &&
+    n <= (file_size - offset) / size;
+}
+
+gcc_pure
+static bool
+CheckFile(const void *base, size_t size,
+          const TopographyCache::FileHeader &header)
+{
+  typedef TopographyCache::Shape Shape;
+  typedef TopographyCache::Node Node;
+
+  if (memchr(header.name, 0, sizeof(header.name)) == nullptr ||
+      !CheckArray(size, header.shapes_offset, header.n_shapes,
+                  sizeof(Shape), 8) ||
+      !CheckArray(size, header.entries_offset, header.n_shapes,
+                  sizeof(uint32_t), 4) ||
+      !CheckArray(size, header.nodes_offset, header.n_nodes,
+                  sizeof(Node), 8) ||
+      !CheckArray(size, header.lines_offset, header.n_lines,
+                  sizeof(uint16_t), 2) ||
+      !CheckArray(size, header.points_offset, header.n_points,
+                  sizeof(ShapePoint), 4) ||
+      !CheckArray(size, header.labels_offset, header.labels_size, 1, 1) ||
+      (header.labels_size > 0 &&
+       ((const char *)base)[header.labels_offset +
+                            header.labels_size - 1] != 0))
+    return false;
+
+  const Shape *shapes = (const Shape *)((const char *)base +
+                                        header.shapes_offset);
+  const uint16_t *lines = (const uint16_t *)((const char *)base +
+                                             header.lines_offset);
+  for (unsigned i = 0; i < header.n_shapes; ++i) {
+    const Shape &shape = shapes[i];
+    if (shape.first_line > header.n_lines ||
+        shape.n_lines > header.n_lines - shape.first_line ||
+        (shape.label != Shape::NO_LABEL &&
+         shape.label >= header.labels_size))
+      return false;
+
+    /* 64 bit, so a corrupt file with many long lines cannot
+       overflow the sum and pass the following check */
+    uint64_t n_points = 0;
+    for (unsigned j = 0; j < shape.n_lines; ++j)
+      n_points += lines[shape.first_line + j];
+
+    if (shape.first_point > header.n_points ||
+        n_points > header.n_points - shape.first_point)
+      return false;
+  }
+
+  const uint32_t *entries = (const uint32_t *)((const char *)base +
+                                               header.entries_offset);
+  for (unsigned i = 0; i < header.n_shapes; ++i)
+    if (entries[i] >= header.n_shapes)
+      return false;
+
+  const Node *nodes = (const Node *)((const char *)base +
+                                     header.nodes_offset);
+  for (unsigned i = 0; i < header.n_nodes; ++i) {
+    const Node &node = nodes[i];
+    const unsigned n = node.leaf ? header.n_shapes : i;
+    if (node.first > n || node.count > n - node.first)
+      return false;
+  }
+
+  return true;
+}
+
+bool
+TopographyCache::Load(const TCHAR *path)
+{
+  Reset();
+
+  mapping = new FileMapping(path);
+  if (mapping->error()) {
+    Reset();
+    return false;
+  }
+
+  const size_t size = mapping->size();
+  const Header &header = *(const Header *)mapping->data();
+  if (size < sizeof(header) ||
+      header.magic != Header::MAGIC ||
+      header.version != Header::VERSION ||
+      !CheckArray(size, sizeof(header), header.n_files,
+                  sizeof(FileHeader), 8)) {
+    Reset();
+    return false;
+  }
+
+  const FileHeader *files = (const FileHeader *)mapping->at(sizeof(header));
+  for (unsigned i = 0; i < header.n_files; ++i) {
+    if (!CheckFile(mapping->data(), size, files[i])) {
+      Reset();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+TopographyCache::File
+TopographyCache::Find(const char *name) const
+{
+  if (mapping == nullptr)
+    return File();
+
+  const Header &header = *(const Header *)mapping->data();
+  const FileHeader *files = (const FileHeader *)mapping->at(sizeof(header));
+  for (unsigned i = 0; i < header.n_files; ++i)
+    if (StringIsEqual(files[i].name, name))
+      return File(mapping->data(), files[i]);
+
+  return File();
+}
+
+void
+TopographyCache::File::Query(const Node &node, const rectObj &rect,
+                             ms_bitarray status) const
+{
+  if (node.leaf) {
+    const uint32_t *entries =
+      (const uint32_t *)(base + header->entries_offset) + node.first;
+    for (unsigned i = 0; i < node.count; ++i) {
+      const unsigned index = entries[i];
+      if (msRectOverlap(&GetShape(index).bounds, &rect) == MS_TRUE)
+        msSetBit(status, index, 1);
+    }
+  } else {
+    const Node *children =
+      (const Node *)(base + header->nodes_offset) + node.first;
+    for (unsigned i = 0; i < node.count; ++i)
+      if (msRectOverlap(&children[i].bounds, &rect) == MS_TRUE)
+        Query(children[i], rect, status);
+  }
+}
+
+void
+TopographyCache::File::Query(const rectObj &rect, ms_bitarray status) const
+{
+  if (header->n_nodes == 0)
+    return;
+
+  const Node &root =
+    ((const Node *)(base + header->nodes_offset))[header->n_nodes - 1];
+  if (msRectOverlap(&root.bounds, &rect) == MS_TRUE)
+    Query(root, rect, status);
+}
+
+static void
+Include(rectObj &dest, const rectObj &src)
+{
+  dest.minx = std::min(dest.minx, src.minx);
+  dest.miny = std::min(dest.miny, src.miny);
+  dest.maxx = std::max(dest.maxx, src.maxx);
+  dest.maxy = std::max(dest.maxy, src.maxy);
+}
+
+/**
+ * Build a packed R-tree using the "Sort-Tile-Recursive" algorithm:
+ * the shapes are sorted into vertical slices by longitude, and each
+ * slice is sorted by latitude and cut into leaves.  The upper levels
+ * combine consecutive nodes.
+ */
+static void
+BuildTree(const std::vector<TopographyCache::Shape> &shapes,
+          std::vector<uint32_t> &entries,
+          std::vector<TopographyCache::Node> &nodes)
+{
+  typedef TopographyCache::Node Node;
+
+  const unsigned n = shapes.size();
+  entries.resize(n);
+  for (unsigned i = 0; i < n; ++i)
+    entries[i] = i;
+
+  if (n == 0)
+    return;
+
+  auto center_x = [&shapes](uint32_t i) {
+    return shapes[i].bounds.minx + shapes[i].bounds.maxx;
+  };
+
+  auto center_y = [&shapes](uint32_t i) {
+    return shapes[i].bounds.miny + shapes[i].bounds.maxy;
+  };
+
+  std::sort(entries.begin(), entries.end(),
+            [&center_x](uint32_t a, uint32_t b) {
+              return center_x(a) < center_x(b);
+            });
+
+  const unsigned n_leaves = (n + NODE_SIZE - 1) / NODE_SIZE;
+  const unsigned n_slices = (unsigned)ceil(sqrt((double)n_leaves));
+  const unsigned slice_size = n_slices * NODE_SIZE;
+
+  for (unsigned i = 0; i < n; i += slice_size) {
+    const auto end = entries.begin() + std::min(i + slice_size, n);
+    std::sort(entries.begin() + i, end,
+              [&center_y](uint32_t a, uint32_t b) {
+                return center_y(a) < center_y(b);
+              });
+  }
+
+  for (unsigned i = 0; i < n; i += NODE_SIZE) {
+    Node node;
+    memset(&node, 0, sizeof(node));
+    node.first = i;
+    node.count = std::min(NODE_SIZE, n - i);
+    node.leaf = true;
+    node.bounds = shapes[entries[i]].bounds;
+    for (unsigned j = 1; j < node.count; ++j)
+      Include(node.bounds, shapes[entries[i + j]].bounds);
+
+    nodes.push_back(node);
+  }
+
+  unsigned level_start = 0, level_end = nodes.size();
+  while (level_end - level_start > 1) {
+    for (unsigned i = level_start; i < level_end; i += NODE_SIZE) {
+      Node node;
+      memset(&node, 0, sizeof(node));
+      node.first = i;
+      node.count = std::min(NODE_SIZE, level_end - i);
+      node.leaf = false;
+      node.bounds = nodes[i].bounds;
+      for (unsigned j = 1; j < node.count; ++j)
+        Include(node.bounds, nodes[i + j].bounds);
+
+      nodes.push_back(node);
+    }
+
+    level_start = level_end;
+    level_end = nodes.size();
+  }
+}
+
+static bool
+WritePadding(FILE *file, unsigned alignment)
+{
+  long position = ftell(file);
+  if (position < 0)
+    return false;
+
+  static constexpr char zero[8] = {};
+  const unsigned n = (alignment - position % alignment) % alignment;
+  return fwrite(zero, 1, n, file) == n;
+}
+
+/**
+ * Align the file position and write the array.
+ *
+ * @param offset_r the offset of the array is returned here
+ */
+template<typename T>
+static bool
+WriteArray(FILE *file, const T *data, size_t n, uint32_t &offset_r)
+{
+  if (!WritePadding(file, 8))
+    return false;
+
+  const long position = ftell(file);
+  /* the offsets are 32 bit */
+  if (position < 0 ||
+      (unsigned long)position + n * sizeof(T) >= 0x80000000ul)
+    return false;
+
+  offset_r = position;
+  return n == 0 || fwrite(data, sizeof(T), n, file) == n;
+}
+
+static bool
+WriteFile(FILE *file, const TopographyFile &src,
+          TopographyCache::FileHeader &header)
+{
+  typedef TopographyCache::Shape Shape;
+
+  const GeoPoint center = src.GetCenter();
+
+  std::vector<Shape> shapes;
+  std::vector<uint16_t> lines;
+  std::vector<ShapePoint> points;
+  std::vector<char> labels;
+
+  for (const XShape &xshape : src) {
+    Shape shape;
+    memset(&shape, 0, sizeof(shape));
+    shape.bounds = ConvertRect(xshape.get_bounds());
+    shape.type = xshape.get_type();
+    shape.n_lines = xshape.get_number_of_lines();
+    shape.first_line = lines.size();
+    shape.first_point = points.size();
+
+    unsigned n_points = 0;
+    for (unsigned i = 0; i < shape.n_lines; ++i) {
+      lines.push_back(xshape.get_lines()[i]);
+      n_points += xshape.get_lines()[i];
+    }
+
+#ifdef ENABLE_OPENGL
+    points.insert(points.end(), xshape.get_points(),
+                  xshape.get_points() + n_points);
+#else
+    for (unsigned i = 0; i < n_points; ++i) {
+      const GeoPoint relative = xshape.get_points()[i] - center;
+      points.push_back(ShapePoint(ShapeScalar(relative.longitude.Native()),
+                                  ShapeScalar(relative.latitude.Native())));
+    }
+#endif
+
+    const TCHAR *label = xshape.get_label();
+    if (label != nullptr) {
+      const WideToUTF8Converter utf8(label);
+      if (utf8.IsValid()) {
+        shape.label = labels.size();
+        labels.insert(labels.end(), (const char *)utf8,
+                      (const char *)utf8 + strlen(utf8) + 1);
+      } else
+        shape.label = Shape::NO_LABEL;
+    } else
+      shape.label = Shape::NO_LABEL;
+
+    if (shapes.empty())
+      header.bounds = shape.bounds;
+    else
+      Include(header.bounds, shape.bounds);
+
+    shapes.push_back(shape);
+  }
+
+  std::vector<uint32_t> entries;
+  std::vector<TopographyCache::Node> nodes;
+  BuildTree(shapes, entries, nodes);
+
+  header.n_shapes = shapes.size();
+  header.n_nodes = nodes.size();
+  header.n_lines = lines.size();
+  header.n_points = points.size();
+  header.labels_size = labels.size();
+  header.center_longitude = (double)center.longitude.Native();
+  header.center_latitude = (double)center.latitude.Native();
+
+  return WriteArray(file, shapes.data(), shapes.size(),
+                    header.shapes_offset) &&
+    WriteArray(file, entries.data(), entries.size(),
+               header.entries_offset) &&
+    WriteArray(file, nodes.data(), nodes.size(), header.nodes_offset) &&
+    WriteArray(file, lines.data(), lines.size(), header.lines_offset) &&
+    WriteArray(file, points.data(), points.size(), header.points_offset) &&
+    WriteArray(file, labels.data(), labels.size(), header.labels_offset);
+}
+
+bool
+TopographyCache::Save(FILE *file, const TopographyStore &store)
+{
+  Header header;
+  memset(&header, 0, sizeof(header));
+  header.magic = Header::MAGIC;
+  header.version = Header::VERSION;
+  header.n_files = store.size();
+
+  std::vector<FileHeader> directory(header.n_files);
+  memset(directory.data(), 0, directory.size() * sizeof(FileHeader));
+
+  /* write the header and a preliminary directory */
+  if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+      fwrite(directory.data(), sizeof(FileHeader), directory.size(),
+             file) != directory.size())
+    return false;
+
+  for (unsigned i = 0; i < store.size(); ++i) {
+    const TopographyFile &src = store[i];
+    FileHeader &entry = directory[i];
+
+    const char *name = src.GetName();
+    if (strlen(name) >= sizeof(entry.name))
+      return false;
+
+    strcpy(entry.name, name);
+
+    if (!WriteFile(file, src, entry))
+      return false;
+  }
+
+  /* now write the final directory */
+  return fseek(file, sizeof(header), SEEK_SET) == 0 &&
+    fwrite(directory.data(), sizeof(FileHeader), directory.size(),
+           file) == directory.size();
+}
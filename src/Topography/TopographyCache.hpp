@@ -0,0 +1,236 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_CACHE_HPP
+#define XCSOAR_TOPOGRAPHY_CACHE_HPP
+
+#include "Topography/XShapePoint.hpp"
+#include "shapelib/mapserver.h"
+#include "Geo/GeoPoint.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <tchar.h>
+#include <stdint.h>
+#include <stdio.h>
+
+class FileMapping;
+class TopographyStore;
+
+/**
+ * A file containing the preconverted shapes of all topography files
+ * of a map.  It is generated by the ConvertTopography program, and is
+ * mapped into memory, so the shapes do not need to be read and
+ * converted from the shapefiles in the ZIP archive each time they
+ * become visible.
+ *
+ * The file is native-endian.  Points are stored as #ShapePoint
+ * relative to the center of each topography file, i.e. in the format
+ * used by the OpenGL renderer.
+ */
+class TopographyCache : private NonCopyable {
+public:
+  struct Header {
+    static constexpr uint32_t MAGIC = 0x70544358;
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic, version;
+
+    /**
+     * The number of #FileHeader objects following this header.
+     */
+    uint32_t n_files;
+
+    uint32_t reserved;
+  };
+
+  struct FileHeader {
+    /**
+     * The name of the shapefile, as specified in "topology.tpl",
+     * without the ".shp" suffix.
+     */
+    char name[64];
+
+    uint32_t n_shapes, n_nodes, n_lines, n_points;
+
+    /**
+     * Offsets of the arrays within the file.
+     */
+    uint32_t shapes_offset, entries_offset, nodes_offset;
+    uint32_t lines_offset, points_offset, labels_offset;
+
+    /**
+     * The size of the label area in bytes.
+     */
+    uint32_t labels_size;
+
+    uint32_t reserved;
+
+    /**
+     * The bounds of the shapefile in degrees.
+     */
+    rectObj bounds;
+
+    /**
+     * The reference point of all #ShapePoint values (native angles).
+     */
+    double center_longitude, center_latitude;
+  };
+
+  struct Shape {
+    static constexpr uint32_t NO_LABEL = 0xffffffff;
+
+    /**
+     * The bounds in degrees.
+     */
+    rectObj bounds;
+
+    /**
+     * Index of the first line and the first point in the arrays of
+     * the #FileHeader.
+     */
+    uint32_t first_line, first_point;
+
+    /**
+     * Offset of the null-terminated UTF-8 label within the label
+     * area, or #NO_LABEL.
+     */
+    uint32_t label;
+
+    uint8_t type, n_lines;
+    uint16_t reserved;
+  };
+
+  /**
+   * A node of the packed R-tree.  The nodes are stored bottom-up,
+   * i.e. the last one is the root.
+   */
+  struct Node {
+    rectObj bounds;
+
+    /**
+     * For a leaf: index of the first entry, which is a shape index.
+     * Otherwise: index of the first child node.
+     */
+    uint32_t first;
+
+    uint16_t count;
+
+    uint8_t leaf;
+    uint8_t reserved;
+  };
+
+  /**
+   * Provides access to the data of one topography file inside the
+   * mapped cache.
+   */
+  class File {
+    const uint8_t *base;
+    const FileHeader *header;
+
+  public:
+    File():header(nullptr) {}
+    File(const void *_base, const FileHeader &_header)
+      :base((const uint8_t *)_base), header(&_header) {}
+
+    bool IsDefined() const {
+      return header != nullptr;
+    }
+
+    unsigned GetShapeCount() const {
+      return header->n_shapes;
+    }
+
+    const rectObj &GetBounds() const {
+      return header->bounds;
+    }
+
+    GeoPoint GetCenter() const {
+      return GeoPoint(Angle::Native(fixed(header->center_longitude)),
+                      Angle::Native(fixed(header->center_latitude)));
+    }
+
+    const Shape &GetShape(unsigned i) const {
+      return ((const Shape *)(base + header->shapes_offset))[i];
+    }
+
+    const unsigned short *GetLines(const Shape &shape) const {
+      return (const unsigned short *)(base + header->lines_offset)
+        + shape.first_line;
+    }
+
+    const ShapePoint *GetPoints(const Shape &shape) const {
+      return (const ShapePoint *)(base + header->points_offset)
+        + shape.first_point;
+    }
+
+    const char *GetLabel(const Shape &shape) const {
+      return shape.label != Shape::NO_LABEL
+        ? (const char *)(base + header->labels_offset + shape.label)
+        : nullptr;
+    }
+
+    /**
+     * Set the bits of all shapes which overlap the given rectangle
+     * (in degrees).  The other bits are not modified.
+     */
+    void Query(const rectObj &rect, ms_bitarray status) const;
+
+  private:
+    void Query(const Node &node, const rectObj &rect,
+               ms_bitarray status) const;
+  };
+
+private:
+  FileMapping *mapping;
+
+public:
+  TopographyCache():mapping(nullptr) {}
+  ~TopographyCache();
+
+  bool IsDefined() const {
+    return mapping != nullptr;
+  }
+
+  /**
+   * Map the specified file into memory and verify it.
+   */
+  bool Load(const TCHAR *path);
+
+  void Reset();
+
+  /**
+   * Look up the topography file with the specified name.  Returns an
+   * undefined object if there is none.
+   */
+  gcc_pure
+  File Find(const char *name) const;
+
+  /**
+   * Write all shapes of the store to a new cache file.  All shapes
+   * must have been loaded (see TopographyStore::LoadAll()).
+   */
+  static bool Save(FILE *file, const TopographyStore &store);
+};
+
+#endif
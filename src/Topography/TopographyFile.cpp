@@ -24,12 +24,34 @@ Copyright_License {
 #include "Topography/TopographyFile.hpp"
 #include "Topography/XShape.hpp"
 #include "Convert.hpp"
-#include "Projection/WindowProjection.hpp"
 
 #include <zzip/lib.h>
 
 #include <algorithm>
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * Extract the name of the shapefile from the path, i.e. strip the
+ * directory and the ".shp" suffix.
+ */
+static void
+ExtractName(NarrowString<64> &dest, const char *path)
+{
+  const char *slash = strrchr(path, '/');
+  if (slash != nullptr)
+    path = slash + 1;
+
+  const char *backslash = strrchr(path, '\\');
+  if (backslash != nullptr)
+    path = backslash + 1;
+
+  dest = path;
+
+  const size_t length = dest.length();
+  if (length > 4 && strcmp(dest.c_str() + length - 4, ".shp") == 0)
+    dest.Truncate(length - 4);
+}
 
 TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                fixed _threshold,
@@ -38,8 +60,10 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
                                const Color _color,
                                int _label_field,
                                ResourceId _icon, ResourceId _big_icon,
-                               unsigned _pen_width)
-  :dir(_dir), first(nullptr),
+                               unsigned _pen_width,
+                               TopographyCache::File _cache)
+  :dir(_dir), cache(_cache), cache_status(nullptr),
+   update_status(nullptr), first(nullptr),
    label_field(_label_field), icon(_icon), big_icon(_big_icon),
    pen_width(_pen_width),
    color(_color), scale_threshold(_threshold),
@@ -47,6 +71,23 @@ TopographyFile::TopographyFile(zzip_dir *_dir, const char *filename,
    important_label_threshold(_important_label_threshold),
    cache_bounds(GeoBounds::Invalid())
 {
+  ExtractName(name, filename);
+
+  if (cache.IsDefined()) {
+    if (cache.GetShapeCount() == 0)
+      return;
+
+    center = cache.GetCenter();
+
+    shapes.ResizeDiscard(cache.GetShapeCount());
+    std::fill(shapes.begin(), shapes.end(), ShapeList(nullptr));
+
+    cache_status = msAllocBitArray(shapes.size());
+
+    ++serial;
+    return;
+  }
+
   if (msShapefileOpen(&file, "rb", dir, filename, 0) == -1)
     return;
 
@@ -72,6 +113,12 @@ TopographyFile::~TopographyFile()
     return;
 
   ClearCache();
+
+  if (cache.IsDefined()) {
+    free(cache_status);
+    return;
+  }
+
   msShapefileClose(&file);
 
   if (dir != nullptr) {
@@ -91,74 +138,106 @@ TopographyFile::ClearCache()
   first = nullptr;
 }
 
-static XShape *
-LoadShape(shapefileObj *file, const GeoPoint &center, int i,
-          int label_field)
+XShape *
+TopographyFile::LoadShape(unsigned i)
 {
-  return new XShape(file, center, i, label_field);
+  if (cache.IsDefined())
+    return new XShape(cache, center, i);
+
+  return new XShape(&file, center, i, label_field);
 }
 
 bool
-TopographyFile::Update(const WindowProjection &map_projection)
+TopographyFile::PrepareUpdate(fixed map_scale, const GeoBounds &screen_bounds)
 {
   if (IsEmpty())
     return false;
 
-  if (map_projection.GetMapScale() > scale_threshold)
+  if (map_scale > scale_threshold)
     /* not visible, don't update cache now */
     return false;
 
-  const GeoBounds screenRect =
-    map_projection.GetScreenBounds();
-  if (cache_bounds.IsValid() && cache_bounds.IsInside(screenRect))
+  if (cache_bounds.IsValid() && cache_bounds.IsInside(screen_bounds))
     /* the cache is still fresh */
     return false;
 
-  cache_bounds = screenRect.Scale(fixed(2));
+  cache_bounds = screen_bounds.Scale(fixed(2));
 
   rectObj deg_bounds = ConvertRect(cache_bounds);
 
-  // Test which shapes are inside the given bounds and save the
-  // status to file.status
-  switch (msShapefileWhichShapes(&file, dir, deg_bounds, 0)) {
-  case MS_FAILURE:
-    ClearCache();
-    return false;
+  update_status = nullptr;
+
+  if (cache.IsDefined()) {
+    if (msRectOverlap(&cache.GetBounds(), &deg_bounds) != MS_TRUE)
+      /* screen is outside of map bounds */
+      return true;
+
+    // Look up the visible shapes in the cache's spatial index
+    msSetAllBits(cache_status, shapes.size(), 0);
+    cache.Query(deg_bounds, cache_status);
+    update_status = cache_status;
+  } else {
+    // Test which shapes are inside the given bounds and save the
+    // status to file.status
+    switch (msShapefileWhichShapes(&file, dir, deg_bounds, 0)) {
+    case MS_FAILURE:
+    case MS_DONE:
+      /* screen is outside of map bounds */
+      return true;
+
+    case MS_SUCCESS:
+      break;
+    }
 
-  case MS_DONE:
-    /* screen is outside of map bounds */
-    return true;
+    assert(file.status != nullptr);
+    update_status = file.status;
+  }
 
-  case MS_SUCCESS:
-    break;
+  /* load the new shapes; they are not linked into the list yet, and
+     readers only follow the list, so they don't see them */
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    ShapeList &item = shapes[i];
+    if (item.shape == nullptr && msGetBit(update_status, i))
+      item.shape = LoadShape(i);
   }
 
-  assert(file.status != nullptr);
+  return true;
+}
 
-  // Iterate through the shapefile entries
+void
+TopographyFile::CommitUpdate()
+{
   const ShapeList **current = &first;
-  auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
-    if (!msGetBit(file.status, i)) {
-      // If the shape is outside the bounds
-      // delete the shape from the cache
-      delete it->shape;
-      it->shape = nullptr;
-    } else {
-      // is inside the bounds
-      if (it->shape == nullptr)
-        // shape isn't cached yet -> cache the shape
-        it->shape = LoadShape(&file, center, i, label_field);
-      // update list pointer
-      *current = it;
-      current = &it->next;
+  if (update_status != nullptr) {
+    auto it = shapes.begin();
+    for (unsigned i = 0; i < shapes.size(); ++i, ++it) {
+      if (msGetBit(update_status, i)) {
+        assert(it->shape != nullptr);
+
+        *current = it;
+        current = &it->next;
+      }
     }
   }
+
   // end of list marker
   *current = nullptr;
 
   ++serial;
-  return true;
+}
+
+void
+TopographyFile::FinishUpdate()
+{
+  for (unsigned i = 0; i < shapes.size(); ++i) {
+    ShapeList &item = shapes[i];
+    if (item.shape != nullptr &&
+        (update_status == nullptr || !msGetBit(update_status, i))) {
+      // the shape is outside the bounds; delete it from the cache
+      delete item.shape;
+      item.shape = nullptr;
+    }
+  }
 }
 
 void
@@ -167,10 +246,10 @@ TopographyFile::LoadAll()
   // Iterate through the shapefile entries
   const ShapeList **current = &first;
   auto it = shapes.begin();
-  for (int i = 0; i < file.numshapes; ++i, ++it) {
+  for (unsigned i = 0; i < shapes.size(); ++i, ++it) {
     if (it->shape == nullptr)
       // shape isn't cached yet -> cache the shape
-      it->shape = LoadShape(&file, center, i, label_field);
+      it->shape = LoadShape(i);
     // update list pointer
     *current = it;
     current = &it->next;
@@ -26,9 +26,11 @@ Copyright_License {
 #define TOPOGRAPHY_HPP
 
 #include "shapelib/mapserver.h"
+#include "TopographyCache.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Util/AllocatedArray.hpp"
 #include "Util/Serial.hpp"
+#include "Util/StaticString.hpp"
 #include "Math/fixed.hpp"
 #include "Screen/Color.hpp"
 #include "ResourceId.hpp"
@@ -39,7 +41,6 @@ Copyright_License {
 
 #include <assert.h>
 
-class WindowProjection;
 class XShape;
 struct zzip_dir;
 
@@ -60,8 +61,33 @@ class TopographyFile {
 
   zzip_dir *const dir;
 
+  /**
+   * The name of the shapefile without the directory and the ".shp"
+   * suffix.
+   */
+  NarrowString<64> name;
+
   shapefileObj file;
 
+  /**
+   * If defined, then the shapes are loaded from this cache instead of
+   * #file.
+   */
+  TopographyCache::File cache;
+
+  /**
+   * The visibility bits of the shapes in the #cache, see
+   * TopographyCache::File::Query().
+   */
+  ms_bitarray cache_status;
+
+  /**
+   * The shapes selected by PrepareUpdate(), to be published by
+   * CommitUpdate().  nullptr means no shape is needed.  This points
+   * to #cache_status or shapefileObj::status.
+   */
+  ms_const_bitarray update_status;
+
   /**
    * The center of shapefileObj::bounds.
    */
@@ -154,6 +180,8 @@ public:
    * @param label_threshold the zoom threshold for label rendering
    * @param important_label_threshold labels below this zoom threshold will
    * be rendered in default style
+   * @param cache if defined, then the shapes are loaded from this
+   * cache, and the shapefile is not opened
    * @return
    */
   TopographyFile(zzip_dir *dir, const char *shpname,
@@ -163,7 +191,8 @@ public:
                  int label_field=-1,
                  ResourceId icon=ResourceId::Null(),
                  ResourceId big_icon=ResourceId::Null(),
-                 unsigned pen_width=1);
+                 unsigned pen_width=1,
+                 TopographyCache::File cache=TopographyCache::File());
 
   TopographyFile(const TopographyFile &) = delete;
 
@@ -176,6 +205,10 @@ public:
     return serial;
   }
 
+  const char *GetName() const {
+    return name;
+  }
+
   const GeoPoint &GetCenter() const {
     return center;
   }
@@ -244,9 +277,28 @@ public:
 #endif
 
   /**
-   * @return true if new data from the topography file has been loaded
+   * Determine which shapes are needed for the specified screen
+   * bounds, and load the missing ones.  This does not modify the
+   * shape list visible through begin() and end(), therefore it may be
+   * called while another thread is reading it.
+   *
+   * @return true if CommitUpdate() and FinishUpdate() must be called
+   */
+  bool PrepareUpdate(fixed map_scale, const GeoBounds &screen_bounds);
+
+  /**
+   * Replace the shape list with the one selected by PrepareUpdate().
+   * This is cheap, no shape gets loaded or freed here.  The caller
+   * must ensure that nobody reads the shape list meanwhile.
    */
-  bool Update(const WindowProjection &map_projection);
+  void CommitUpdate();
+
+  /**
+   * Free the shapes which have been removed from the shape list by
+   * CommitUpdate().  Readers which have obtained a new shape list
+   * after CommitUpdate() are not affected.
+   */
+  void FinishUpdate();
 
   /**
    * Load all shapes into memory.  For debugging purposes.
@@ -255,6 +307,8 @@ public:
 
 protected:
   void ClearCache();
+
+  XShape *LoadShape(unsigned i);
 };
 
 #endif
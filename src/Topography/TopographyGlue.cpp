@@ -29,6 +29,7 @@ Copyright_License {
 #include "Operation/Operation.hpp"
 #include "IO/ZipLineReader.hpp"
 #include "Util/ConvertString.hpp"
+#include "OS/FileUtil.hpp"
 
 #include <zzip/zzip.h>
 
@@ -58,7 +59,17 @@ LoadConfiguredTopographyZip(TopographyStore &store,
     return false;
   }
 
-  store.Load(operation, reader, nullptr, dir);
+  /* use the preconverted shapes generated by ConvertTopography,
+     unless the file is older than the map file */
+  TCHAR cache_path[MAX_PATH];
+  _tcscpy(cache_path, path);
+  _tcscat(cache_path, _T(".topography"));
+  const bool use_cache = File::Exists(cache_path) &&
+    File::GetLastModification(cache_path) >=
+    File::GetLastModification(path);
+
+  store.Load(operation, reader, nullptr, dir,
+             use_cache ? cache_path : nullptr);
   zzip_dir_close(dir);
   return true;
 }
@@ -41,6 +41,7 @@ void
 TopographyRenderer::Draw(Canvas &canvas,
                          const WindowProjection &projection) const
 {
+  Poco::ScopedRWLock protect(store.GetMutex());
   for (auto it = files.begin(), end = files.end(); it != end; ++it)
     (*it)->Paint(canvas, projection);
 }
@@ -50,6 +51,7 @@ TopographyRenderer::DrawLabels(Canvas &canvas,
                                const WindowProjection &projection,
                                LabelBlock &label_block) const
 {
+  Poco::ScopedRWLock protect(store.GetMutex());
   for (auto it = files.begin(), end = files.end(); it != end; ++it)
     (*it)->PaintLabels(canvas, projection, label_block);
 }
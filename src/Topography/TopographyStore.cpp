@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyFile.hpp"
+#include "Projection/WindowProjection.hpp"
 #include "Util/StringUtil.hpp"
 #include "Util/ConvertString.hpp"
 #include "IO/LineReader.hpp"
@@ -96,26 +97,48 @@ static constexpr LOOKUP_ICON icon_list[] = {
 
 unsigned
 TopographyStore::ScanVisibility(const WindowProjection &m_projection,
-                              unsigned max_update)
+                                unsigned max_update)
+{
+  return ScanVisibility(m_projection.GetMapScale(),
+                        m_projection.GetScreenBounds(), max_update);
+}
+
+unsigned
+TopographyStore::ScanVisibility(fixed map_scale,
+                                const GeoBounds &screen_bounds,
+                                unsigned max_update)
 {
   // check if any needs to have cache updates because wasnt
   // visible previously when bounds moved
 
-  // we will make sure we update at least one cache per call
-  // to make sure eventually everything gets refreshed
-  unsigned num_updated = 0;
+  /* load the new shapes without holding the lock; the renderer keeps
+     drawing the old shape lists meanwhile */
+  StaticArray<TopographyFile *, MAXTOPOGRAPHY> updated;
   for (auto it = files.begin(), end = files.end(); it != end; ++it) {
     TopographyFile &file = **it;
 
-    if (file.Update(m_projection)) {
-      ++num_updated;
-      if (num_updated >= max_update)
+    if (file.PrepareUpdate(map_scale, screen_bounds)) {
+      updated.append(&file);
+      if (updated.size() >= max_update)
         break;
     }
   }
 
-  serial += num_updated;
-  return num_updated;
+  if (updated.empty())
+    return 0;
+
+  {
+    Poco::ScopedRWLock protect(mutex, true);
+    for (auto *file : updated)
+      file->CommitUpdate();
+
+    serial += updated.size();
+  }
+
+  for (auto *file : updated)
+    file->FinishUpdate();
+
+  return updated.size();
 }
 
 void
@@ -134,10 +157,16 @@ TopographyStore::~TopographyStore()
 
 void
 TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
-                      const TCHAR *directory, struct zzip_dir *zdir)
+                      const TCHAR *directory, struct zzip_dir *zdir,
+                      const TCHAR *cache_path)
 {
   Reset();
 
+  /* if the cache is not usable, all shapes are loaded from the
+     shapefiles */
+  if (cache_path != nullptr)
+    cache.Load(cache_path);
+
   // Create buffer for the shape filenames
   // (shape_filename will be modified with the shape_filename_end pointer)
   char shape_filename[MAX_PATH];
@@ -185,6 +214,10 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
         continue;
     }
 
+    // Look up the shapefile in the cache
+    *p = 0;
+    const TopographyCache::File cached = cache.Find(line);
+
     // Extract filename and append it to the shape_filename buffer
     memcpy(shape_filename_end, line, p - line);
     // Append ".shp" file extension to the shape_filename buffer
@@ -280,7 +313,7 @@ TopographyStore::Load(OperationEnvironment &operation, NLineReader &reader,
                                               Color(red, green, blue),
 #endif
                                               shape_field, icon, big_icon,
-                                              pen_width);
+                                              pen_width, cached);
     if (file->IsEmpty())
       // If the shape file could not be read -> skip this line/file
       delete file;
@@ -302,4 +335,5 @@ TopographyStore::Reset()
   }
 
   files.clear();
+  cache.Reset();
 }
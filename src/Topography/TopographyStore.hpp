@@ -24,12 +24,16 @@ Copyright_License {
 #ifndef TOPOGRAPHY_STORE_HPP
 #define TOPOGRAPHY_STORE_HPP
 
+#include "TopographyCache.hpp"
 #include "Util/NonCopyable.hpp"
 #include "Util/StaticArray.hpp"
+#include "Math/fixed.hpp"
+#include "Poco/RWLock.h"
 
 #include <tchar.h>
 
 class WindowProjection;
+class GeoBounds;
 class TopographyFile;
 class NLineReader;
 class OperationEnvironment;
@@ -46,6 +50,20 @@ public:
 private:
   StaticArray<TopographyFile *, MAXTOPOGRAPHY> files;
 
+  /**
+   * The preconverted shapes, see TopographyCache.  The files refer to
+   * it, so it must be kept until they are deleted.
+   */
+  TopographyCache cache;
+
+  /**
+   * Protects the shape lists of all files.  Renderers hold a read
+   * lock while drawing; ScanVisibility() obtains the write lock only
+   * for publishing the new shape lists, while the shapes themselves
+   * are loaded and freed without it.
+   */
+  mutable Poco::RWLock mutex;
+
   /**
    * This number is incremented each time this object is modified.
    */
@@ -71,6 +89,14 @@ public:
     return *files[i];
   }
 
+  /**
+   * The lock which must be held (at least for reading) while
+   * iterating the shapes of the files.
+   */
+  Poco::RWLock &GetMutex() const {
+    return mutex;
+  }
+
   /**
    * @param max_update the maximum number of files updated in this
    * call
@@ -79,14 +105,34 @@ public:
   unsigned ScanVisibility(const WindowProjection &m_projection,
                           unsigned max_update=1024);
 
+  /**
+   * Load the shapes which are needed for the specified screen
+   * bounds.  All updated files are published at the same time, so a
+   * reader never sees a partially updated store.  This method may be
+   * called in a thread other than the renderer, but only one thread
+   * may call it at a time.
+   *
+   * @param screen_bounds the area which is expected to be visible
+   * @param max_update the maximum number of files updated in this
+   * call
+   * @return the number of files which were updated
+   */
+  unsigned ScanVisibility(fixed map_scale, const GeoBounds &screen_bounds,
+                          unsigned max_update=1024);
+
   /**
    * Load all shapes of all files into memory.  For debugging
    * purposes.
    */
   void LoadAll();
 
+  /**
+   * @param cache_path an optional #TopographyCache file which
+   * provides preconverted shapes for some or all of the files
+   */
   void Load(OperationEnvironment &operation, NLineReader &reader,
-            const TCHAR *directory, struct zzip_dir *zdir = nullptr);
+            const TCHAR *directory, struct zzip_dir *zdir = nullptr,
+            const TCHAR *cache_path = nullptr);
   void Reset();
 };
 
@@ -0,0 +1,92 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TopographyUpdater.hpp"
+#include "TopographyStore.hpp"
+
+TopographyUpdater::TopographyUpdater()
+  :StandbyThread("Topography"),
+   store(nullptr),
+   map_scale(fixed(0)), bounds(GeoBounds::Invalid()),
+   new_request(false) {}
+
+void
+TopographyUpdater::SetStore(TopographyStore *_store)
+{
+  ScopeLock protect(mutex);
+
+  /* the old store may be modified or deleted as soon as this method
+     returns; cancel the loop in Tick() and wait for the thread to
+     release it */
+  store = nullptr;
+  WaitDone();
+
+  store = _store;
+  bounds = GeoBounds::Invalid();
+}
+
+void
+TopographyUpdater::Request(fixed _map_scale, const GeoBounds &_bounds)
+{
+  assert(_bounds.IsValid());
+
+  ScopeLock protect(mutex);
+  if (store == nullptr)
+    return;
+
+  if (_map_scale == map_scale && bounds.IsValid() &&
+      bounds.IsInside(_bounds) && _bounds.IsInside(bounds))
+    /* same view as before, nothing to do */
+    return;
+
+  map_scale = _map_scale;
+  bounds = _bounds;
+
+  if (StandbyThread::IsBusy())
+    /* the running Tick() will pick up the new view */
+    new_request = true;
+  else
+    Trigger();
+}
+
+void
+TopographyUpdater::Tick()
+{
+  while (!IsStopped() && store != nullptr && bounds.IsValid()) {
+    TopographyStore &_store = *store;
+    const fixed _map_scale = map_scale;
+    const GeoBounds _bounds = bounds;
+    new_request = false;
+
+    mutex.Unlock();
+
+    /* this is the expensive part; the renderer keeps drawing the old
+       shape lists meanwhile */
+    _store.ScanVisibility(_map_scale, _bounds);
+
+    mutex.Lock();
+
+    if (!new_request)
+      break;
+  }
+}
@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TOPOGRAPHY_UPDATER_HPP
+#define XCSOAR_TOPOGRAPHY_UPDATER_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Geo/GeoBounds.hpp"
+#include "Math/fixed.hpp"
+
+class TopographyStore;
+
+/**
+ * Loads the visible topography shapes in a background thread.  The
+ * new shape lists of all files are published at once (see
+ * TopographyStore::ScanVisibility()), so the renderer always draws a
+ * complete snapshot and never waits for shapefile I/O.
+ */
+class TopographyUpdater final : private StandbyThread {
+  TopographyStore *store;
+
+  /**
+   * The most recently requested view.  Protected by
+   * StandbyThread::mutex.
+   */
+  fixed map_scale;
+  GeoBounds bounds;
+
+  /**
+   * Was a new view requested while the thread was busy?  Protected
+   * by StandbyThread::mutex.
+   */
+  bool new_request;
+
+public:
+  TopographyUpdater();
+
+  /**
+   * Change the topography object.  Waits for the current job to
+   * finish, so the old object may be deleted after this method
+   * returns.
+   */
+  void SetStore(TopographyStore *_store);
+
+  /**
+   * Schedule loading the shapes for the specified view.  This method
+   * returns immediately.
+   *
+   * @param bounds the area which is expected to be visible soon;
+   * this may be larger than the screen
+   */
+  void Request(fixed map_scale, const GeoBounds &bounds);
+
+  /**
+   * Is the thread still loading shapes?
+   */
+  bool IsBusy() {
+    ScopeLock protect(mutex);
+    return StandbyThread::IsBusy();
+  }
+
+  /**
+   * Stop the thread and wait for it to exit.
+   */
+  void Stop() {
+    LockStop();
+  }
+
+private:
+  /* virtual methods from class StandbyThread */
+  void Tick() override;
+};
+
+#endif
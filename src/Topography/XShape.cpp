@@ -98,6 +98,7 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
   :label(nullptr)
 {
 #ifdef ENABLE_OPENGL
+  mapped = false;
   std::fill_n(index_count, THINNING_LEVELS, nullptr);
   std::fill_n(indices, THINNING_LEVELS, nullptr);
 #endif
@@ -170,10 +171,47 @@ XShape::XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
   msFreeShape(&shape);
 }
 
+XShape::XShape(const TopographyCache::File &cache,
+               const GeoPoint &file_center, unsigned i)
+{
+  const TopographyCache::Shape &src = cache.GetShape(i);
+
+  bounds = ImportRect(src.bounds);
+  type = src.type;
+  num_lines = std::min((unsigned)src.n_lines, (unsigned)MAX_LINES);
+  std::copy_n(cache.GetLines(src), num_lines, lines);
+
+#ifdef ENABLE_OPENGL
+  std::fill_n(index_count, THINNING_LEVELS, nullptr);
+  std::fill_n(indices, THINNING_LEVELS, nullptr);
+
+  /* the cache has the same format, refer to it */
+  mapped = true;
+  points = const_cast<ShapePoint *>(cache.GetPoints(src));
+#else
+  unsigned num_points = 0;
+  for (unsigned l = 0; l < num_lines; ++l)
+    num_points += lines[l];
+
+  const ShapePoint *src_points = cache.GetPoints(src);
+  points = new GeoPoint[num_points];
+  for (unsigned j = 0; j < num_points; ++j)
+    points[j] = GeoPoint(file_center.longitude +
+                         Angle::Native(fixed(src_points[j].x)),
+                         file_center.latitude +
+                         Angle::Native(fixed(src_points[j].y)));
+#endif
+
+  label = import_label(cache.GetLabel(src));
+}
+
 XShape::~XShape()
 {
   free(label);
-  delete[] points;
+#ifdef ENABLE_OPENGL
+  if (!mapped)
+#endif
+    delete[] points;
 #ifdef ENABLE_OPENGL
   // Note: index_count and indices share one buffer
   for (unsigned i = 0; i < THINNING_LEVELS; i++)
@@ -25,6 +25,7 @@ Copyright_License {
 #ifndef TOPOGRAPHY_XSHAPE_HPP
 #define TOPOGRAPHY_XSHAPE_HPP
 
+#include "Topography/TopographyCache.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "shapelib/mapserver.h"
 #include "shapelib/mapshape.h"
@@ -51,6 +52,14 @@ class XShape {
    */
   unsigned char num_lines;
 
+#ifdef ENABLE_OPENGL
+  /**
+   * Does #points refer to a #TopographyCache mapping (i.e. it is not
+   * owned by this object)?
+   */
+  bool mapped;
+#endif
+
   /**
    * An array which stores the number of points of each line.  This is
    * a fixed-size array to reduce the number of allocations at
@@ -92,6 +101,14 @@ public:
   XShape(shapefileObj *shpfile, const GeoPoint &file_center, int i,
          int label_field=-1);
 
+  /**
+   * Construct a shape from a #TopographyCache record.  On OpenGL, the
+   * points are not copied; the cache must remain valid as long as
+   * this object exists.
+   */
+  XShape(const TopographyCache::File &cache, const GeoPoint &file_center,
+         unsigned i);
+
   XShape(const XShape &) = delete;
 
   ~XShape();
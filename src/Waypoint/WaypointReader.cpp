@@ -30,6 +30,7 @@ Copyright_License {
 #include "WaypointReaderCompeGPS.hpp"
 #include "WaypointFileType.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/FileMapping.hpp"
 #include "IO/ZipSource.hpp"
 #include "IO/TextFile.hpp"
 #include "Util/StringUtil.hpp"
@@ -40,6 +41,14 @@ WaypointReader::Parse(Waypoints &way_points, OperationEnvironment &operation)
   if (reader == NULL)
     return false;
 
+  /* plain files are mapped into memory and parsed in parallel */
+  FileMapping mapping(path);
+  if (!mapping.error()) {
+    reader->ParseBuffer(way_points, (const char *)mapping.data(),
+                        mapping.size(), operation);
+    return true;
+  }
+
   TLineReader *line_reader = OpenTextFile(path, ConvertLineReader::AUTO);
   if (line_reader == nullptr)
     return false;
@@ -24,11 +24,37 @@ Copyright_License {
 #include "WaypointReaderBase.hpp"
 
 #include "Terrain/RasterTerrain.hpp"
-#include "Waypoint/Waypoint.hpp"
+#include "Waypoint/Waypoints.hpp"
 #include "Operation/Operation.hpp"
 #include "IO/LineReader.hpp"
+#include "IO/MemoryLineReader.hpp"
+#include "IO/ConvertLineReader.hpp"
+#include "Thread/Thread.hpp"
+#include "OS/CPU.hpp"
+#include "Util/ReusableArray.hpp"
+#include "Util/UTF8.hpp"
+#include "Util/Clamp.hpp"
+
+#include <memory>
+#include <algorithm>
 
 #include <assert.h>
+#include <string.h>
+
+/**
+ * The number of lines which are parsed by the original reader before
+ * the rest of the file is split into chunks.  File headers (which
+ * may modify the parser state, e.g. select UTM coordinates) are
+ * expected to be within this range.
+ */
+static constexpr unsigned HEADER_LINES = 16;
+
+/**
+ * Files are not split into chunks smaller than this.
+ */
+static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+static constexpr unsigned MAX_CHUNKS = 8;
 
 WaypointReaderBase::WaypointReaderBase(const int _file_num,
                            bool _compressed):
@@ -167,13 +193,251 @@ WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
   const long filesize = std::max(reader.GetSize(), 1l);
   operation.SetProgressRange(100);
 
+  std::vector<Waypoint> parsed;
+
   // Read through the lines of the file
   TCHAR *line;
   for (unsigned i = 0; (line = reader.ReadLine()) != NULL; i++) {
     // and parse them
-    ParseLine(line, i, way_points);
+    ParseLine(line, i, parsed);
+
+    if ((i & 0x3f) == 0) {
+      way_points.Append(std::move(parsed));
+      parsed.clear();
 
-    if ((i & 0x3f) == 0)
       operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+    }
+  }
+
+  way_points.Append(std::move(parsed));
+}
+
+bool
+WaypointReaderBase::Parse(std::vector<Waypoint> &way_points,
+                          TLineReader &reader, unsigned first_line)
+{
+  TCHAR *line;
+  for (unsigned i = first_line; (line = reader.ReadLine()) != NULL; i++)
+    ParseLine(line, i, way_points);
+
+  return !IsEndOfWaypoints();
+}
+
+/**
+ * A line-aligned portion of a file being parsed by
+ * WaypointReaderBase::ParseBuffer().
+ */
+struct WaypointChunk {
+  const char *begin, *end;
+
+  /** the line number of the first line */
+  unsigned first_line;
+
+  /**
+   * The character set which #ConvertLineReader would be using at the
+   * beginning of this chunk if it had read the whole file.
+   */
+  ConvertLineReader::charset charset;
+
+  /**
+   * The reader which parses this chunk: either the original one, or
+   * #clone.
+   */
+  WaypointReaderBase *reader;
+  std::unique_ptr<WaypointReaderBase> clone;
+
+  std::vector<Waypoint> waypoints;
+
+  /**
+   * Was the end of the waypoint section reached in this chunk?
+   */
+  bool end_of_waypoints;
+
+  WaypointChunk(const char *_begin, unsigned _first_line,
+                ConvertLineReader::charset _charset)
+    :begin(_begin), end(_begin), first_line(_first_line),
+     charset(_charset), reader(nullptr), end_of_waypoints(false) {}
+
+  void Parse() {
+    MemoryLineReaderA lines(begin, end);
+    ConvertLineReader convert(lines, charset);
+    end_of_waypoints = !reader->Parse(waypoints, convert, first_line);
+  }
+};
+
+class WaypointChunkThread final : public Thread {
+  WaypointChunk &chunk;
+
+public:
+  explicit WaypointChunkThread(WaypointChunk &_chunk)
+    :Thread("WaypointParser"), chunk(_chunk) {}
+
+protected:
+  void Run() override {
+    chunk.Parse();
+  }
+};
+
+gcc_pure
+static bool
+IsASCII(const char *p, const char *end)
+{
+  for (; p != end; ++p)
+    if ((unsigned char)*p >= 0x80)
+      return false;
+
+  return true;
+}
+
+/**
+ * Check whether #ConvertLineReader would accept the line (without the
+ * line feed) as UTF-8.
+ */
+static bool
+IsValidUTF8Line(const char *p, const char *end, ReusableArray<char> &buffer)
+{
+  if (IsASCII(p, end))
+    return true;
+
+  const size_t length = end - p;
+  char *line = buffer.get(length + 1);
+  if (line == nullptr)
+    return false;
+
+  memcpy(line, p, length);
+  line[length] = 0;
+  return ValidateUTF8(line);
+}
+
+gcc_pure
+static bool
+StartsWithBOM(const char *p, const char *end)
+{
+  return end - p >= 3 && memcmp(p, "\xef\xbb\xbf", 3) == 0;
+}
+
+void
+WaypointReaderBase::ParseBuffer(Waypoints &way_points,
+                                const char *data, size_t size,
+                                OperationEnvironment &operation,
+                                unsigned max_chunks)
+{
+  operation.SetProgressRange(100);
+
+  if (size == 0)
+    return;
+
+  if (max_chunks == 0)
+    max_chunks = std::min(GetProcessorCount(), MAX_CHUNKS);
+
+  const char *const end = data + size;
+  const unsigned n_splits =
+    Clamp<size_t>(size / MIN_CHUNK_SIZE, 1, max_chunks);
+
+  /* find the chunk boundaries, the line number at each boundary and
+     the character set which ConvertLineReader::AUTO would choose;
+     the chunks are split where it switches to ISO-Latin-1 */
+
+  std::vector<WaypointChunk> chunks;
+  chunks.reserve(n_splits + 2);
+
+  ConvertLineReader::charset charset = ConvertLineReader::AUTO;
+  chunks.emplace_back(data, 0, charset);
+
+  ReusableArray<char> buffer;
+  unsigned next_split = 1;
+  const char *p = data;
+  unsigned line = 0;
+  for (; p != end; ++line) {
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    const char *next = eol != nullptr ? eol + 1 : end;
+    if (eol == nullptr)
+      eol = end;
+
+    bool split = false;
+    if (line == HEADER_LINES)
+      split = true;
+    else if (line > HEADER_LINES && next_split < n_splits &&
+             p >= data + size * next_split / n_splits) {
+      split = true;
+      ++next_split;
+    }
+
+    if (charset != ConvertLineReader::ISO_LATIN_1) {
+      if (StartsWithBOM(p, eol))
+        charset = ConvertLineReader::UTF8;
+
+      if (!IsValidUTF8Line(p, eol, buffer)) {
+        if (charset == ConvertLineReader::UTF8)
+          /* ConvertLineReader stops at the first invalid line */
+          break;
+
+        charset = ConvertLineReader::ISO_LATIN_1;
+        split = true;
+      }
+    }
+
+    if (split && p > chunks.back().begin) {
+      chunks.back().end = p;
+      chunks.emplace_back(p, line, charset);
+    } else if (split)
+      chunks.back().charset = charset;
+
+    p = next;
+  }
+
+  chunks.back().end = p;
+
+  /* parse the header chunk(s) with this object; its parser state is
+     then copied to the clones */
+
+  auto chunk = chunks.begin();
+  for (; chunk != chunks.end() && chunk->first_line < HEADER_LINES; ++chunk) {
+    chunk->reader = this;
+    chunk->Parse();
+  }
+
+  if (!IsEndOfWaypoints()) {
+    /* parse the remaining chunks in parallel; the last one is parsed
+       by this thread */
+
+    std::vector<std::unique_ptr<WaypointChunkThread>> threads;
+    for (auto i = chunk; i != chunks.end(); ++i) {
+      if (std::next(i) == chunks.end()) {
+        i->reader = this;
+        break;
+      }
+
+      i->clone.reset(Clone());
+      i->reader = i->clone.get();
+
+      threads.emplace_back(new WaypointChunkThread(*i));
+      if (!threads.back()->Start()) {
+        /* no thread available: parse it here */
+        threads.pop_back();
+        i->Parse();
+      }
+    }
+
+    if (chunk != chunks.end() && chunks.back().reader == this)
+      chunks.back().Parse();
+
+    for (auto &thread : threads)
+      thread->Join();
+  }
+
+  /* add the results in file order, up to the end of the waypoint
+     section */
+
+  for (auto &i : chunks) {
+    if (i.reader == nullptr)
+      break;
+
+    way_points.Append(std::move(i.waypoints));
+    i.waypoints.clear();
+    operation.SetProgressPosition((i.end - data) * 100 / size);
+
+    if (i.end_of_waypoints)
+      break;
   }
 }
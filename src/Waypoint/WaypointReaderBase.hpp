@@ -25,6 +25,8 @@ Copyright_License {
 #ifndef WAYPOINTFILE_HPP
 #define WAYPOINTFILE_HPP
 
+#include <vector>
+
 #include <tchar.h>
 #include <stddef.h>
 
@@ -48,6 +50,12 @@ protected:
 public:
   virtual ~WaypointReaderBase() {}
 
+  /**
+   * Create a copy of this reader, including its parser state.  Used
+   * to parse portions of a file in other threads, see ParseBuffer().
+   */
+  virtual WaypointReaderBase *Clone() const = 0;
+
   /**
    * Parses a waypoint file into the given waypoint list
    * @param way_points The waypoint list to fill
@@ -57,6 +65,34 @@ public:
   void Parse(Waypoints &way_points, TLineReader &reader,
              OperationEnvironment &operation);
 
+  /**
+   * Parses lines into a vector, without adding them to a #Waypoints
+   * container.
+   *
+   * @param first_line The line number of the first line
+   * @return false if the end of the waypoint section was reached,
+   * i.e. all following lines would be ignored
+   */
+  bool Parse(std::vector<Waypoint> &way_points, TLineReader &reader,
+             unsigned first_line);
+
+  /**
+   * Parses a waypoint file which has been loaded or mapped into
+   * memory.  The first few (header) lines are parsed by this object;
+   * the rest is split into line-aligned chunks, which are parsed in
+   * parallel by clones of this object.  The results are added to
+   * the waypoint list in file order.
+   *
+   * The character set is determined like #ConvertLineReader::AUTO
+   * does.
+   *
+   * @param max_chunks The maximum number of chunks (and threads); 0
+   * means one per CPU core
+   */
+  void ParseBuffer(Waypoints &way_points, const char *data, size_t size,
+                   OperationEnvironment &operation,
+                   unsigned max_chunks = 0);
+
   void SetTerrain(const RasterTerrain* _terrain) {
     terrain = _terrain;
   }
@@ -75,7 +111,15 @@ protected:
    * parsing error occured
    */
   virtual bool ParseLine(const TCHAR* line, unsigned linenum,
-                         Waypoints &way_points) = 0;
+                         std::vector<Waypoint> &way_points) = 0;
+
+  /**
+   * Has ParseLine() seen the end of the waypoint section, i.e. will
+   * all following lines be ignored?
+   */
+  virtual bool IsEndOfWaypoints() const {
+    return false;
+  }
 
 public:
   // Helper functions
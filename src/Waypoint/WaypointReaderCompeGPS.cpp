@@ -22,9 +22,10 @@ Copyright_License {
 */
 
 #include "WaypointReaderCompeGPS.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "IO/LineReader.hpp"
 #include "Geo/UTM.hpp"
+#include "Util/StringUtil.hpp"
 
 #include <stdlib.h>
 
@@ -142,7 +143,7 @@ ParseAltitude(const TCHAR *&src, fixed &dest)
 
 bool
 WaypointReaderCompeGPS::ParseLine(const TCHAR* line, const unsigned linenum,
-                                  Waypoints &waypoints)
+                                  std::vector<Waypoint> &waypoints)
 {
   /*
    * G  WGS 84
@@ -231,7 +232,7 @@ WaypointReaderCompeGPS::ParseLine(const TCHAR* line, const unsigned linenum,
   // Parse waypoint name
   waypoint.comment.assign(line);
 
-  waypoints.Append(std::move(waypoint));
+  waypoints.push_back(std::move(waypoint));
   return true;
 }
 
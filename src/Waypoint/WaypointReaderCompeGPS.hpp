@@ -38,9 +38,13 @@ public:
 
   static bool VerifyFormat(TLineReader &reader);
 
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderCompeGPS(*this);
+  }
+
 protected:
   bool ParseLine(const TCHAR* line, const unsigned linenum,
-                 Waypoints &way_points);
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
@@ -22,8 +22,9 @@ Copyright_License {
 */
 
 #include "WaypointReaderFS.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "Geo/UTM.hpp"
+#include "Util/StringUtil.hpp"
 #include "IO/LineReader.hpp"
 
 #include <stdlib.h>
@@ -146,7 +147,7 @@ ParseString(const TCHAR *src, tstring &dest, unsigned len = 0)
 
 bool
 WaypointReaderFS::ParseLine(const TCHAR* line, const unsigned linenum,
-                              Waypoints &way_points)
+                              std::vector<Waypoint> &way_points)
 {
   //$FormatGEO
   //ACONCAGU  S 32 39 12.00    W 070 00 42.00  6962  Aconcagua
@@ -200,7 +201,7 @@ WaypointReaderFS::ParseLine(const TCHAR* line, const unsigned linenum,
   if (len > (is_utm ? 38 : 47))
     ParseString(line + (is_utm ? 38 : 47), new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.push_back(std::move(new_waypoint));
   return true;
 }
 
@@ -22,9 +22,10 @@ Copyright_License {
 */
 
 #include "WaypointReaderOzi.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "IO/LineReader.hpp"
 #include "Units/System.hpp"
+#include "Util/StringUtil.hpp"
 #include "Util/Macros.hpp"
 
 #include <stdlib.h>
@@ -67,7 +68,7 @@ ParseString(const TCHAR *src, tstring &dest)
 
 bool
 WaypointReaderOzi::ParseLine(const TCHAR* line, const unsigned linenum,
-                              Waypoints &way_points)
+                              std::vector<Waypoint> &way_points)
 {
   if (line[0] == '\0')
     return true;
@@ -120,7 +121,7 @@ WaypointReaderOzi::ParseLine(const TCHAR* line, const unsigned linenum,
   // Description (Characters 35-44)
   ParseString(params[11], new_waypoint.comment);
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.push_back(std::move(new_waypoint));
   return true;
 }
 
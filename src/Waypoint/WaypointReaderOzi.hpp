@@ -36,9 +36,13 @@ public:
 
   static bool VerifyFormat(TLineReader &reader);
 
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderOzi(*this);
+  }
+
 protected:
   bool ParseLine(const TCHAR* line, const unsigned linenum,
-                 Waypoints &way_points);
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
@@ -23,7 +23,8 @@ Copyright_License {
 
 #include "WaypointReaderSeeYou.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
+#include "Util/StringUtil.hpp"
 #include "Util/Macros.hpp"
 
 #include <stdlib.h>
@@ -160,7 +161,7 @@ ParseStyle(const TCHAR* src, Waypoint::Type &type)
 
 bool
 WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
-                              Waypoints &waypoints)
+                              std::vector<Waypoint> &waypoints)
 {
   enum {
     iName = 0,
@@ -281,6 +282,6 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
     new_waypoint.comment = params[iDescription];
   }
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.push_back(std::move(new_waypoint));
   return true;
 }
@@ -35,7 +35,11 @@ class WaypointReaderSeeYou:
 public:
   WaypointReaderSeeYou(const int _file_num,
                      bool _compressed = false)
-    :WaypointReaderBase(_file_num, _compressed) {}
+    :WaypointReaderBase(_file_num, _compressed), ignore_following(false) {}
+
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderSeeYou(*this);
+  }
 
 protected:
   /**
@@ -44,7 +48,11 @@ protected:
    * @see http://data.naviter.si/docs/cup_format.pdf
    */
   bool ParseLine(const TCHAR* line, const unsigned linenum,
-                 Waypoints &way_points);
+                 std::vector<Waypoint> &way_points) override;
+
+  bool IsEndOfWaypoints() const override {
+    return ignore_following;
+  }
 };
 
 #endif
@@ -23,7 +23,7 @@ Copyright_License {
 
 #include "WaypointReaderWinPilot.hpp"
 #include "Units/System.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 #include "Util/NumberParser.hpp"
 #include "Util/Macros.hpp"
 
@@ -187,12 +187,11 @@ ParseFlags(const TCHAR* src, Waypoint &dest)
 
 bool
 WaypointReaderWinPilot::ParseLine(const TCHAR* line, const unsigned linenum,
-                                Waypoints &waypoints)
+                                std::vector<Waypoint> &waypoints)
 {
   TCHAR ctemp[4096];
   const TCHAR *params[20];
   static constexpr unsigned int max_params = ARRAY_SIZE(params);
-  static bool welt2000_format = false;
   size_t n_params;
 
   if (linenum == 0)
@@ -256,6 +255,6 @@ WaypointReaderWinPilot::ParseLine(const TCHAR* line, const unsigned linenum,
   // Waypoint Flags (e.g. AT)
   ParseFlags(params[4], new_waypoint);
 
-  waypoints.Append(std::move(new_waypoint));
+  waypoints.push_back(std::move(new_waypoint));
   return true;
 }
@@ -33,14 +33,23 @@ Copyright_License {
 class WaypointReaderWinPilot: 
   public WaypointReaderBase 
 {
+  /**
+   * Was the file written by WELT2000?  Determined by the first line.
+   */
+  bool welt2000_format;
+
 public:
   WaypointReaderWinPilot(const int _file_num,
                        bool _compressed = false)
-    :WaypointReaderBase(_file_num, _compressed) {}
+    :WaypointReaderBase(_file_num, _compressed), welt2000_format(false) {}
+
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderWinPilot(*this);
+  }
 
 protected:
   bool ParseLine(const TCHAR* line, const unsigned linenum,
-                 Waypoints &way_points);
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
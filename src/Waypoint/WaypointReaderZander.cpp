@@ -22,7 +22,7 @@ Copyright_License {
 */
 
 #include "WaypointReaderZander.hpp"
-#include "Waypoint/Waypoints.hpp"
+#include "Waypoint/Waypoint.hpp"
 
 #include <stdlib.h>
 
@@ -148,7 +148,7 @@ ParseFlagsFromDescription(const TCHAR* src, Waypoint &dest)
 
 bool
 WaypointReaderZander::ParseLine(const TCHAR* line, const unsigned linenum,
-                              Waypoints &way_points)
+                              std::vector<Waypoint> &way_points)
 {
   // If (end-of-file or comment)
   if (line[0] == '\0' ||
@@ -198,6 +198,6 @@ WaypointReaderZander::ParseLine(const TCHAR* line, const unsigned linenum,
     if (len < 36 || !ParseFlagsFromDescription(line + 35, new_waypoint))
       new_waypoint.flags.turn_point = true;
 
-  way_points.Append(std::move(new_waypoint));
+  way_points.push_back(std::move(new_waypoint));
   return true;
 }
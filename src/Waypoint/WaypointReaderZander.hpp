@@ -34,9 +34,13 @@ public:
                      bool _compressed = false)
     :WaypointReaderBase(_file_num, _compressed) {}
 
+  WaypointReaderBase *Clone() const override {
+    return new WaypointReaderZander(*this);
+  }
+
 protected:
   bool ParseLine(const TCHAR* line, const unsigned linenum,
-                 Waypoints &way_points);
+                 std::vector<Waypoint> &way_points) override;
 };
 
 #endif
@@ -70,6 +70,7 @@ static const char *const Usage = "\n"
   "  -fly            bypass startup-screen, use fly mode directly\n"
 #endif
   "  -profile=fname  load profile from file fname\n"
+  "  -timing         measure rendering and calculation times\n"
 #if !defined(_WIN32_WCE)
   "  -WIDTHxHEIGHT   use screen resolution WIDTH x HEIGHT\n"
   "  -portrait       use a 480x640 screen resolution\n"
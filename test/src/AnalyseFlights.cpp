@@ -0,0 +1,196 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Analyse many IGC files in parallel and write the results as one
+ * JSON array to stdout, one object per flight (in the order they are
+ * finished).  Each worker thread owns a #FlightAnalyser which is
+ * reused for all flights it processes.
+ */
+
+#include "FlightAnalyser.hpp"
+#include "DebugReplayIGC.hpp"
+#include "OS/Args.hpp"
+#include "OS/CPU.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "IO/TextWriter.hpp"
+#include "JSON/Writer.hpp"
+#include "Util/StringUtil.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * The state shared by all #AnalyseThread instances.
+ */
+struct Batch {
+  const std::vector<const char *> &files;
+
+  /**
+   * The index of the next file to be analysed.  Each worker takes
+   * the next file as soon as it is done with the previous one, which
+   * balances the load even if the flights vary in length.
+   */
+  std::atomic<unsigned> next;
+
+  /**
+   * Protects #writer, #array and #n_failed.
+   */
+  Mutex mutex;
+
+  TextWriter &writer;
+  JSON::ArrayWriter &array;
+
+  unsigned n_failed;
+
+  Batch(const std::vector<const char *> &_files,
+        TextWriter &_writer, JSON::ArrayWriter &_array)
+    :files(_files), next(0), writer(_writer), array(_array), n_failed(0) {}
+};
+
+static void
+WriteFlight(TextWriter &writer, const char *path,
+            const FlightAnalyser *analyser)
+{
+  JSON::ObjectWriter object(writer);
+
+  object.WriteElement("file", JSON::WriteString, path);
+  analyser->Write(object);
+}
+
+class AnalyseThread final : public Thread {
+  Batch &batch;
+
+  FlightAnalyser analyser;
+
+public:
+  AnalyseThread(Batch &_batch, const FlightAnalyserSettings &settings)
+    :Thread("AnalyseFlight"), batch(_batch), analyser(settings) {}
+
+protected:
+  void Run() override {
+    unsigned i;
+    while ((i = batch.next++) < batch.files.size()) {
+      const char *path = batch.files[i];
+
+      DebugReplay *replay = DebugReplayIGC::Create(path);
+      if (replay == nullptr) {
+        const ScopeLock protect(batch.mutex);
+        ++batch.n_failed;
+        continue;
+      }
+
+      analyser.Analyse(*replay);
+      delete replay;
+
+      const ScopeLock protect(batch.mutex);
+      batch.array.WriteElement(WriteFlight, path, &analyser);
+      batch.writer.Flush();
+    }
+  }
+};
+
+static unsigned
+ParseUnsignedOption(Args &args, const char *value)
+{
+  char *endptr;
+  unsigned result = strtoul(value, &endptr, 10);
+  if (endptr == value || *endptr != '\0' || result == 0)
+    args.UsageError();
+
+  return result;
+}
+
+int main(int argc, char **argv)
+{
+  FlightAnalyserSettings settings;
+  unsigned n_threads = GetProcessorCount();
+
+  Args args(argc, argv,
+            "[options] FILE.igc ...\n"
+            "Options:\n"
+            "  --threads=N              Number of worker threads (default = number of CPUs)\n"
+            "  --full-points=512        Maximum number of full trace points (default = 512)\n"
+            "  --triangle-points=1024   Maximum number of triangle trace points (default = 1024)\n"
+            "  --sprint-points=64       Maximum number of sprint trace points (default = 64)");
+
+  const char *arg;
+  while ((arg = args.PeekNext()) != nullptr && *arg == '-') {
+    args.Skip();
+
+    const char *value;
+    if ((value = StringAfterPrefix(arg, "--threads=")) != nullptr)
+      n_threads = ParseUnsignedOption(args, value);
+    else if ((value = StringAfterPrefix(arg, "--full-points=")) != nullptr)
+      settings.full_max_points = ParseUnsignedOption(args, value);
+    else if ((value = StringAfterPrefix(arg, "--triangle-points=")) != nullptr)
+      settings.triangle_max_points = ParseUnsignedOption(args, value);
+    else if ((value = StringAfterPrefix(arg, "--sprint-points=")) != nullptr)
+      settings.sprint_max_points = ParseUnsignedOption(args, value);
+    else
+      args.UsageError();
+  }
+
+  std::vector<const char *> files;
+  do {
+    files.push_back(args.ExpectNext());
+  } while (!args.IsEmpty());
+
+  if (n_threads > files.size())
+    n_threads = files.size();
+
+  TextWriter writer("/dev/stdout", true);
+  unsigned n_failed;
+
+  {
+    JSON::ArrayWriter array(writer);
+    Batch batch(files, writer, array);
+
+    std::vector<std::unique_ptr<AnalyseThread>> threads;
+    for (unsigned i = 0; i < n_threads; ++i) {
+      threads.emplace_back(new AnalyseThread(batch, settings));
+      if (!threads.back()->Start()) {
+        threads.pop_back();
+        break;
+      }
+    }
+
+    if (threads.empty()) {
+      fputs("Failed to start the worker threads\n", stderr);
+      return EXIT_FAILURE;
+    }
+
+    for (auto &thread : threads)
+      thread->Join();
+
+    n_failed = batch.n_failed;
+  }
+
+  writer.NewLine();
+
+  return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Analyse a "timing.txt" file written by XCSoar's "-timing" option,
+ * and print statistics for each stage.
+ */
+
+#include "IO/FileLineReader.hpp"
+#include "OS/Args.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct StageData {
+  std::string channel, name;
+  std::vector<unsigned> durations;
+  unsigned long long total;
+
+  StageData(const char *_channel, const char *_name)
+    :channel(_channel), name(_name), total(0) {}
+
+  bool IsRoot() const {
+    return name == channel;
+  }
+
+  unsigned GetPercentile(unsigned p) const {
+    return durations[((durations.size() - 1) * p + 50) / 100];
+  }
+};
+
+static StageData &
+FindStage(std::vector<StageData> &stages,
+          const char *channel, const char *name)
+{
+  for (auto &stage : stages)
+    if (stage.channel == channel && stage.name == name)
+      return stage;
+
+  stages.emplace_back(channel, name);
+  return stages.back();
+}
+
+static const StageData *
+FindRoot(const std::vector<StageData> &stages, const std::string &channel)
+{
+  for (const auto &stage : stages)
+    if (stage.channel == channel && stage.IsRoot())
+      return &stage;
+
+  return nullptr;
+}
+
+static double
+ToMS(unsigned long long us)
+{
+  return us / 1000.;
+}
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "FILE");
+  const char *path = args.ExpectNext();
+  args.ExpectEnd();
+
+  FileLineReaderA reader(path);
+  if (reader.error()) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<StageData> stages;
+
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    char channel[64], name[64];
+    unsigned long start, duration;
+    if (sscanf(line, "%63s %63s %lu %lu",
+               channel, name, &start, &duration) != 4) {
+      fprintf(stderr, "Malformed line: %s\n", line);
+      continue;
+    }
+
+    StageData &stage = FindStage(stages, channel, name);
+    stage.durations.push_back(duration);
+    stage.total += duration;
+  }
+
+  printf("%-12s %-18s %7s %9s %9s %9s %9s %9s\n",
+         "channel", "stage", "count", "per root", "mean", "p50", "p95", "max");
+
+  for (auto &stage : stages) {
+    std::sort(stage.durations.begin(), stage.durations.end());
+
+    /* the average time per frame (or per calculation cycle) */
+    const StageData *root = FindRoot(stages, stage.channel);
+    const double per_root = root != nullptr
+      ? ToMS(stage.total) / root->durations.size()
+      : 0;
+
+    printf("%-12s %-18s %7u %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+           stage.channel.c_str(), stage.name.c_str(),
+           (unsigned)stage.durations.size(), per_root,
+           ToMS(stage.total) / stage.durations.size(),
+           ToMS(stage.GetPercentile(50)), ToMS(stage.GetPercentile(95)),
+           ToMS(stage.durations.back()));
+  }
+
+  return EXIT_SUCCESS;
+}
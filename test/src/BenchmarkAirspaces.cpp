@@ -0,0 +1,127 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Runs typical airspace warning, nearest and route queries on a
+ * country-sized airspace database.
+ */
+
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "Engine/Airspace/AirspaceVisitor.hpp"
+#include "Engine/Airspace/AirspaceIntersectionVisitor.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static GeoPoint
+RandomLocation()
+{
+  /* roughly the size of Germany */
+  return GeoPoint(Angle::Degrees(fixed(5 + (rand() % 10000) / 1000.)),
+                  Angle::Degrees(fixed(47 + (rand() % 8000) / 1000.)));
+}
+
+static void
+FillAirspaces(Airspaces &airspaces, unsigned n)
+{
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoPoint center = RandomLocation();
+
+    AbstractAirspace *as;
+    if (rand() % 4 != 0) {
+      as = new AirspaceCircle(center, fixed(2000 + rand() % 18000));
+    } else {
+      std::vector<GeoPoint> points;
+      const unsigned n_points = 5 + rand() % 10;
+      for (unsigned j = 0; j < n_points; ++j)
+        points.push_back(center +
+                         GeoPoint(Angle::Degrees(fixed((rand() % 200) / 1000.)),
+                                  Angle::Degrees(fixed((rand() % 200) / 1000.))));
+
+      as = new AirspacePolygon(points, true);
+    }
+
+    AirspaceAltitude base, top;
+    base.altitude = fixed(rand() % 3000);
+    top.altitude = base.altitude + fixed(rand() % 3000);
+    as->SetProperties(_T("Test"), AirspaceClass(rand() % AIRSPACECLASSCOUNT),
+                      base, top);
+    airspaces.Add(as);
+  }
+
+  airspaces.Optimise();
+}
+
+class CountVisitor final : public AirspaceIntersectionVisitor {
+public:
+  unsigned n;
+
+  CountVisitor():n(0) {}
+
+  void Visit(const AbstractAirspace &as) override {
+    ++n;
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+  const unsigned n_airspaces = argc > 1 ? atoi(argv[1]) : 10000;
+  const unsigned n_queries = argc > 2 ? atoi(argv[2]) : 100000;
+
+  srand(42);
+
+  Airspaces airspaces;
+  FillAirspaces(airspaces, n_airspaces);
+
+  unsigned n_inside = 0, n_nearest = 0;
+  CountVisitor range_visitor, intersect_visitor;
+
+  for (unsigned i = 0; i < n_queries; ++i) {
+    AircraftState state;
+    state.location = RandomLocation();
+    state.altitude = fixed(1000);
+
+    n_inside += airspaces.FindInside(state).size();
+
+    airspaces.VisitWithinRange(state.location, fixed(20000), range_visitor);
+
+    const GeoPoint end = state.location +
+      GeoPoint(Angle::Degrees(fixed(0.1)), Angle::Degrees(fixed(0.05)));
+    airspaces.VisitIntersecting(state.location, end, intersect_visitor);
+
+    if (airspaces.FindNearest(state.location) != nullptr)
+      ++n_nearest;
+  }
+
+  printf("inside=%u range=%u intersecting=%u nearest=%u\n",
+         n_inside, range_visitor.n, intersect_visitor.n, n_nearest);
+  return 0;
+}
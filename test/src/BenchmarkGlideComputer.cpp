@@ -0,0 +1,291 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Replays IGC/NMEA files through the complete GlideComputer, with
+ * the default task, waypoints, airspace and terrain configured in the
+ * profile, as fast as possible.  Route planning, reach and contest
+ * optimisation are enabled regardless of the profile.
+ *
+ * Prints the 50th and 99th percentile of the time spent per fix in
+ * each computer (see Profiler::Stage) and the overall throughput.
+ */
+
+#define ENABLE_CMDLINE
+#define ENABLE_PROFILE
+#define USAGE "[DRIVER] FILE ..."
+
+#include "Main.hpp"
+#include "Profiler/Profiler.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Waypoint/WaypointGlue.hpp"
+#include "Airspace/AirspaceGlue.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/Ordered/OrderedTask.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Computer/Settings.hpp"
+#include "Atmosphere/Pressure.hpp"
+#include "DebugReplay.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Clock.hpp"
+#include "Util/Macros.hpp"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include <stdio.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+static std::list<DebugReplay *> replays;
+
+static RasterTerrain *terrain;
+
+/**
+ * The stages which are reported, in this order.
+ */
+static constexpr Profiler::Stage stages[] = {
+  Profiler::Stage::CALCULATION,
+  Profiler::Stage::CALCULATION_GPS,
+  Profiler::Stage::CALCULATION_IDLE,
+  Profiler::Stage::CALCULATION_AIR_DATA,
+  Profiler::Stage::CALCULATION_TRACE,
+  Profiler::Stage::CALCULATION_TASK,
+  Profiler::Stage::CALCULATION_ROUTE,
+  Profiler::Stage::CALCULATION_CONTEST,
+  Profiler::Stage::CALCULATION_WARNING,
+  Profiler::Stage::CALCULATION_LOG,
+};
+
+/**
+ * The duration [us] of each stage, one element per fix.
+ */
+static std::vector<uint32_t> durations[Profiler::N_STAGES];
+
+static void
+ParseCommandLine(Args &args)
+{
+  do {
+    DebugReplay *replay = CreateDebugReplay(args);
+    if (replay == nullptr)
+      exit(EXIT_FAILURE);
+
+    replays.push_back(replay);
+  } while (!args.IsEmpty());
+}
+
+static void
+LoadFiles(Waypoints &way_points, Airspaces &airspace_database)
+{
+  NullOperationEnvironment operation;
+
+  terrain = RasterTerrain::OpenTerrain(NULL, operation);
+
+  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+  way_points.Optimise();
+
+  ReadAirspace(airspace_database, terrain, AtmosphericPressure::Standard(),
+               NULL, operation);
+}
+
+/**
+ * Collect the samples which were recorded since the specified time
+ * and add up their durations per stage.
+ */
+static void
+CollectSamples(uint64_t since)
+{
+  Profiler::Sample samples[256];
+  const unsigned n = Profiler::Copy(Profiler::Channel::CALCULATION,
+                                    samples, ARRAY_SIZE(samples));
+
+  uint32_t totals[Profiler::N_STAGES];
+  std::fill_n(totals, Profiler::N_STAGES, 0);
+
+  for (unsigned i = 0; i < n; ++i)
+    if (samples[i].start >= since)
+      totals[unsigned(samples[i].stage)] += samples[i].duration;
+
+  for (auto stage : stages)
+    durations[unsigned(stage)].push_back(totals[unsigned(stage)]);
+}
+
+/**
+ * Feed all fixes of the replay into the #GlideComputer, the way the
+ * #CalculationThread does at 1 Hz: ProcessIdle() after each fix.
+ *
+ * @return the number of fixes
+ */
+static unsigned
+Replay(DebugReplay &replay, GlideComputer &glide_computer)
+{
+  unsigned n_fixes = 0;
+
+  while (replay.Next()) {
+    const uint64_t start = MonotonicClockUS();
+
+    {
+      const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION);
+
+      glide_computer.ReadBlackboard(replay.Basic());
+
+      {
+        const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_GPS);
+        glide_computer.ProcessGPS();
+      }
+
+      {
+        const Profiler::ScopeTimer timer(Profiler::Stage::CALCULATION_IDLE);
+        glide_computer.ProcessIdle();
+      }
+    }
+
+    CollectSamples(start);
+    ++n_fixes;
+  }
+
+  return n_fixes;
+}
+
+static uint32_t
+Percentile(std::vector<uint32_t> v, unsigned percent)
+{
+  if (v.empty())
+    return 0;
+
+  auto i = v.begin() + (v.size() - 1) * percent / 100;
+  std::nth_element(v.begin(), i, v.end());
+  return *i;
+}
+
+static void
+PrintResults(unsigned n_fixes, uint64_t duration_us)
+{
+  printf("%-12s %10s %10s %12s\n", "stage", "p50 [us]", "p99 [us]",
+         "total [ms]");
+
+  for (auto stage : stages) {
+    const auto &v = durations[unsigned(stage)];
+
+    uint64_t total = 0;
+    for (auto i : v)
+      total += i;
+
+    _tprintf(_T("%-12s %10u %10u %12lu\n"), Profiler::GetName(stage),
+             (unsigned)Percentile(v, 50), (unsigned)Percentile(v, 99),
+             (unsigned long)(total / 1000));
+  }
+
+  uint64_t calculation_us = 0;
+  for (auto i : durations[unsigned(Profiler::Stage::CALCULATION)])
+    calculation_us += i;
+
+  /* the total duration includes parsing the replay files */
+  printf("%u fixes in %lu ms: %lu fixes/s, %lu fixes/s without parsing\n",
+         n_fixes, (unsigned long)(duration_us / 1000),
+         (unsigned long)(n_fixes * UINT64_C(1000000) /
+                         std::max<uint64_t>(duration_us, 1)),
+         (unsigned long)(n_fixes * UINT64_C(1000000) /
+                         std::max<uint64_t>(calculation_us, 1)));
+}
+
+static void
+Main()
+{
+  ComputerSettings settings;
+  settings.SetDefaults();
+  settings.polar.glide_polar_task = GlidePolar(fixed(1));
+  settings.task.route_planner.mode = RoutePlannerConfig::Mode::BOTH;
+  settings.task.route_planner.reach_calc_mode =
+    RoutePlannerConfig::ReachMode::TURNING;
+  settings.contest.enable = true;
+
+  Waypoints way_points;
+  Airspaces airspace_database;
+  LoadFiles(way_points, airspace_database);
+
+  TaskManager task_manager(settings.task, way_points);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  OrderedTask *task =
+    protected_task_manager.TaskCreateDefault(&way_points,
+                                             settings.task.task_type_default);
+  if (task != nullptr) {
+    protected_task_manager.TaskCommit(*task);
+    delete task;
+  }
+
+  GlideComputer glide_computer(way_points, airspace_database,
+                               protected_task_manager,
+                               task_events);
+  glide_computer.ReadComputerSettings(settings);
+  glide_computer.SetTerrain(terrain);
+  glide_computer.SetContestIncremental(true);
+
+  Profiler::Enable();
+
+  unsigned n_fixes = 0;
+  const uint64_t start = MonotonicClockUS();
+
+  for (DebugReplay *replay : replays) {
+    glide_computer.Initialise();
+    n_fixes += Replay(*replay, glide_computer);
+    delete replay;
+  }
+
+  const uint64_t duration = MonotonicClockUS() - start;
+
+  Profiler::Disable();
+
+  PrintResults(n_fixes, duration);
+
+  delete terrain;
+}
@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures the slope shading kernel of RasterRenderer on a synthetic
+ * height matrix, comparing the optimised (SIMD) implementation with
+ * the portable one.
+ */
+
+#include "Terrain/SlopeShading.hpp"
+#include "OS/Clock.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Util/Macros.hpp"
+
+#include <stdio.h>
+#include <math.h>
+
+typedef void (*SlopeShadingFunction)(const short *src,
+                                     const short *above,
+                                     const short *below,
+                                     unsigned n, unsigned column_distance,
+                                     unsigned row_sum, unsigned dd2,
+                                     const SlopeShadingParameters &params,
+                                     signed char *dest);
+
+static void
+GenerateTerrain(short *p, unsigned width, unsigned height)
+{
+  for (unsigned y = 0; y < height; ++y)
+    for (unsigned x = 0; x < width; ++x)
+      *p++ = short(800 + 600 * sin(x * 0.031) * cos(y * 0.023) +
+                   150 * sin(x * 0.17 + y * 0.11));
+}
+
+/**
+ * @return the duration of one frame in microseconds
+ */
+static unsigned
+Run(SlopeShadingFunction f, const short *heights,
+    unsigned width, unsigned height, unsigned q, unsigned n_frames)
+{
+  const SlopeShadingParameters params = { -120, -120, 180, 64 };
+  AllocatedArray<signed char> row(width);
+
+  int checksum = 0;
+
+  const uint64_t start = MonotonicClockUS();
+
+  for (unsigned frame = 0; frame < n_frames; ++frame) {
+    for (unsigned y = q; y < height - q; ++y) {
+      const short *src = heights + y * width + q;
+      f(src, src - q * width, src + q * width, width - 2 * q,
+        q, 2 * q, 2 * q * 2 * q * 100, params, row.begin());
+      checksum += row[frame % (width - 2 * q)];
+    }
+  }
+
+  const uint64_t duration = MonotonicClockUS() - start;
+
+  /* prevent gcc from optimizing the loop away */
+  if (checksum == 0x7fffffff)
+    printf("\n");
+
+  return duration / n_frames;
+}
+
+int main(int argc, char **argv)
+{
+  static constexpr struct {
+    unsigned width, height;
+  } sizes[] = {
+    { 800, 480 },
+    { 1280, 800 },
+  };
+
+  static constexpr unsigned N_FRAMES = 50;
+
+  for (unsigned i = 0; i < ARRAY_SIZE(sizes); ++i) {
+    const unsigned width = sizes[i].width, height = sizes[i].height;
+
+    AllocatedArray<short> heights(width * height);
+    GenerateTerrain(heights.begin(), width, height);
+
+    for (unsigned q : { 1, 2 }) {
+      const unsigned portable = Run(SlopeShadingRowPortable, heights.begin(),
+                                    width, height, q, N_FRAMES);
+      const unsigned optimised = Run(SlopeShadingRow, heights.begin(),
+                                     width, height, q, N_FRAMES);
+
+      printf("%ux%u q=%u: portable %u.%03u ms/frame, optimised %u.%03u ms/frame\n",
+             width, height, q,
+             portable / 1000, portable % 1000,
+             optimised / 1000, optimised % 1000);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program converts the terrain of a map file to the uncompressed
+ * format which can be mapped into memory by
+ * RasterTileCache::LoadRaw().
+ */
+
+#include "Terrain/RasterTileCache.hpp"
+#include "OS/Args.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "Compatibility/path.h"
+#include "Operation/Operation.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <tchar.h>
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "PATH OUTPUT");
+  const char *map_path = args.ExpectNext();
+  const char *output_path = args.ExpectNext();
+  args.ExpectEnd();
+
+  char jp2_path[4096];
+  strcpy(jp2_path, map_path);
+  strcat(jp2_path, DIR_SEPARATOR_S "terrain.jp2");
+
+  TCHAR j2w_path[4096];
+  _tcscpy(j2w_path, PathName(map_path));
+  _tcscat(j2w_path, _T(DIR_SEPARATOR_S) _T("terrain.j2w"));
+
+  NullOperationEnvironment operation;
+  RasterTileCache rtc;
+  if (!rtc.LoadOverview(jp2_path, j2w_path, operation)) {
+    fprintf(stderr, "LoadOverview failed\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE *file = fopen(output_path, "wb");
+  if (file == NULL) {
+    perror("Failed to create output file");
+    return EXIT_FAILURE;
+  }
+
+  bool success = rtc.SaveRaw(file, jp2_path);
+  success = fclose(file) == 0 && success;
+  if (!success) {
+    fprintf(stderr, "SaveRaw failed\n");
+    remove(output_path);
+    return EXIT_FAILURE;
+  }
+
+  /* verify the new file */
+  RasterTileCache raw;
+  if (!raw.LoadRaw(PathName(output_path))) {
+    fprintf(stderr, "LoadRaw failed\n");
+    return EXIT_FAILURE;
+  }
+
+  GeoBounds bounds = raw.GetBounds();
+  printf("bounds = %f|%f - %f|%f\n",
+         (double)bounds.GetWest().Degrees(),
+         (double)bounds.GetNorth().Degrees(),
+         (double)bounds.GetEast().Degrees(),
+         (double)bounds.GetSouth().Degrees());
+
+  return EXIT_SUCCESS;
+}
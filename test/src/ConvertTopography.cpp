@@ -0,0 +1,102 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program converts the topography of a map file to the
+ * preconverted format which can be mapped into memory by
+ * TopographyCache::Load().
+ */
+
+#include "Topography/TopographyStore.hpp"
+#include "Topography/TopographyFile.hpp"
+#include "Topography/TopographyCache.hpp"
+#include "OS/Args.hpp"
+#include "OS/ConvertPathName.hpp"
+#include "IO/ZipLineReader.hpp"
+#include "Operation/Operation.hpp"
+
+#include <zzip/zzip.h>
+
+#include <stdio.h>
+#include <tchar.h>
+
+int main(int argc, char **argv)
+{
+  Args args(argc, argv, "PATH OUTPUT");
+  const char *map_path = args.ExpectNext();
+  const char *output_path = args.ExpectNext();
+  args.ExpectEnd();
+
+  ZZIP_DIR *dir = zzip_dir_open(map_path, NULL);
+  if (dir == NULL) {
+    fprintf(stderr, "Failed to open %s\n", map_path);
+    return EXIT_FAILURE;
+  }
+
+  NullOperationEnvironment operation;
+  TopographyStore topography;
+
+  {
+    ZipLineReaderA reader(dir, "topology.tpl");
+    if (reader.error()) {
+      fprintf(stderr, "Failed to open %s\n", map_path);
+      return EXIT_FAILURE;
+    }
+
+    topography.Load(operation, reader, NULL, dir);
+  }
+
+  zzip_dir_close(dir);
+
+  topography.LoadAll();
+
+  FILE *file = fopen(output_path, "wb");
+  if (file == NULL) {
+    perror("Failed to create output file");
+    return EXIT_FAILURE;
+  }
+
+  bool success = TopographyCache::Save(file, topography);
+  success = fclose(file) == 0 && success;
+  if (!success) {
+    fprintf(stderr, "Save failed\n");
+    remove(output_path);
+    return EXIT_FAILURE;
+  }
+
+  /* verify the new file */
+  TopographyCache cache;
+  if (!cache.Load(PathName(output_path))) {
+    fprintf(stderr, "Load failed\n");
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned i = 0; i < topography.size(); ++i) {
+    const TopographyFile &src = topography[i];
+    const TopographyCache::File cached = cache.Find(src.GetName());
+    printf("%s: %u shapes\n", src.GetName(),
+           cached.IsDefined() ? cached.GetShapeCount() : 0);
+  }
+
+  return EXIT_SUCCESS;
+}
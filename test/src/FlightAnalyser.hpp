@@ -0,0 +1,94 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+#ifndef XCSOAR_FLIGHT_ANALYSER_HPP
+#define XCSOAR_FLIGHT_ANALYSER_HPP
+
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Contest/ContestStatistics.hpp"
+#include "Computer/CirclingComputer.hpp"
+#include "Time/BrokenDateTime.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "FlightPhaseDetector.hpp"
+
+class DebugReplay;
+class TextWriter;
+
+namespace JSON {
+  class ObjectWriter;
+}
+
+struct FlightAnalyserSettings {
+  unsigned full_max_points, triangle_max_points, sprint_max_points;
+
+  FlightAnalyserSettings()
+    :full_max_points(512),
+     triangle_max_points(1024),
+     sprint_max_points(64) {}
+};
+
+/**
+ * Determines takeoff, release and landing, the flight phases and the
+ * OLC/DMSt scores of one flight.  An instance may be reused for
+ * several flights (one after another); the trace buffers are kept,
+ * so memory is allocated only for the first flight.
+ */
+class FlightAnalyser {
+public:
+  struct Events {
+    BrokenDateTime takeoff_time, release_time, landing_time;
+    GeoPoint takeoff_location, release_location, landing_location;
+
+    void Clear();
+  };
+
+private:
+  Trace full_trace, triangle_trace, sprint_trace;
+
+  CirclingComputer circling_computer;
+  FlightPhaseDetector flight_phase_detector;
+
+  Events events;
+
+  ContestStatistics olc_plus, dmst;
+
+public:
+  explicit FlightAnalyser(const FlightAnalyserSettings &settings);
+
+  /**
+   * Analyse the flight read from the specified replay, replacing the
+   * results of the previous flight.
+   */
+  void Analyse(DebugReplay &replay);
+
+  /**
+   * Write the results as JSON attributes ("events", "phases",
+   * "performance" and "contests").
+   */
+  void Write(JSON::ObjectWriter &object) const;
+
+private:
+  void Run(DebugReplay &replay);
+  void UpdateEvents(const MoreData &basic, const FlyingState &state);
+  void FinishEvents(const MoreData &basic);
+};
+
+#endif
@@ -126,10 +126,20 @@ Phase::GetGlideRate() const {
 }
 
 FlightPhaseDetector::FlightPhaseDetector() 
+{
+  Reset();
+}
+
+void
+FlightPhaseDetector::Reset()
 {
   previous_phase.Clear();
   current_phase.Clear();
   phase_count = 0;
+  last_turn_mode = CirclingMode::CRUISE;
+
+  phases.clear();
+  totals = PhaseTotals();
 }
 
 void
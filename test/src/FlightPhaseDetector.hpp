@@ -155,6 +155,11 @@ class FlightPhaseDetector {
   public:
     FlightPhaseDetector();
 
+    /**
+     * Forget all phases, to prepare for analysing another flight.
+     */
+    void Reset();
+
     /**
      * Split track to circling/cruise phases and calculate basic statistics for
      * each.
@@ -109,7 +109,7 @@ LoadFiles(Airspaces &airspace_database)
   terrain = RasterTerrain::OpenTerrain(NULL, operation);
 
   const AtmosphericPressure pressure = AtmosphericPressure::Standard();
-  ReadAirspace(airspace_database, terrain, pressure, operation);
+  ReadAirspace(airspace_database, terrain, pressure, NULL, operation);
 }
 
 static void
@@ -51,7 +51,7 @@ int main(int argc, char **argv)
   _tcscat(j2w_path, _T(DIR_SEPARATOR_S) _T("terrain.j2w"));
 
   NullOperationEnvironment operation;
-  RasterMap map(jp2_path, j2w_path, NULL, operation);
+  RasterMap map(jp2_path, j2w_path, NULL, NULL, operation);
   if (!map.IsDefined()) {
     fprintf(stderr, "failed to load map\n");
     return EXIT_FAILURE;
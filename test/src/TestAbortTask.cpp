@@ -0,0 +1,139 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Task/Unordered/AbortTask.hpp"
+#include "Engine/Task/TaskBehaviour.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned N_TRIALS = 300;
+
+static fixed
+RandomFixed(fixed min, fixed max)
+{
+  return min + (max - min) * (rand() % 10001) / 10000;
+}
+
+static GeoPoint
+RandomLocation()
+{
+  return GeoPoint(Angle::Degrees(RandomFixed(fixed(6.5), fixed(8.5))),
+                  Angle::Degrees(RandomFixed(fixed(50.8), fixed(52.2))));
+}
+
+static void
+RandomWaypoints(Waypoints &waypoints)
+{
+  waypoints.Clear();
+
+  static constexpr Waypoint::Type types[] = {
+    Waypoint::Type::AIRFIELD,
+    Waypoint::Type::OUTLANDING,
+    Waypoint::Type::OUTLANDING,
+    Waypoint::Type::NORMAL,
+  };
+
+  const unsigned n = 5 + rand() % 150;
+  for (unsigned i = 0; i < n; ++i) {
+    Waypoint wp = waypoints.Create(RandomLocation());
+    wp.type = types[rand() % ARRAY_SIZE(types)];
+    wp.elevation = RandomFixed(fixed(0), fixed(600));
+    waypoints.Append(std::move(wp));
+  }
+
+  waypoints.Optimise();
+}
+
+static bool
+Equals(const AbortTask &a, const AbortTask &b)
+{
+  if (a.TaskSize() != b.TaskSize() ||
+      a.HasReachableLandable() != b.HasReachableLandable())
+    return false;
+
+  for (unsigned i = 0; i < a.TaskSize(); ++i)
+    if (a.GetAlternate(i).GetWaypoint().id !=
+        b.GetAlternate(i).GetWaypoint().id)
+      return false;
+
+  return true;
+}
+
+/**
+ * Compare the alternates found with and without the early
+ * termination of AbortTask::FillReachable().
+ */
+static void
+TestPruning()
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  Waypoints waypoints;
+
+  unsigned n_alternates = 0;
+  for (unsigned i = 0; i < N_TRIALS; ++i) {
+    RandomWaypoints(waypoints);
+
+    GlidePolar glide_polar(RandomFixed(fixed(0), fixed(4)));
+    glide_polar.SetCruiseEfficiency(RandomFixed(fixed(0.8), fixed(1.2)));
+
+    AircraftState state;
+    state.Reset();
+    state.time = fixed(3600);
+    state.location = RandomLocation();
+    state.altitude = RandomFixed(fixed(200), fixed(3000));
+    state.wind = SpeedVector(Angle::Degrees(RandomFixed(fixed(0),
+                                                        fixed(360))),
+                             RandomFixed(fixed(0), fixed(25)));
+
+    AbortTask pruned(task_behaviour, waypoints);
+    pruned.Update(state, state, glide_polar);
+
+    AbortTask full(task_behaviour, waypoints);
+    full.SetPruning(false);
+    full.Update(state, state, glide_polar);
+
+    ok(Equals(pruned, full), "pruning, trial %u", i);
+    n_alternates += full.TaskSize();
+  }
+
+  /* make sure the test is meaningful */
+  ok1(n_alternates > N_TRIALS);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(N_TRIALS + 1);
+
+  srand(42);
+  TestPruning();
+
+  return exit_status();
+}
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/AirspaceCache.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/AirspaceCircle.hpp"
 #include "Engine/Airspace/AirspacePolygon.hpp"
@@ -32,8 +33,11 @@ Copyright_License {
 #include "Operation/Operation.hpp"
 #include "TestUtil.hpp"
 
+#include <vector>
+
 #include <tchar.h>
 #include <string.h>
+#include <stdio.h>
 
 struct AirspaceClassTestCouple
 {
@@ -274,12 +278,86 @@ TestTNP()
   }
 }
 
+static bool
+Equals(const AirspaceAltitude &a, const AirspaceAltitude &b)
+{
+  return a.reference == b.reference && a.altitude == b.altitude &&
+    a.flight_level == b.flight_level &&
+    a.altitude_above_terrain == b.altitude_above_terrain;
+}
+
+static bool
+Equals(const AbstractAirspace &a, const AbstractAirspace &b)
+{
+  if (a.GetShape() != b.GetShape() || a.GetType() != b.GetType() ||
+      _tcscmp(a.GetName(), b.GetName()) != 0 ||
+      a.GetRadioText() != b.GetRadioText() ||
+      !a.GetDays().equals(b.GetDays()) ||
+      !Equals(a.GetBase(), b.GetBase()) || !Equals(a.GetTop(), b.GetTop()))
+    return false;
+
+  if (a.GetShape() == AbstractAirspace::Shape::CIRCLE)
+    return ((const AirspaceCircle &)a).GetCenter() ==
+      ((const AirspaceCircle &)b).GetCenter() &&
+      ((const AirspaceCircle &)a).GetRadius() ==
+      ((const AirspaceCircle &)b).GetRadius();
+
+  const SearchPointVector &pa = a.GetPoints(), &pb = b.GetPoints();
+  if (pa.size() != pb.size())
+    return false;
+
+  for (unsigned i = 0; i < pa.size(); ++i)
+    if (pa[i].GetLocation() != pb[i].GetLocation())
+      return false;
+
+  return true;
+}
+
+static void
+TestCache()
+{
+  Airspaces airspaces;
+  if (!ParseFile(_T("test/data/airspace/openair.txt"), airspaces)) {
+    skip(6, 0, "Failed to parse input file");
+    return;
+  }
+
+  std::vector<const AbstractAirspace *> list;
+  for (const auto &i : airspaces)
+    list.push_back(&i.GetAirspace());
+
+  FILE *file = tmpfile();
+  ok1(SaveAirspaceCache(file, list));
+
+  std::vector<char> buffer(ftell(file));
+  rewind(file);
+  fread(buffer.data(), 1, buffer.size(), file);
+  fclose(file);
+
+  Airspaces loaded;
+  ok1(LoadAirspaceCache(loaded, buffer.data(), buffer.size()));
+
+  const auto &pending = loaded.GetPending();
+  ok1(pending.size() == list.size());
+
+  bool equal = pending.size() == list.size();
+  for (unsigned i = 0; equal && i < list.size(); ++i)
+    equal = Equals(*pending[i], *list[i]);
+  ok1(equal);
+
+  /* a truncated file must be rejected as a whole */
+  Airspaces truncated;
+  ok1(!LoadAirspaceCache(truncated, buffer.data(), buffer.size() - 1));
+  ok1(truncated.IsEmpty());
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(103);
+  plan_tests(111);
 
   TestOpenAir();
   TestTNP();
+  TestCache();
 
   return exit_status();
 }
@@ -0,0 +1,123 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "TestUtil.hpp"
+
+static TracePoint
+MakePoint(unsigned i, unsigned n_points)
+{
+  static const GeoPoint corners[] = {
+    GeoPoint(Angle::Degrees(fixed(7)), Angle::Degrees(fixed(51))),
+    GeoPoint(Angle::Degrees(fixed(7.6)), Angle::Degrees(fixed(51))),
+    GeoPoint(Angle::Degrees(fixed(7.3)), Angle::Degrees(fixed(51.35))),
+  };
+
+  /* a closed triangle flight with some zig-zag on each leg */
+  const unsigned leg = i * 3 / n_points;
+  const fixed t = fixed(i * 3 - leg * n_points) / n_points;
+
+  GeoPoint location = corners[leg].Interpolate(corners[(leg + 1) % 3], t);
+  location.latitude += Angle::Degrees(fixed((i % 7) * 0.002));
+
+  return TracePoint(location, 1000 + i * 4, fixed(1000), fixed(0), 0);
+}
+
+/**
+ * Solve the first #n_points points of the flight exhaustively.
+ */
+static fixed
+SolveExhaustive(Contest contest, unsigned index,
+                unsigned n_points, unsigned total_points)
+{
+  Trace trace(0, Trace::null_time, 1024);
+  for (unsigned i = 0; i < n_points; ++i)
+    trace.push_back(MakePoint(i, total_points));
+
+  ContestManager manager(contest, trace, trace, trace, true);
+  manager.SolveExhaustive();
+  return manager.GetStats().result[index].distance;
+}
+
+static void
+TestBound(Contest contest, unsigned index)
+{
+  static constexpr unsigned n_points = 600, chunk = 20;
+
+  Trace trace(0, Trace::null_time, 1024);
+  ContestManager manager(contest, trace, trace, trace, true);
+  manager.SetIncremental(true);
+
+  const ContestResult &result = manager.GetStats().result[index];
+
+  /* feed the flight in chunks like a live trace; the bound must
+     never be below the distance found so far, and while the search
+     is suspended, it must not be below the exhaustive solution
+     (allowing for the flat projection's error) */
+  bool below_distance = false, below_exhaustive = false;
+  unsigned suspended = 0;
+  for (unsigned i = 0; i < n_points; ++i) {
+    trace.push_back(MakePoint(i, n_points));
+
+    if (i % chunk == chunk - 1) {
+      manager.UpdateIdle();
+
+      if (result.distance_bound < result.distance)
+        below_distance = true;
+
+      if (result.distance_bound > result.distance) {
+        ++suspended;
+
+        if (SolveExhaustive(contest, index, i + 1, n_points) >
+            result.distance_bound * fixed(1.01))
+          below_exhaustive = true;
+      }
+    }
+  }
+
+  /* finish the search */
+  unsigned n = 0;
+  while (result.distance_bound > result.distance && n++ < 1000)
+    manager.UpdateIdle();
+
+  ok1(suspended > 0);
+  ok1(!below_distance);
+  ok1(!below_exhaustive);
+  ok1(n < 1000);
+  ok1(positive(result.distance));
+  ok1(equals(result.distance_bound, result.distance));
+
+  manager.Reset();
+  ok1(!positive(result.distance_bound));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  TestBound(Contest::OLC_FAI, 0);
+  TestBound(Contest::XCONTEST, 1);
+
+  return exit_status();
+}
@@ -0,0 +1,127 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/PathSolvers/Dijkstra.hpp"
+#include "TestUtil.hpp"
+
+#include <unordered_map>
+#include <algorithm>
+
+/* a grid of nodes; each node links to its right and lower neighbour */
+static constexpr unsigned WIDTH = 64, HEIGHT = 64;
+
+struct GridMap {
+  template<typename Value>
+  struct Bind : public std::unordered_map<unsigned, Value> {
+  };
+};
+
+typedef Dijkstra<unsigned, GridMap> GridDijkstra;
+
+static unsigned
+EdgeValue(unsigned node, bool down)
+{
+  return 1 + (node * 7 + down) % 10;
+}
+
+static void
+LinkNeighbours(GridDijkstra &dijkstra, unsigned node)
+{
+  const unsigned x = node % WIDTH, y = node / WIDTH;
+
+  if (x + 1 < WIDTH)
+    dijkstra.Link(node + 1, node, EdgeValue(node, false));
+  if (y + 1 < HEIGHT)
+    dijkstra.Link(node + WIDTH, node, EdgeValue(node, true));
+}
+
+/**
+ * Calculate the value of the path to the node by following its
+ * predecessors.
+ */
+static unsigned
+PathValue(const GridDijkstra &dijkstra, unsigned node)
+{
+  unsigned value = 0;
+  for (unsigned parent = dijkstra.GetPredecessor(node); parent != node;
+       node = parent, parent = dijkstra.GetPredecessor(node))
+    value += EdgeValue(parent, node == parent + WIDTH);
+  return value;
+}
+
+/**
+ * The edge map grows while the queue refers to its elements, which
+ * makes the hash map rehash several times during the search.  This
+ * used to invalidate the iterators stored in the queue (detected by
+ * _GLIBCXX_DEBUG).
+ */
+static void
+TestGrid()
+{
+  GridDijkstra dijkstra;
+  dijkstra.Clear();
+  dijkstra.Link(0, 0, 0);
+
+  const size_t initial_buckets = dijkstra.GetEdgeMap().bucket_count();
+
+  unsigned n_popped = 0;
+  while (!dijkstra.IsEmpty()) {
+    LinkNeighbours(dijkstra, dijkstra.Pop());
+    ++n_popped;
+  }
+
+  ok1(dijkstra.GetEdgeMap().size() == WIDTH * HEIGHT);
+  ok1(dijkstra.GetEdgeMap().bucket_count() > initial_buckets);
+  ok1(n_popped == WIDTH * HEIGHT);
+
+  /* compare with the minimum values, calculated row by row */
+  static unsigned best[WIDTH * HEIGHT];
+  bool optimal = true;
+  for (unsigned node = 0; node < WIDTH * HEIGHT; ++node) {
+    const unsigned x = node % WIDTH, y = node / WIDTH;
+
+    if (node == 0)
+      best[node] = 0;
+    else if (y == 0)
+      best[node] = best[node - 1] + EdgeValue(node - 1, false);
+    else if (x == 0)
+      best[node] = best[node - WIDTH] + EdgeValue(node - WIDTH, true);
+    else
+      best[node] = std::min(best[node - 1] + EdgeValue(node - 1, false),
+                            best[node - WIDTH] + EdgeValue(node - WIDTH, true));
+
+    if (PathValue(dijkstra, node) != best[node])
+      optimal = false;
+  }
+
+  ok1(optimal);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(4);
+
+  TestGrid();
+
+  return exit_status();
+}
@@ -24,11 +24,147 @@
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetRecord.hpp"
 #include "FLARM/FlarmId.hpp"
+#include "OS/FileMapping.hpp"
 #include "TestUtil.hpp"
 
+#include <stdio.h>
+
+static void
+TestPrefix(const FlarmNetDatabase &db)
+{
+  const FlarmNetRecord *array[8];
+  ok1(db.FindRecordsByCallSignPrefix(_T("T"), array, 8) == 2);
+  ok1(_tcscmp(array[0]->callsign, _T("TH")) == 0);
+  ok1(_tcscmp(array[1]->callsign, _T("TH")) == 0);
+
+  ok1(db.FindRecordsByCallSignPrefix(_T("TX"), array, 8) == 0);
+  ok1(db.FindRecordsByCallSignPrefix(_T("TH"), array, 1) == 1);
+
+  /* the empty prefix matches all records, ordered by callsign */
+  ok1(db.FindRecordsByCallSignPrefix(_T(""), array, 8) == 6);
+  ok1(_tcscmp(array[1]->callsign, _T("1A")) == 0);
+  ok1(_tcscmp(array[3]->callsign, _T("MF")) == 0);
+}
+
+static void
+TestImage(const FlarmNetDatabase &db)
+{
+  const char *path = "output/test/flarmnet.bin";
+
+  FILE *file = fopen(path, "wb");
+  ok1(file != NULL);
+  ok1(db.Save(file));
+  fclose(file);
+
+  FlarmNetDatabase image;
+  ok1(image.Load(new FileMapping(_T("output/test/flarmnet.bin")), 0));
+  ok1(image.GetCount() == 6);
+
+  const FlarmNetRecord *record =
+    image.FindRecordById(FlarmId::Parse("DDA85C", NULL));
+  ok1(record != NULL);
+  ok1(_tcscmp(record->registration, _T("D-4449")) == 0);
+  ok1(image.FindRecordById(FlarmId::Parse("DDA85B", NULL)) == NULL);
+
+  FlarmId ids[3];
+  ok1(image.FindIdsByCallSign(_T("TH"), ids, 3) == 2);
+  ok1(image.FindFirstRecordByCallSign(_T("L1")) != NULL);
+  ok1(image.FindFirstRecordByCallSign(_T("L2")) == NULL);
+
+  TestPrefix(image);
+
+  /* a misplaced image must be rejected */
+  ok1(!image.Load(new FileMapping(_T("output/test/flarmnet.bin")), 4));
+  ok1(image.IsEmpty());
+
+  /* an image with a full hash table must be rejected */
+  {
+    uint32_t data[4096];
+    file = fopen(path, "rb");
+    ok1(file != NULL);
+    const size_t n = fread(data, sizeof(data[0]), 4096, file);
+    fclose(file);
+    ok1(n > 8 && n < 4096);
+
+    const size_t table_size = size_t(1) << data[4];
+    uint32_t *table = data + data[6] / sizeof(data[0]);
+    for (size_t i = 0; i < table_size; ++i) {
+      if (table[i * 2] == 0) {
+        table[i * 2] = i + 1;
+        table[i * 2 + 1] = 0;
+      }
+    }
+
+    file = fopen(path, "wb");
+    fwrite(data, sizeof(data[0]), n, file);
+    fclose(file);
+
+    ok1(!image.Load(new FileMapping(_T("output/test/flarmnet.bin")), 0));
+    ok1(image.IsEmpty());
+
+    /* restore the valid image */
+    file = fopen(path, "wb");
+    ok1(db.Save(file));
+    fclose(file);
+  }
+
+  /* a truncated image must be rejected */
+  file = fopen(path, "r+b");
+  ok1(file != NULL);
+  char buffer[256];
+  ok1(fread(buffer, sizeof(buffer), 1, file) == 1);
+  fclose(file);
+
+  file = fopen(path, "wb");
+  fwrite(buffer, sizeof(buffer), 1, file);
+  fclose(file);
+
+  ok1(!image.Load(new FileMapping(_T("output/test/flarmnet.bin")), 0));
+  ok1(image.IsEmpty());
+}
+
+static void
+TestMany()
+{
+  FlarmNetDatabase db;
+  for (unsigned i = 0; i < 1000; ++i) {
+    FlarmNetRecord record;
+    record.id.UnsafeFormat(_T("%X"), 0xDD0000 + i * 7);
+    record.callsign.UnsafeFormat(_T("%u"), i % 100);
+    db.Insert(record);
+  }
+
+  /* duplicate id */
+  FlarmNetRecord record;
+  record.id = _T("DD0000");
+  record.callsign = _T("XX");
+  db.Insert(record);
+
+  db.Finish();
+  ok1(db.GetCount() == 1000);
+
+  bool found_all = true;
+  for (unsigned i = 0; i < 1000; ++i) {
+    TCHAR id[16];
+    _stprintf(id, _T("%X"), 0xDD0000 + i * 7);
+    const FlarmNetRecord *r = db.FindRecordById(FlarmId::Parse(id, NULL));
+    if (r == NULL || _tcscmp(r->id, id) != 0)
+      found_all = false;
+  }
+  ok1(found_all);
+
+  FlarmId ids[16];
+  ok1(db.FindIdsByCallSign(_T("42"), ids, 16) == 10);
+  ok1(db.FindIdsByCallSign(_T("XX"), ids, 16) == 0);
+
+  const FlarmNetRecord *array[128];
+  /* "1" and "10".."19" */
+  ok1(db.FindRecordsByCallSignPrefix(_T("1"), array, 128) == 110);
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(59);
 
   FlarmNetDatabase db;
   int count = FlarmNetReader::LoadFile(_T("test/data/flarmnet/data.fln"), db);
@@ -76,5 +212,12 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  ok1(db.FindRecordById(FlarmId::Parse("DDA85B", NULL)) == NULL);
+  ok1(db.FindFirstRecordByCallSign(_T("1A")) != NULL);
+
+  TestPrefix(db);
+  TestImage(db);
+  TestMany();
+
   return exit_status();
 }
@@ -0,0 +1,121 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/HeightMatrix.hpp"
+#include "Terrain/RasterBuffer.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Operation/Operation.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+#ifndef ENABLE_OPENGL
+
+static constexpr unsigned Q = 2;
+
+/**
+ * Compare HeightMatrix::Scroll() with a full Fill() at the new
+ * origin.
+ */
+static void
+TestScroll(const RasterMap &map, const WindowProjection &projection,
+           int dx, int dy)
+{
+  const RasterPoint origin(dx * int(Q), dy * int(Q));
+
+  HeightMatrix scrolled;
+  scrolled.Fill(map, projection, Q, true);
+  scrolled.Scroll(map, projection, origin, Q, dx, dy, true);
+
+  HeightMatrix full;
+  full.Fill(map, projection, Q, true);
+  full.Fill(map, projection, origin, Q,
+            0, 0, full.GetWidth(), full.GetHeight(), true);
+
+  unsigned n_invalid = 0, max_delta = 0;
+  for (const short *a = scrolled.GetData(), *b = full.GetData(),
+         *end = scrolled.GetDataEnd(); a != end; ++a, ++b) {
+    if (RasterBuffer::IsInvalid(*b))
+      continue;
+
+    if (RasterBuffer::IsInvalid(*a)) {
+      ++n_invalid;
+      continue;
+    }
+
+    const unsigned delta = abs(*a - *b);
+    if (delta > max_delta)
+      max_delta = delta;
+  }
+
+  ok(n_invalid == 0, "no invalid cells, dx=%d dy=%d", dx, dy);
+
+  /* the partial scans hit the same locations only up to rounding
+     errors */
+  ok(max_delta <= 2, "same heights, dx=%d dy=%d", dx, dy);
+}
+
+#endif
+
+static constexpr int deltas[][2] = {
+  { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+  { 1, 1 }, { -1, -1 }, { 2, 0 }, { -3, 2 },
+};
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(2 * ARRAY_SIZE(deltas));
+
+#ifdef ENABLE_OPENGL
+  skip(2 * ARRAY_SIZE(deltas), 0,
+       "HeightMatrix::Scroll() requires the software renderer");
+#else
+  NullOperationEnvironment operation;
+  RasterMap map(_T("test/data/benalla9.xcm/terrain.jp2"),
+                _T("test/data/benalla9.xcm/terrain.j2w"),
+                nullptr, nullptr, operation);
+  if (!map.IsDefined()) {
+    skip(2 * ARRAY_SIZE(deltas), 0, "Failed to load the terrain");
+    return exit_status();
+  }
+
+  do {
+    map.SetViewCenter(map.GetMapCenter(), fixed(50000));
+  } while (map.IsDirty());
+
+  WindowProjection projection;
+  projection.SetScreenSize({320, 240});
+  projection.SetScaleFromRadius(fixed(20000));
+  projection.SetGeoLocation(map.GetMapCenter());
+  projection.SetScreenOrigin(160, 120);
+  projection.UpdateScreenBounds();
+
+  for (const auto &d : deltas)
+    TestScroll(map, projection, d[0], d[1]);
+#endif
+
+  return exit_status();
+}
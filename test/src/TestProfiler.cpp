@@ -0,0 +1,180 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Profiler/Profiler.hpp"
+#include "TestUtil.hpp"
+
+#include <tchar.h>
+
+using namespace Profiler;
+
+static void
+TestNames()
+{
+  ok1(_tcscmp(GetName(Stage::DRAW), _T("draw")) == 0);
+  ok1(_tcscmp(GetName(Stage::CALCULATION), _T("calculation")) == 0);
+  ok1(_tcscmp(GetName(Channel::CALCULATION), _T("calculation")) == 0);
+
+  ok1(GetChannel(Stage::DRAW) == Channel::DRAW);
+  ok1(GetChannel(Stage::OVERLAYS) == Channel::DRAW);
+  ok1(GetChannel(Stage::CALCULATION) == Channel::CALCULATION);
+  ok1(GetChannel(Stage::CALCULATION_IDLE) == Channel::CALCULATION);
+  ok1(GetRootStage(Channel::DRAW) == Stage::DRAW);
+  ok1(GetRootStage(Channel::CALCULATION) == Stage::CALCULATION);
+}
+
+static void
+TestRecord()
+{
+  Sample samples[8];
+
+  /* nothing is recorded while disabled */
+  Record(Stage::TERRAIN, 100, 200);
+  ok1(Copy(Channel::DRAW, samples, 8) == 0);
+
+  Enable();
+  ok1(IsEnabled());
+
+  Record(Stage::TERRAIN, 1000, 1300);
+  Record(Stage::AIRSPACE, 1300, 1400);
+  Record(Stage::DRAW, 1000, 1500);
+  Record(Stage::CALCULATION_GPS, 2000, 2700);
+
+  ok1(Copy(Channel::DRAW, samples, 8) == 3);
+  ok1(samples[0].stage == Stage::TERRAIN);
+  ok1(samples[0].start == 1000);
+  ok1(samples[0].duration == 300);
+  ok1(samples[2].stage == Stage::DRAW);
+  ok1(samples[2].duration == 500);
+
+  /* only the most recent samples are copied */
+  ok1(Copy(Channel::DRAW, samples, 2) == 2);
+  ok1(samples[0].stage == Stage::AIRSPACE);
+  ok1(samples[1].stage == Stage::DRAW);
+
+  ok1(Copy(Channel::CALCULATION, samples, 8) == 1);
+  ok1(samples[0].stage == Stage::CALCULATION_GPS);
+  ok1(samples[0].duration == 700);
+
+  Disable();
+  ok1(!IsEnabled());
+  ok1(Copy(Channel::DRAW, samples, 8) == 0);
+}
+
+static void
+TestOverflow()
+{
+  Enable();
+
+  /* overflow the ring buffer; the oldest samples are dropped */
+  for (unsigned i = 0; i < 5000; ++i)
+    Record(Stage::TRAIL, i * 10, i * 10 + i % 7);
+
+  static Sample samples[8192];
+  const unsigned n = Copy(Channel::DRAW, samples, 8192);
+  ok1(n > 0 && n < 5000);
+  ok1(samples[n - 1].start == 4999 * 10);
+  ok1(samples[0].start == (5000 - n) * 10);
+
+  bool ordered = true;
+  for (unsigned i = 1; i < n; ++i)
+    if (samples[i].start != samples[i - 1].start + 10)
+      ordered = false;
+  ok1(ordered);
+
+  Disable();
+}
+
+static void
+TestSummarise()
+{
+  Enable();
+
+  for (unsigned frame = 0; frame < 4; ++frame) {
+    const uint64_t start = 10000 * (frame + 1);
+    Record(Stage::TERRAIN, start, start + 2000);
+    Record(Stage::MISC, start + 2000, start + 2100);
+    Record(Stage::MISC, start + 2100, start + 2200);
+    Record(Stage::DRAW, start, start + 3000);
+  }
+
+  Summary summary;
+  Summarise(Channel::DRAW, 0, summary);
+  ok1(summary.n_roots == 4);
+  ok1(summary.GetAverage(Stage::DRAW) == 3000);
+  ok1(summary.GetAverage(Stage::TERRAIN) == 2000);
+  ok1(summary.GetAverage(Stage::MISC) == 200);
+  ok1(summary.GetAverage(Stage::AIRSPACE) == 0);
+
+  /* only the last two frames */
+  Summarise(Channel::DRAW, 30000, summary);
+  ok1(summary.n_roots == 2);
+  ok1(summary.totals[unsigned(Stage::TERRAIN)] == 4000);
+
+  Summarise(Channel::CALCULATION, 0, summary);
+  ok1(summary.n_roots == 0);
+  ok1(summary.GetAverage(Stage::CALCULATION) == 0);
+
+  Disable();
+}
+
+static void
+TestScopeTimer()
+{
+  Sample samples[8];
+
+  {
+    const ScopeTimer timer(Stage::CALCULATION);
+  }
+  ok1(Copy(Channel::CALCULATION, samples, 8) == 0);
+
+  Enable();
+
+  {
+    const ScopeTimer timer(Stage::CALCULATION);
+    StageTimer stage_timer;
+    stage_timer.Mark(Stage::CALCULATION_READ);
+    stage_timer.Mark(Stage::CALCULATION_GPS);
+  }
+
+  ok1(Copy(Channel::CALCULATION, samples, 8) == 3);
+  ok1(samples[0].stage == Stage::CALCULATION_READ);
+  ok1(samples[1].stage == Stage::CALCULATION_GPS);
+  ok1(samples[2].stage == Stage::CALCULATION);
+  ok1(samples[1].start >= samples[0].start + samples[0].duration);
+
+  Disable();
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(44);
+
+  TestNames();
+  TestRecord();
+  TestOverflow();
+  TestSummarise();
+  TestScopeTimer();
+
+  return exit_status();
+}
@@ -0,0 +1,138 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Terrain/SlopeShading.hpp"
+#include "Util/Macros.hpp"
+
+extern "C" {
+#include "tap.h"
+}
+
+#include <string.h>
+#include <stdint.h>
+
+/**
+ * A simple deterministic pseudo random number generator.
+ */
+static uint32_t
+NextRandom(uint32_t &state)
+{
+  state = state * 1103515245u + 12345u;
+  return state >> 8;
+}
+
+static short
+RandomHeight(uint32_t &state)
+{
+  const uint32_t r = NextRandom(state);
+  switch (r % 16) {
+  case 0:
+    /* invalid */
+    return -32768;
+
+  case 1:
+    /* water */
+    return -31000;
+
+  case 2:
+    /* extreme values */
+    return (r & 0x100) ? 32767 : -29999;
+
+  default:
+    /* typical terrain: smooth, with occasional cliffs */
+    return (r >> 4) % ((r & 0x10) ? 9000 : 300);
+  }
+}
+
+static constexpr unsigned WIDTH = 301;
+static constexpr unsigned HEIGHT = 3;
+
+static short heights[WIDTH * HEIGHT];
+
+/**
+ * Compare SlopeShadingRow() (which may be SIMD) with
+ * SlopeShadingRowPortable().
+ */
+static bool
+CheckParity(unsigned column_distance, unsigned row_sum, unsigned dd2,
+            const SlopeShadingParameters &params)
+{
+  const short *src = heights + WIDTH + column_distance;
+  const unsigned n = WIDTH - 2 * column_distance;
+
+  signed char expected[WIDTH], actual[WIDTH];
+  memset(expected, 0x55, sizeof(expected));
+  memset(actual, 0x55, sizeof(actual));
+
+  SlopeShadingRowPortable(src, src - WIDTH, src + WIDTH,
+                          n, column_distance, row_sum, dd2, params,
+                          expected);
+  SlopeShadingRow(src, src - WIDTH, src + WIDTH,
+                  n, column_distance, row_sum, dd2, params,
+                  actual);
+
+  return memcmp(expected, actual, sizeof(expected)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+  static constexpr unsigned column_distances[] = { 1, 2, 3, 7, 25 };
+  static constexpr int contrasts[] = { 0, 64, 255 };
+  static constexpr SlopeShadingParameters lights[] = {
+    { 0, 0, 255, 0 },
+    { -180, 0, 180, 0 },
+    { 90, -160, 100, 0 },
+    { 0, 250, 44, 0 },
+    { -43, -43, 250, 0 },
+  };
+
+  plan_tests(ARRAY_SIZE(column_distances) * 2 * 2 * ARRAY_SIZE(contrasts) *
+             ARRAY_SIZE(lights));
+
+  uint32_t state = 42;
+
+  for (unsigned q : column_distances) {
+    /* the range of height_slope_factor allowed by RasterRenderer */
+    const unsigned max_height_slope_factor = 8192 / (q * q);
+
+    for (unsigned row_sum : { q, 2 * q }) {
+      for (unsigned height_slope_factor :
+             { max_height_slope_factor,
+               1 + NextRandom(state) % max_height_slope_factor }) {
+        const unsigned dd2 = 2 * q * row_sum * height_slope_factor;
+
+        for (int contrast : contrasts) {
+          for (SlopeShadingParameters params : lights) {
+            for (auto &h : heights)
+              h = RandomHeight(state);
+
+            params.contrast = contrast;
+            ok1(CheckParity(q, row_sum, dd2, params));
+          }
+        }
+      }
+    }
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,207 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Engine/Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Geo/SearchPointVector.hpp"
+#include "TestUtil.hpp"
+
+#include <stdlib.h>
+
+static constexpr unsigned N_STAGES = 5;
+
+static SearchPointVector boundaries[N_STAGES];
+
+static SearchPoint
+RandomPoint()
+{
+  return SearchPoint(GeoPoint(Angle::Degrees(fixed(7) + fixed(rand() % 1000) / 1000),
+                              Angle::Degrees(fixed(51) + fixed(rand() % 1000) / 1000)));
+}
+
+static void
+RandomBoundary(SearchPointVector &boundary)
+{
+  boundary.clear();
+
+  const unsigned n = 1 + rand() % 6;
+  for (unsigned i = 0; i < n; ++i)
+    boundary.push_back(RandomPoint());
+}
+
+static unsigned
+Distance(const SearchPoint &a, const SearchPoint &b)
+{
+  return (unsigned)a.GetLocation().Distance(b.GetLocation());
+}
+
+/**
+ * Find the best distance by trying all paths.
+ */
+static unsigned
+BruteForce(bool is_min, unsigned n_stages, unsigned stage,
+           const SearchPoint &previous)
+{
+  unsigned best = is_min ? -1 : 0;
+  for (const SearchPoint &sp : boundaries[stage]) {
+    unsigned distance = previous.IsValid() ? Distance(previous, sp) : 0;
+    if (stage + 1 < n_stages)
+      distance += BruteForce(is_min, n_stages, stage + 1, sp);
+
+    if (is_min ? distance < best : distance > best)
+      best = distance;
+  }
+
+  return best;
+}
+
+static unsigned
+SolutionDistance(const TaskDijkstra &dijkstra, unsigned n_stages,
+                 const SearchPoint &location)
+{
+  unsigned distance = location.IsValid()
+    ? Distance(location, dijkstra.GetSolution(0))
+    : 0;
+
+  for (unsigned i = 1; i < n_stages; ++i)
+    distance += Distance(dijkstra.GetSolution(i - 1),
+                         dijkstra.GetSolution(i));
+
+  return distance;
+}
+
+static void
+SetBoundaries(TaskDijkstra &dijkstra, unsigned n_stages)
+{
+  dijkstra.SetTaskSize(n_stages);
+  for (unsigned i = 0; i < n_stages; ++i)
+    dijkstra.SetBoundary(i, boundaries[N_STAGES - n_stages + i]);
+}
+
+static bool
+CheckMin(TaskDijkstraMin &dijkstra, unsigned n_stages,
+         const SearchPoint &location)
+{
+  SetBoundaries(dijkstra, n_stages);
+  if (!dijkstra.DistanceMin(location))
+    return false;
+
+  const unsigned expected =
+    BruteForce(true, N_STAGES, N_STAGES - n_stages, location);
+  return SolutionDistance(dijkstra, n_stages, location) == expected;
+}
+
+static bool
+CheckMax(TaskDijkstraMax &dijkstra)
+{
+  SetBoundaries(dijkstra, N_STAGES);
+  if (!dijkstra.DistanceMax())
+    return false;
+
+  const unsigned expected =
+    BruteForce(false, N_STAGES, 0, SearchPoint::Invalid());
+  return SolutionDistance(dijkstra, N_STAGES, SearchPoint::Invalid()) ==
+    expected;
+}
+
+static void
+TestRandom()
+{
+  TaskDijkstraMin dijkstra_min;
+  TaskDijkstraMax dijkstra_max;
+
+  for (auto &boundary : boundaries)
+    RandomBoundary(boundary);
+
+  SearchPoint location = RandomPoint();
+  ok1(CheckMin(dijkstra_min, N_STAGES, location));
+  ok1(CheckMax(dijkstra_max));
+
+  /* the aircraft moves; only the first leg changes */
+  location = RandomPoint();
+  ok1(CheckMin(dijkstra_min, N_STAGES, location));
+
+  /* no location: the task starts at the first task point */
+  ok1(CheckMin(dijkstra_min, N_STAGES, SearchPoint::Invalid()));
+
+  /* modify a boundary in the middle; the cached sub-paths behind it
+     are reused */
+  boundaries[2].back() = RandomPoint();
+  ok1(CheckMin(dijkstra_min, N_STAGES, location));
+  ok1(CheckMax(dijkstra_max));
+
+  /* modify the finish */
+  RandomBoundary(boundaries[N_STAGES - 1]);
+  ok1(CheckMin(dijkstra_min, N_STAGES, location));
+  ok1(CheckMax(dijkstra_max));
+
+  /* modify the first task point */
+  RandomBoundary(boundaries[0]);
+  ok1(CheckMin(dijkstra_min, N_STAGES, location));
+  ok1(CheckMax(dijkstra_max));
+
+  /* advance to the next task point, which shifts all stages */
+  ok1(CheckMin(dijkstra_min, N_STAGES - 1, location));
+  ok1(CheckMin(dijkstra_min, N_STAGES - 2, location));
+
+  /* a fresh object must get the same result as the warm one */
+  TaskDijkstraMin fresh;
+  ok1(CheckMin(fresh, N_STAGES - 2, location));
+  ok1(SolutionDistance(fresh, N_STAGES - 2, location) ==
+      SolutionDistance(dijkstra_min, N_STAGES - 2, location));
+}
+
+static void
+TestEmpty()
+{
+  TaskDijkstraMin dijkstra;
+
+  for (auto &boundary : boundaries)
+    RandomBoundary(boundary);
+
+  SearchPoint location = RandomPoint();
+  ok1(CheckMin(dijkstra, N_STAGES, location));
+
+  boundaries[3].clear();
+  SetBoundaries(dijkstra, N_STAGES);
+  ok1(!dijkstra.DistanceMin(location));
+
+  RandomBoundary(boundaries[3]);
+  ok1(CheckMin(dijkstra, N_STAGES, location));
+}
+
+int main(int argc, char **argv)
+{
+  static constexpr unsigned N_RANDOM = 20;
+
+  plan_tests(N_RANDOM * 14 + 3);
+
+  srand(42);
+
+  for (unsigned i = 0; i < N_RANDOM; ++i)
+    TestRandom();
+
+  TestEmpty();
+
+  return exit_status();
+}
@@ -0,0 +1,182 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Engine/Trace/Snapshot.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Trace/Vector.hpp"
+#include "TestUtil.hpp"
+
+static bool
+Equals(const TracePoint &a, const TracePoint &b)
+{
+  return a.GetTime() == b.GetTime() &&
+    a.GetFlatLocation() == b.GetFlatLocation();
+}
+
+static bool
+Equals(const TracePointVector &a, const TracePointVector &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (!Equals(a[i], b[i]))
+      return false;
+
+  return true;
+}
+
+static bool
+Equals(const TraceSnapshot &snapshot, const Trace &trace)
+{
+  TracePointVector a, b;
+  snapshot.CopyTo(a);
+  trace.GetPoints(b);
+  return Equals(a, b);
+}
+
+static TracePoint
+MakePoint(unsigned i)
+{
+  const GeoPoint location(Angle::Degrees(fixed(7) + fixed(i % 17) / 1000),
+                          Angle::Degrees(fixed(51) + fixed(i) / 2000));
+  return TracePoint(location, 100 + i * 2, fixed(1000), fixed(0), 0);
+}
+
+static void
+TestAppend()
+{
+  Trace trace(0, Trace::null_time, 256);
+  TraceSnapshotBuilder builder;
+
+  builder.Sync(trace);
+  ok1(builder.Get().empty());
+
+  bool equal = true, same_epoch = true, incremental = true;
+  unsigned epoch = 0;
+  TracePointVector loaded;
+
+  for (unsigned i = 0; i < 200; ++i) {
+    trace.push_back(MakePoint(i));
+    builder.Sync(trace);
+
+    const TraceSnapshot snapshot = builder.Get();
+    if (snapshot.size() != trace.size() || !Equals(snapshot, trace))
+      equal = false;
+
+    if (i == 0)
+      epoch = snapshot.GetEpoch();
+    else if (snapshot.GetEpoch() != epoch)
+      same_epoch = false;
+
+    /* load only the new points, like TrailRenderer does */
+    snapshot.CopyTo(loaded, loaded.size());
+    TracePointVector full;
+    trace.GetPoints(full);
+    if (!Equals(loaded, full))
+      incremental = false;
+  }
+
+  ok1(equal);
+  ok1(same_epoch);
+  ok1(incremental);
+}
+
+static void
+TestModify()
+{
+  Trace trace(0, Trace::null_time, 128);
+  TraceSnapshotBuilder builder;
+
+  for (unsigned i = 0; i < 100; ++i)
+    trace.push_back(MakePoint(i));
+
+  builder.Sync(trace);
+  const TraceSnapshot old_snapshot = builder.Get();
+  TracePointVector old_points;
+  trace.GetPoints(old_points);
+
+  /* fill the trace until it gets thinned */
+  const Serial modify_serial = trace.GetModifySerial();
+  unsigned i = 100;
+  while (trace.GetModifySerial() == modify_serial) {
+    trace.push_back(MakePoint(i++));
+    builder.Sync(trace);
+  }
+
+  const TraceSnapshot snapshot = builder.Get();
+  ok1(Equals(snapshot, trace));
+  ok1(snapshot.GetEpoch() != old_snapshot.GetEpoch());
+
+  /* the old snapshot must not have been modified */
+  TracePointVector v;
+  old_snapshot.CopyTo(v);
+  ok1(Equals(v, old_points));
+
+  trace.clear();
+  builder.Sync(trace);
+  ok1(builder.Get().empty());
+  ok1(!Equals(snapshot, trace));
+  ok1(snapshot.size() > 0);
+}
+
+static void
+TestFilter()
+{
+  Trace trace(0, Trace::null_time, 512);
+  TraceSnapshotBuilder builder;
+
+  for (unsigned i = 0; i < 300; ++i)
+    trace.push_back(MakePoint(i));
+
+  builder.Sync(trace);
+  const TraceSnapshot snapshot = builder.Get();
+
+  const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+  static constexpr unsigned min_times[] = { 0, 250, 600 };
+  static constexpr int resolutions[] = { 1, 50, 500 };
+  for (unsigned min_time : min_times) {
+    for (int resolution : resolutions) {
+      TracePointVector a, b;
+      snapshot.CopyTo(a, min_time, location, fixed(resolution));
+      trace.GetPoints(b, min_time, location, fixed(resolution));
+      ok1(!a.empty() && Equals(a, b));
+    }
+  }
+
+  TracePointVector v;
+  snapshot.CopyTo(v, 100000, location, fixed(10));
+  ok1(v.empty());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(20);
+
+  TestAppend();
+  TestModify();
+  TestFilter();
+
+  return exit_status();
+}
@@ -0,0 +1,102 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "FLARM/TrafficColumns.hpp"
+#include "Math/FastRotation.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned value)
+{
+  char buffer[16];
+  sprintf(buffer, "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static void
+Add(TrafficList &list, unsigned id, double north, double east,
+    FlarmTraffic::AlarmType alarm_level)
+{
+  FlarmTraffic &traffic = *list.AllocateTraffic();
+  traffic.Clear();
+  traffic.valid.Update(fixed(1));
+  traffic.id = MakeId(id);
+  traffic.relative_north = fixed(north);
+  traffic.relative_east = fixed(east);
+  traffic.distance = SmallHypot(traffic.relative_north,
+                                traffic.relative_east);
+  traffic.alarm_level = alarm_level;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(15);
+
+  TrafficList list;
+  list.Clear();
+  Add(list, 0x100, 1000, 0, FlarmTraffic::AlarmType::NONE);
+  Add(list, 0x101, 0, -500, FlarmTraffic::AlarmType::LOW);
+  Add(list, 0x102, -300, 400, FlarmTraffic::AlarmType::URGENT);
+  Add(list, 0x103, 3000, 4000, FlarmTraffic::AlarmType::NONE);
+  Add(list, 0x104, 100, 0, FlarmTraffic::AlarmType::URGENT);
+  Add(list, 0x105, 0, 0, FlarmTraffic::AlarmType::LOW);
+
+  TrafficColumns columns;
+  columns.Load(list);
+  ok1(columns.size == 6);
+
+  ok1(columns.Find(MakeId(0x100)) == 0);
+  ok1(columns.Find(MakeId(0x104)) == 4);
+  ok1(columns.Find(MakeId(0x200)) == -1);
+
+  /* alarms by increasing threat; the last one is the maximum
+     alert */
+  uint8_t order[TrafficColumns::MAX_COUNT];
+  ok1(columns.GetAlarmOrder(order) == 4);
+  ok1(order[0] == 1 && order[1] == 5 && order[2] == 2 && order[3] == 4);
+  ok1(list.FindMaximumAlert() == &list.list[order[3]]);
+
+  /* north up; range 2000 m, radius 100 pixels */
+  int x[TrafficColumns::MAX_COUNT], y[TrafficColumns::MAX_COUNT];
+  columns.Project(fixed(2000), 100, nullptr, x, y);
+  ok1(x[0] == 0 && y[0] == -50);
+  ok1(x[1] == -25 && y[1] == 0);
+  ok1(x[2] == 20 && y[2] == 15);
+  /* beyond the range: on the edge */
+  ok1(x[3] == 80 && y[3] == -60);
+  ok1(x[5] == 0 && y[5] == 0);
+
+  /* heading east: north is on the left */
+  const FastRotation rotation(Angle::Degrees(-90));
+  columns.Project(fixed(2000), 100, &rotation, x, y);
+  ok1(x[0] == -50 && y[0] == 0);
+  ok1(x[3] == -60 && y[3] == -80);
+
+  list.Clear();
+  columns.Load(list);
+  ok1(columns.size == 0);
+
+  return exit_status();
+}
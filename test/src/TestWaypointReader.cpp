@@ -22,6 +22,9 @@
 
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/WaypointReaderSeeYou.hpp"
+#include "IO/MemoryLineReader.hpp"
+#include "IO/ConvertLineReader.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/System.hpp"
@@ -30,6 +33,9 @@
 #include "Operation/Operation.hpp"
 
 #include <vector>
+#include <string>
+
+#include <stdio.h>
 
 static void
 TestExtractParameters()
@@ -525,11 +531,80 @@ CreateOriginalWaypoints()
   return org_wp;
 }
 
+/**
+ * Returns the waypoints ordered by id.
+ */
+static std::vector<const Waypoint *>
+SortById(const Waypoints &way_points)
+{
+  std::vector<const Waypoint *> result(way_points.size(), nullptr);
+  for (const auto &wp : way_points)
+    if (wp.id >= 1 && wp.id <= result.size())
+      result[wp.id - 1] = &wp;
+
+  return result;
+}
+
+/**
+ * Parse a large generated SeeYou file in chunks, and compare the
+ * result with the sequential parser.
+ */
+static void
+TestParseBuffer()
+{
+  std::string data("name,code,country,lat,lon,elev,style,"
+                   "rwdir,rwlen,freq,desc\r\n");
+
+  for (unsigned i = 0; i < 20000; ++i) {
+    /* valid UTF-8 at first, then an ISO-Latin-1 line which switches
+       the character set for all following lines */
+    const char *comment = i == 100 || i == 16000
+      ? "M\xc3\xbcnchen"
+      : (i == 15000 ? "Caf\xe9" : "comment");
+
+    char line[256];
+    sprintf(line, "\"WP%05u\",,,%02u%02u.%03uN,%03u%02u.%03uE,%um,1,,,,"
+            "\"%s\"\r\n",
+            i, i % 90, i % 60, i % 1000, i % 180, (i / 7) % 60,
+            (i * 7) % 1000, i % 3000, comment);
+    data += line;
+  }
+
+  data += "-----Related Tasks-----\r\n";
+  data += "\"Ignored\",,,1000.000N,01000.000E,0m,1,,,,\r\n";
+
+  NullOperationEnvironment operation;
+
+  Waypoints expected;
+  WaypointReaderSeeYou sequential(0);
+  MemoryLineReaderA lines(data.data(), data.data() + data.size());
+  ConvertLineReader convert(lines, ConvertLineReader::AUTO);
+  sequential.Parse(expected, convert, operation);
+
+  Waypoints actual;
+  WaypointReaderSeeYou parallel(0);
+  parallel.ParseBuffer(actual, data.data(), data.size(), operation, 4);
+
+  ok1(expected.size() == 20000);
+  ok1(actual.size() == expected.size());
+
+  const auto a = SortById(actual), e = SortById(expected);
+  bool equal = a.size() == e.size();
+  for (unsigned i = 0; equal && i < a.size(); ++i)
+    equal = a[i] != nullptr && e[i] != nullptr &&
+      a[i]->name == e[i]->name && a[i]->comment == e[i]->comment &&
+      a[i]->location == e[i]->location &&
+      a[i]->elevation == e[i]->elevation;
+  ok1(equal);
+
+  ok1(actual.LookupName(_T("Ignored")) == nullptr);
+}
+
 int main(int argc, char **argv)
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(315);
+  plan_tests(319);
 
   TestExtractParameters();
 
@@ -542,5 +617,7 @@ int main(int argc, char **argv)
   TestCompeGPS(org_wp);
   TestCompeGPS_UTM(org_wp);
 
+  TestParseBuffer();
+
   return exit_status();
 }
@@ -28,8 +28,10 @@
 #include "GlideSolvers/MacCready.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/Clock.hpp"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <fstream>
 #include <string>
 #include <math.h>
@@ -266,9 +268,107 @@ test_cb()
   return true;
 }
 
+static constexpr unsigned N_BATCH = 1000;
+
+static GeoVector batch_vectors[N_BATCH];
+static fixed batch_min_arrival_altitudes[N_BATCH];
+static GlideResult batch_results[N_BATCH];
+static const fixed batch_altitude(1500);
+
+static void
+init_batch()
+{
+  for (unsigned i = 0; i < N_BATCH; ++i) {
+    /* include some zero-length vectors, which need a vertical
+       solution */
+    const fixed distance = i % 100 == 0
+      ? fixed(0)
+      : fixed(rand() % 100000);
+    batch_vectors[i] = GeoVector(distance,
+                                 Angle::Degrees(fixed(rand() % 360)));
+    batch_min_arrival_altitudes[i] = fixed(rand() % 1000);
+  }
+}
+
+static bool
+equals(const GlideResult &a, const GlideResult &b)
+{
+  if (a.validity != b.validity ||
+      a.vector.distance != b.vector.distance)
+    return false;
+
+  if (!a.IsOk())
+    return true;
+
+  return a.v_opt == b.v_opt &&
+    a.head_wind == b.head_wind &&
+    a.altitude_difference == b.altitude_difference &&
+    a.pure_glide_altitude_difference == b.pure_glide_altitude_difference &&
+    a.height_glide == b.height_glide &&
+    a.height_climb == b.height_climb &&
+    a.time_elapsed == b.time_elapsed &&
+    a.time_virtual == b.time_virtual;
+}
+
+static bool
+test_batch(const fixed mc, const SpeedVector wind)
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(mc);
+  const MacCready mac(settings, polar);
+
+  mac.SolveStraight(N_BATCH, batch_vectors, batch_min_arrival_altitudes,
+                    batch_altitude, wind, batch_results);
+
+  for (unsigned i = 0; i < N_BATCH; ++i) {
+    const GlideState gs(batch_vectors[i], batch_min_arrival_altitudes[i],
+                        batch_altitude, wind);
+    if (!equals(batch_results[i], mac.SolveStraight(gs)))
+      return false;
+  }
+
+  return true;
+}
+
+static void
+benchmark_batch(const SpeedVector wind)
+{
+  static constexpr unsigned N_RUNS = 100;
+
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(fixed(1));
+  const MacCready mac(settings, polar);
+
+  const uint64_t start = MonotonicClockUS();
+
+  for (unsigned run = 0; run < N_RUNS; ++run) {
+    for (unsigned i = 0; i < N_BATCH; ++i) {
+      const GlideState gs(batch_vectors[i], batch_min_arrival_altitudes[i],
+                          batch_altitude, wind);
+      batch_results[i] = mac.SolveStraight(gs);
+    }
+  }
+
+  const uint64_t single = MonotonicClockUS();
+
+  for (unsigned run = 0; run < N_RUNS; ++run)
+    mac.SolveStraight(N_BATCH, batch_vectors, batch_min_arrival_altitudes,
+                      batch_altitude, wind, batch_results);
+
+  const uint64_t batch = MonotonicClockUS();
+
+  diag("%u destinations, wind %.0f m/s: single %.1f us, batch %.1f us",
+       N_BATCH, (double)wind.norm,
+       double(single - start) / N_RUNS, double(batch - single) / N_RUNS);
+}
+
 int main() {
 
-  plan_tests(3);
+  plan_tests(7);
 
   Directory::Create(_T("output/results"));
 
@@ -276,6 +376,18 @@ int main() {
   ok(test_stf(),"mc stf",0);
   ok(test_cb(),"cruise bearing",0);
 
+  init_batch();
+
+  const SpeedVector wind(Angle::Degrees(fixed(270)), fixed(10));
+  const SpeedVector storm(Angle::Degrees(fixed(90)), fixed(60));
+  ok(test_batch(fixed(1), SpeedVector::Zero()), "batch, no wind", 0);
+  ok(test_batch(fixed(1), wind), "batch, wind", 0);
+  ok(test_batch(fixed(1), storm), "batch, excessive wind", 0);
+  ok(test_batch(fixed(0), wind), "batch, MC=0", 0);
+
+  benchmark_batch(SpeedVector::Zero());
+  benchmark_batch(wind);
+
   return exit_status();
 
 }